@@ -87,7 +87,10 @@ pthread_create (pthread_t * tid,
  * RESULTS
  *              0               successfully created thread,
  *              EINVAL          attr invalid,
- *              EAGAIN          insufficient resources.
+ *              EAGAIN          insufficient resources,
+ *              ENOTSUP         attr requests a scheduling policy,
+ *                              CPU affinity or caller supplied
+ *                              stack the OS cannot apply.
  *
  * ------------------------------------------------------
  */
@@ -99,7 +102,10 @@ pthread_create (pthread_t * tid,
   int run = PTE_TRUE;
   ThreadParms *parms = NULL;
   long stackSize;
+  void *stackAddr = NULL;
   int priority = 0;
+  int policy = SCHED_OTHER;
+  unsigned int cpumask = 0;
   pthread_t self;
   pte_osResult osResult;
 
@@ -132,7 +138,7 @@ pthread_create (pthread_t * tid,
 
   priority = tp->sched_priority;
 
-  if ((parms = (ThreadParms *) malloc (sizeof (*parms))) == NULL)
+  if ((parms = (ThreadParms *) pte_alloc (PTE_ALLOC_THREADPARMS, sizeof (*parms))) == NULL)
     {
       goto FAIL0;
     }
@@ -144,8 +150,11 @@ pthread_create (pthread_t * tid,
   if (a != NULL)
     {
       stackSize = a->stacksize;
+      stackAddr = a->stackaddr;
       tp->detachState = a->detachstate;
       priority = a->param.sched_priority;
+      policy = a->schedpolicy;
+      cpumask = a->cpuaffinity;
 
       if ( (priority > pte_osThreadGetMaxPriority()) ||
            (priority < pte_osThreadGetMinPriority()) )
@@ -170,6 +179,7 @@ pthread_create (pthread_t * tid,
            */
           self = pthread_self ();
           priority = ((pte_thread_t *) self)->sched_priority;
+          policy = ((pte_thread_t *) self)->sched_policy;
         }
 
 
@@ -187,6 +197,21 @@ pthread_create (pthread_t * tid,
 
   tp->keys = NULL;
 
+  /*
+   * A joinable thread posts exitSem as it finishes, so joins wait on
+   * that rather than on the OS thread.
+   */
+  if (PTHREAD_CREATE_JOINABLE == tp->detachState)
+    {
+      if (pte_osSemaphoreCreate (0, &tp->exitSem) != PTE_OS_OK)
+        {
+          result = EAGAIN;
+          goto FAIL0;
+        }
+
+      tp->exitSemValid = 1;
+    }
+
   /*
    * Threads must be started in suspended mode and resumed if necessary
    * after _beginthreadex returns us the handle. Otherwise we set up a
@@ -204,28 +229,120 @@ pthread_create (pthread_t * tid,
        * not as finally adjusted.
        */
       tp->sched_priority = priority;
+      tp->sched_policy = policy;
+      tp->prioEffective = priority;
+      tp->cpuAffinity = cpumask;
 
       (void) pthread_mutex_unlock (&tp->threadLock);
     }
 
-  osResult = pte_osThreadCreate(pte_threadStart,
-                                stackSize,
-                                priority,
-                                parms,
-                                &(tp->threadId));
+  /*
+   * Without a caller supplied stack, take one from the stack pool
+   * if it is enabled. The pooled stack is released by
+   * pte_threadDestroy(), including on failure below.
+   */
+  if (stackAddr == NULL)
+    {
+      tp->poolStackSize = (unsigned int) stackSize;
+      tp->poolStack = pte_stack_pool_get (&tp->poolStackSize);
+    }
 
-  if (osResult == PTE_OS_OK)
+  if (stackAddr != NULL)
+    {
+      osResult = pte_osThreadCreateWithStack(pte_threadStart,
+                                             stackAddr,
+                                             stackSize,
+                                             priority,
+                                             parms,
+                                             &(tp->threadId));
+    }
+  else if (tp->poolStack != NULL)
     {
-      pte_osThreadStart(tp->threadId);
-      result = 0;
+      osResult = pte_osThreadCreateWithStack(pte_threadStart,
+                                             tp->poolStack,
+                                             tp->poolStackSize,
+                                             priority,
+                                             parms,
+                                             &(tp->threadId));
+
+      if (osResult == PTE_OS_GENERAL_FAILURE)
+        {
+          /* The OS allocates its own stacks; don't use the pool. */
+          pte_stack_pool_put (tp->poolStack, tp->poolStackSize);
+          tp->poolStack = NULL;
+
+          osResult = pte_osThreadCreate(pte_threadStart,
+                                        stackSize,
+                                        priority,
+                                        parms,
+                                        &(tp->threadId));
+        }
     }
   else
+    {
+      osResult = pte_osThreadCreate(pte_threadStart,
+                                    stackSize,
+                                    priority,
+                                    parms,
+                                    &(tp->threadId));
+    }
+
+  if (osResult != PTE_OS_OK)
     {
       tp->threadId = 0;
-      result = EAGAIN;
+
+      if (stackAddr != NULL && osResult == PTE_OS_GENERAL_FAILURE)
+        {
+          result = ENOTSUP;
+        }
+      else if (stackAddr != NULL && osResult == PTE_OS_INVALID_PARAM)
+        {
+          result = EINVAL;
+        }
+      else
+        {
+          result = EAGAIN;
+        }
+
       goto FAIL0;
     }
 
+  /*
+   * Apply the policy and pin the thread while it is still suspended
+   * so that it never runs under the wrong policy or outside the
+   * requested processor set.
+   */
+  if (policy != SCHED_OTHER)
+    {
+      osResult = pte_osThreadSetSchedPolicy(tp->threadId, policy);
+
+      if (osResult != PTE_OS_OK)
+        {
+          pte_osThreadDelete(tp->threadId);
+          tp->threadId = 0;
+          result = (osResult == PTE_OS_GENERAL_FAILURE) ? ENOTSUP : EINVAL;
+          goto FAIL0;
+        }
+    }
+
+  if (cpumask != 0)
+    {
+      osResult = pte_osThreadSetAffinity(tp->threadId, cpumask);
+
+      if (osResult != PTE_OS_OK)
+        {
+          pte_osThreadDelete(tp->threadId);
+          tp->threadId = 0;
+          result = (osResult == PTE_OS_GENERAL_FAILURE) ? ENOTSUP : EINVAL;
+          goto FAIL0;
+        }
+    }
+
+  PTE_TRACE (PTE_TRACE_CREATE, tp);
+
+  pte_osThreadStart(tp->threadId);
+  result = 0;
+
   /*
    * Fall Through Intentionally
    */
@@ -245,7 +362,7 @@ FAIL0:
 
       if (parms != NULL)
         {
-          free (parms);
+          pte_free (PTE_ALLOC_THREADPARMS, parms, sizeof (*parms));
         }
     }
   else
@@ -66,33 +66,74 @@ unsigned char pte_smp_system = PTE_TRUE;  /* Safer if assumed true initially. */
 pte_osMutexHandle pte_thread_reuse_lock;
 
 /*
- * Global lock for testing internal state of statically declared mutexes.
+ * Global lock for condition variable linked list. The list exists
+ * to wake up CVs when a WM_TIMECHANGE message arrives. See
+ * w32_TimeChangeHandler.c.
  */
-pte_osMutexHandle pte_mutex_test_init_lock;
+pte_osMutexHandle pte_cond_list_lock;
 
 /*
- * Global lock for testing internal state of PTHREAD_COND_INITIALIZER
- * created condition variables.
+ * Global lock for priority inheritance and priority ceiling
+ * bookkeeping: mutex owners, boosts and per-thread held lists.
  */
-pte_osMutexHandle pte_cond_test_init_lock;
+pte_osMutexHandle pte_mutex_prio_lock;
 
 /*
- * Global lock for testing internal state of PTHREAD_RWLOCK_INITIALIZER
- * created read/write locks.
+ * Global lock for the thread stack pool, and the pool's settings
+ * (see pthread_setstackpool_np). A maximum of zero disables the pool.
  */
-pte_osMutexHandle pte_rwlock_test_init_lock;
+pte_osMutexHandle pte_stack_pool_lock;
+int pte_stack_pool_max = 0;
+unsigned int pte_stack_pool_guard = 0;
 
 /*
- * Global lock for testing internal state of PTHREAD_SPINLOCK_INITIALIZER
- * created spin locks.
+ * Global lock for starting and stopping the work-stealing task
+ * scheduler, and for its injection list of tasks spawned by threads
+ * that are not workers (see pte_task_spawn_np).
  */
-pte_osMutexHandle pte_spinlock_test_init_lock;
+pte_osMutexHandle pte_task_lock;
+pte_task_sched_t pte_task_sched;
 
 /*
- * Global lock for condition variable linked list. The list exists
- * to wake up CVs when a WM_TIMECHANGE message arrives. See
- * w32_TimeChangeHandler.c.
+ * Installed allocator (see pte_set_allocator_np), or NULL for the C
+ * library heap, and the counters kept for each allocation type.
  */
-pte_osMutexHandle pte_cond_list_lock;
+const pte_allocator_t * pte_allocator = NULL;
+pte_alloc_counters_t pte_alloc_counters[PTE_ALLOC_TYPES];
+
+/*
+ * Installed trace hooks (see pte_set_trace_hooks_np), or NULL. The
+ * trace lock guards the list of per-thread event rings kept by the
+ * built-in recorder (see pte_trace.c) and the ring size it uses.
+ */
+const pte_trace_hooks_t * pte_trace_hooks = NULL;
+pte_osMutexHandle pte_trace_lock;
+pte_trace_ring_t * pte_trace_rings = NULL;
+int pte_trace_ring_size = 0;
+int pte_trace_next_tid = 0;
+
+#ifdef PTE_MUTEX_STATS
+/*
+ * Global lock for the list of all initialised mutexes, which
+ * pte_mutex_stats_top_np() walks. Statistics are only gathered
+ * while pte_mutex_stats_enabled is set.
+ */
+pte_osMutexHandle pte_mutex_stats_lock;
+pthread_mutex_t pte_mutex_stats_list = NULL;
+int pte_mutex_stats_enabled = 0;
+#endif
+
+#ifdef PTE_SYNC_REGISTRY
+/*
+ * Sync object registry (see pte_sync_registry.c). Entries are claimed
+ * and released with atomic operations only; pte_sync_registry_next
+ * is where the next search for a free entry starts. The reporter lock
+ * serialises starting and stopping the pte_sync_reporter_np() thread.
+ */
+pte_sync_entry_t pte_sync_registry[PTE_SYNC_REGISTRY_SIZE];
+int pte_sync_registry_next = 0;
+int pte_sync_registry_dropped = 0;
+pte_osMutexHandle pte_sync_reporter_lock;
+#endif
 
 
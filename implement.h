@@ -57,6 +57,8 @@
 #include <semaphore.h>
 #include <sys/sched.h>
 
+#include "pthread_np.h"
+
 
 typedef enum
 {
@@ -94,9 +96,26 @@ struct pte_thread_t_
     int detachState;
     pthread_mutex_t threadLock;	/* Used for serialised access to public thread state */
     int sched_priority;		/* As set, not as currently is */
+    int sched_policy;		/* As set */
+    int prioEffective;		/* As currently is, including mutex boosts */
+    pthread_mutex_t prioMutexes;	/* PI/PP mutexes owned by this thread */
+    pthread_mutex_t prioBlockedOn;	/* PI mutex this thread is waiting for */
+    pte_thread_t * prioWaitNext;	/* Next thread waiting on prioBlockedOn */
+    unsigned int cpuAffinity;	/* As set, 0 if never pinned */
+    void *poolStack;		/* Stack taken from the stack pool, or NULL */
+    unsigned int poolStackSize;
+    void *taskWorker;		/* Work-stealing worker state, or NULL */
+    void *cleanupMark;		/* Cleanup handler pte_throw() unwinds to */
+    int parkSemValid;
+    pte_osSemaphoreHandle parkSem;	/* Created on first pte_task_sync_np() park */
+    int exitSemValid;
+    pte_osSemaphoreHandle exitSem;	/* Posted as a joinable thread finishes */
+    void *joinAnyWaiter;		/* pthread_join_any_np() caller, or NULL */
+    void *traceRing;		/* Trace recorder events, or NULL */
     pthread_mutex_t cancelLock;	/* Used for async-cancel safety */
     int cancelState;
     int cancelType;
+    int cancelPending;		/* See PTE_CANCEL_PUBLISH */
     int cancelEvent;
 #ifdef PTE_CLEANUP_C
     jmp_buf start_mark;
@@ -122,6 +141,8 @@ struct pthread_attr_t_
     struct sched_param param;
     int inheritsched;
     int contentionscope;
+    unsigned int cpuaffinity;
+    int schedpolicy;
   };
 
 
@@ -133,11 +154,127 @@ struct pthread_attr_t_
  * ====================
  */
 
+/*
+ * Allocation counters - see pte_alloc.c
+ */
+typedef struct
+  {
+    int objects;
+    int bytes;
+    int allocs;
+    int failures;
+  } pte_alloc_counters_t;
+
+/*
+ * Slab caches - see pte_slab.c
+ *
+ * Mutex, condition variable, semaphore, read-write lock, barrier and
+ * spinlock structs are carved from per-type chunks in cache line
+ * sized slots. Each thread keeps a small magazine of free slots per
+ * type; the shared free list is only locked to refill or drain it.
+ */
+#define PTE_SLAB_ALIGN          64	/* Slot alignment, a power of 2 */
+#define PTE_SLAB_CHUNK          4096	/* Bytes of slots per chunk */
+#define PTE_SLAB_MAGAZINE       16	/* Free slots a thread keeps per type */
+#define PTE_SLAB_CLASSES        6
+
+/*
+ * Trace recorder - see pte_trace.c
+ *
+ * Each thread that records an event gets a ring of the most recent
+ * events, written only by that thread. Rings are linked on a global
+ * list so pte_trace_dump_np() can find them, and are kept until the
+ * library is terminated.
+ */
+typedef struct
+  {
+    unsigned long long time;	/* pte_osClockGetMicros() */
+    const void *object;
+    int event;			/* PTE_TRACE_* */
+  } pte_trace_record_t;
+
+typedef struct pte_trace_ring_t_ pte_trace_ring_t;
+
+struct pte_trace_ring_t_
+  {
+    pte_trace_ring_t * next;
+    int tid;			/* Sequence number in order of creation */
+    int head;			/* Events written so far */
+    int size;
+    pte_trace_record_t * records;
+  };
+
+#ifdef PTE_SYNC_REGISTRY
+/*
+ * Sync object registry - see pte_sync_registry.c
+ *
+ * Every mutex, rwlock, condition variable, semaphore, spin lock and
+ * barrier claims an entry in a fixed table when it is created. The
+ * entry records how often, and for how long, threads blocked on the
+ * object, as a histogram of wait times in power-of-two microsecond
+ * buckets. Objects the library creates as parts of another object
+ * (e.g. the semaphores inside a condition variable) are marked
+ * internal and report their waits to their owner's entry.
+ */
+#ifndef PTE_SYNC_REGISTRY_SIZE
+#define PTE_SYNC_REGISTRY_SIZE 256
+#endif
+
+#define PTE_SYNC_HIST_BUCKETS 20	/* Last bucket: 2^19 usecs and up */
+
+/* Entry states */
+#define PTE_SYNC_FREE     0
+#define PTE_SYNC_CLAIMED  1	/* Being filled in by its creator */
+#define PTE_SYNC_LIVE     2
+#define PTE_SYNC_INTERNAL 3	/* Part of the object 'owner' */
+
+/* Object types */
+#define PTE_SYNC_MUTEX    0
+#define PTE_SYNC_RWLOCK   1
+#define PTE_SYNC_COND     2
+#define PTE_SYNC_SEM      3
+#define PTE_SYNC_SPIN     4
+#define PTE_SYNC_BARRIER  5
+
+typedef struct pte_sync_entry_t_ pte_sync_entry_t;
+
+struct pte_sync_entry_t_
+  {
+    int state;
+    int type;
+    const void *object;		/* The object's handle */
+    const char *tag;		/* Set by pte_sync_settag_np, or NULL */
+    pte_sync_entry_t * owner;
+    int waits;
+    int waitMax;		/* Microseconds */
+    int hist[PTE_SYNC_HIST_BUCKETS];
+  };
+#endif /* PTE_SYNC_REGISTRY */
+
+/*
+ * A sem_wait_any_np() caller's entry on one semaphore. A post that
+ * leaves the value positive wakes every entry on the semaphore.
+ */
+typedef struct pte_sem_any_node_t_ pte_sem_any_node_t;
+
+struct pte_sem_any_node_t_
+  {
+    pte_sem_any_node_t * next;
+    struct sem_t_ * sem;	/* The semaphore this entry is on */
+    pte_osSemaphoreHandle wake;
+    int * signalled;		/* Shared by the waiter's nodes; set once
+				   'wake' has been posted */
+  };
+
 struct sem_t_
   {
     int value;
     pthread_mutex_t lock;
     pte_osSemaphoreHandle sem;
+    pte_sem_any_node_t * anyWaiters;	/* sem_wait_any_np() callers */
+#ifdef PTE_SYNC_REGISTRY
+    pte_sync_entry_t * syncEntry;
+#endif
   };
 
 #define PTE_OBJECT_AUTO_INIT ((void *) -1)
@@ -158,12 +295,31 @@ struct pthread_mutex_t_
 				   mutexes only). */
     int kind;			/* Mutex type. */
     pthread_t ownerThread;
+    int protocol;		/* PTHREAD_PRIO_NONE, _INHERIT or _PROTECT */
+    int prioceiling;		/* PTHREAD_PRIO_PROTECT only */
+    int prioBoost;		/* Priority owed to the owner: the ceiling,
+				   or the highest waiter for PTHREAD_PRIO_INHERIT. */
+    pthread_mutex_t prioNext;	/* Next mutex in owner's prioMutexes list */
+    pte_thread_t * prioWaiters;	/* PTHREAD_PRIO_INHERIT threads blocked on it */
+#ifdef PTE_MUTEX_STATS
+    pte_mutex_stats_t stats;	/* Updated only by the owner */
+    int statsFailures;		/* Updated atomically by non-owners */
+    unsigned long long holdStart;	/* When the owner acquired it, or 0
+				   if its hold is not being timed. */
+    pthread_mutex_t statsNext;	/* Links in pte_mutex_stats_list */
+    pthread_mutex_t statsPrev;
+#endif
+#ifdef PTE_SYNC_REGISTRY
+    pte_sync_entry_t * syncEntry;
+#endif
   };
 
 struct pthread_mutexattr_t_
   {
     int pshared;
     int kind;
+    int protocol;
+    int prioceiling;
   };
 
 /*
@@ -182,10 +338,25 @@ struct pthread_mutexattr_t_
  *
  * "u.cpus" isn't used for anything yet, but could be used at
  * some point to optimise spinlock behaviour.
+ *
+ * Ticket spinlocks (PTHREAD_SPIN_TICKET_NP) on more than one cpu
+ * have "interlock" set to PTE_SPIN_USE_TICKET for their lifetime;
+ * the lock is held while ticketNext != ticketServing.
  */
 #define PTE_SPIN_UNLOCKED    (1)
 #define PTE_SPIN_LOCKED      (2)
 #define PTE_SPIN_USE_MUTEX   (3)
+#define PTE_SPIN_USE_TICKET  (4)
+
+/*
+ * Spinning waiters pause for PTE_SPIN_BACKOFF_MIN relax hints after
+ * a failed attempt, doubling up to PTE_SPIN_BACKOFF_MAX. After
+ * PTE_SPIN_YIELD_ROUNDS pauses they also yield the cpu each round,
+ * in case the thread they are waiting for has been preempted.
+ */
+#define PTE_SPIN_BACKOFF_MIN 4
+#define PTE_SPIN_BACKOFF_MAX 1024
+#define PTE_SPIN_YIELD_ROUNDS 64
 
 struct pthread_spinlock_t_
   {
@@ -195,6 +366,11 @@ struct pthread_spinlock_t_
         int cpus;			/* No. of cpus if multi cpus, or   */
         pthread_mutex_t mutex;	/* mutex if single cpu.            */
       } u;
+    int ticketNext;		/* Next ticket to hand out         */
+    int ticketServing;		/* Ticket now holding the lock     */
+#ifdef PTE_SYNC_REGISTRY
+    pte_sync_entry_t * syncEntry;
+#endif
   };
 
 struct pthread_barrier_t_
@@ -204,6 +380,9 @@ struct pthread_barrier_t_
     int iStep;
     int pshared;
     sem_t semBarrierBreeched[2];
+#ifdef PTE_SYNC_REGISTRY
+    pte_sync_entry_t * syncEntry;
+#endif
   };
 
 struct pthread_barrierattr_t_
@@ -245,6 +424,9 @@ struct pthread_cond_t_
     /* +-> Optional* Sync.LEVEL-2           */
     pthread_cond_t next;		/* Doubly linked list                   */
     pthread_cond_t prev;
+#ifdef PTE_SYNC_REGISTRY
+    pte_sync_entry_t * syncEntry;
+#endif
   };
 
 
@@ -264,6 +446,9 @@ struct pthread_rwlock_t_
     int nExclusiveAccessCount;
     int nCompletedSharedAccessCount;
     int nMagic;
+#ifdef PTE_SYNC_REGISTRY
+    pte_sync_entry_t * syncEntry;
+#endif
   };
 
 struct pthread_rwlockattr_t_
@@ -271,6 +456,94 @@ struct pthread_rwlockattr_t_
     int pshared;
   };
 
+/*
+ * Thread pool - see pte_pool.c
+ *
+ * Tasks are queued in a bounded ring of cells. Each cell carries a
+ * sequence number that tells producers and consumers whose turn it
+ * is, so pushing and popping only need a compare-and-exchange on
+ * enqueuePos or dequeuePos (D. Vyukov's bounded MPMC queue).
+ */
+typedef struct pte_pool_task_t_ pte_pool_task_t;
+
+struct pte_pool_task_t_
+  {
+    int sequence;
+    void (*routine) (void *);
+    void *arg;
+  };
+
+struct pte_pool_t_
+  {
+    pte_pool_task_t * tasks;
+    int mask;			/* Ring size - 1, ring size is a power of 2 */
+    int enqueuePos;
+    int dequeuePos;
+    int outstanding;		/* Tasks submitted but not yet finished */
+    int sleepers;		/* Workers parked (or about to) on workSem */
+    int waiters;		/* Threads parked (or about to) on doneSem */
+    int shutdown;
+    pte_osSemaphoreHandle workSem;
+    pte_osSemaphoreHandle doneSem;
+    pthread_mutex_t lock;	/* Serialises shutdown and worker replacement */
+    pthread_attr_t attr;
+    int nthreads;		/* Workers started */
+    int workersSize;		/* Entries allocated in workers */
+    pthread_t *workers;
+  };
+
+/*
+ * Work-stealing task scheduler - see pte_task.c
+ *
+ * Each worker owns a fixed size Chase-Lev deque: the owner pushes and
+ * pops at 'bottom', thieves take from 'top'. Tasks spawned by threads
+ * that are not workers go on a locked injection list instead.
+ */
+#define PTE_TASK_DEQUE_SIZE     1024	/* Per worker, a power of 2 */
+#define PTE_TASK_SPINS          64	/* Failed steal rounds before parking */
+#define PTE_TASK_CACHE          64	/* Free tasks a worker keeps */
+
+#define PTE_TASK_QUEUED         0
+#define PTE_TASK_DONE           1
+#define PTE_TASK_ABANDONED      2	/* Syncing thread was cancelled */
+#define PTE_TASK_WAITING        3	/* Syncing thread parked on waitSem */
+
+struct pte_task_t_
+  {
+    void (*routine) (void *);
+    void *arg;
+    int state;
+    pte_osSemaphoreHandle waitSem;	/* Posted once when a WAITING task is done */
+    pte_task_t next;		/* Injection list or free cache link */
+  };
+
+typedef struct pte_task_worker_t_ pte_task_worker_t;
+
+struct pte_task_worker_t_
+  {
+    int top;
+    int bottom;
+    pte_task_t * deque;
+    pte_task_t freeTasks;
+    int nfree;
+    unsigned int seed;		/* For choosing victims */
+    pthread_t thread;
+  };
+
+typedef struct pte_task_sched_t_ pte_task_sched_t;
+
+struct pte_task_sched_t_
+  {
+    pte_task_worker_t * workers;
+    int nworkers;
+    int running;
+    int shutdown;
+    int sleepers;		/* Workers parked (or about to) on workSem */
+    pte_osSemaphoreHandle workSem;
+    pte_task_t injectHead;
+    pte_task_t injectTail;
+  };
+
 /*
  * MCS lock queue node - see pte_MCS_lock.c
  */
@@ -287,6 +560,41 @@ struct pte_mcs_node_t_
 typedef struct pte_mcs_node_t_   pte_mcs_local_node_t;
 typedef struct pte_mcs_node_t_  *pte_mcs_lock_t;
 
+/*
+ * Parking lot - see pte_park.c
+ *
+ * Threads waiting for an inline lock word queue on the bucket its
+ * address hashes to, each on its own park semaphore.
+ */
+#define PTE_PARK_BUCKETS        64	/* A power of 2 */
+#define PTE_LOCK_SPINS          100	/* Tries before parking */
+
+#define PTE_LOCK_FREE           0
+#define PTE_LOCK_HELD           1
+#define PTE_LOCK_CONTENDED      2	/* Held, and threads may be parked */
+
+typedef struct pte_park_node_t_ pte_park_node_t;
+
+struct pte_park_node_t_
+  {
+    pte_park_node_t * next;
+    volatile int *addr;
+    pte_osSemaphoreHandle sem;
+  };
+
+/*
+ * A pthread_join_any_np() caller, registered with each thread it
+ * waits for. The first of them to finish sets winner, and each one
+ * that finishes posts sem.
+ */
+typedef struct pte_join_any_t_ pte_join_any_t;
+
+struct pte_join_any_t_
+  {
+    void * volatile winner;
+    pte_osSemaphoreHandle sem;
+  };
+
 
 struct ThreadKeyAssoc
   {
@@ -429,11 +737,37 @@ extern int pte_concurrency;
 extern int pte_features;
 
 extern pte_osMutexHandle pte_thread_reuse_lock;
-extern pte_osMutexHandle pte_mutex_test_init_lock;
 extern pte_osMutexHandle pte_cond_list_lock;
-extern pte_osMutexHandle pte_cond_test_init_lock;
-extern pte_osMutexHandle pte_rwlock_test_init_lock;
-extern pte_osMutexHandle pte_spinlock_test_init_lock;
+extern pte_osMutexHandle pte_mutex_prio_lock;
+extern pte_osMutexHandle pte_stack_pool_lock;
+
+extern int pte_stack_pool_max;
+extern unsigned int pte_stack_pool_guard;
+extern pte_osMutexHandle pte_task_lock;
+extern pte_task_sched_t pte_task_sched;
+
+extern const pte_trace_hooks_t * pte_trace_hooks;
+extern const pte_trace_hooks_t pte_trace_recorder;
+extern pte_osMutexHandle pte_trace_lock;
+extern pte_trace_ring_t * pte_trace_rings;
+extern int pte_trace_ring_size;
+extern int pte_trace_next_tid;
+
+extern const pte_allocator_t * pte_allocator;
+extern pte_alloc_counters_t pte_alloc_counters[PTE_ALLOC_TYPES];
+
+#ifdef PTE_MUTEX_STATS
+extern pte_osMutexHandle pte_mutex_stats_lock;
+extern pthread_mutex_t pte_mutex_stats_list;
+extern int pte_mutex_stats_enabled;
+#endif
+
+#ifdef PTE_SYNC_REGISTRY
+extern pte_sync_entry_t pte_sync_registry[PTE_SYNC_REGISTRY_SIZE];
+extern int pte_sync_registry_next;
+extern int pte_sync_registry_dropped;
+extern pte_osMutexHandle pte_sync_reporter_lock;
+#endif
 
 
 #ifdef __cplusplus
@@ -451,6 +785,8 @@ extern "C"
 
     int pte_is_attr (const pthread_attr_t * attr);
 
+    int pte_is_cpumask (unsigned int cpumask);
+
     int pte_cond_check_need_init (pthread_cond_t * cond);
     int pte_mutex_check_need_init (pthread_mutex_t * mutex);
     int pte_rwlock_check_need_init (pthread_rwlock_t * rwlock);
@@ -475,6 +811,73 @@ extern "C"
 
     int pte_setthreadpriority (pthread_t thread, int policy, int priority);
 
+    int pte_prio_lowest (void);
+    int pte_prio_highest (void);
+    int pte_mutex_prio_check (pthread_mutex_t mx);
+    void pte_mutex_prio_wait (pthread_mutex_t mx);
+    void pte_mutex_prio_abandon (pthread_mutex_t mx);
+    void pte_mutex_prio_acquired (pthread_mutex_t mx);
+    void pte_mutex_prio_release (pthread_mutex_t mx);
+    void pte_thread_prio_update (pte_thread_t * tp);
+
+    void *pte_stack_pool_get (unsigned int *stackSize);
+    void pte_stack_pool_put (void *stackAddr, unsigned int stackSize);
+    void pte_stack_pool_retire (pte_osThreadHandle threadId,
+                                void *stackAddr, unsigned int stackSize);
+    int pte_stack_pool_busy (void);
+    void pte_stack_pool_flush (void);
+
+    int pte_pool_push (pte_pool_t pool, void (*routine) (void *), void *arg);
+    void pte_pool_wake (int *count, pte_osSemaphoreHandle semHandle, int all);
+    void pte_pool_unpark (int *count, pte_osSemaphoreHandle semHandle);
+    void pte_pool_task_done (pte_pool_t pool);
+    int pte_pool_is_worker (pte_pool_t pool);
+    int pte_pool_run (pte_thread_t * sp, void (*routine) (void *), void *arg,
+                      int cancelState);
+
+    pte_task_t pte_task_alloc (pte_task_worker_t * w);
+    void pte_task_free (pte_task_worker_t * w, pte_task_t task);
+    int pte_task_push (pte_task_worker_t * w, pte_task_t task);
+    pte_task_t pte_task_pop (pte_task_worker_t * w);
+    pte_task_t pte_task_steal (pte_task_worker_t * w);
+    void pte_task_inject (pte_task_t task);
+    void pte_task_run (pte_thread_t * sp, pte_task_t task);
+    int pte_task_park (pte_thread_t * sp, pte_task_t task);
+    void pte_task_notify (void);
+    void pte_task_stop (int nstarted);
+    void *pte_task_worker (void *arg);
+    void *pte_pool_worker (void *arg);
+
+    void *pte_alloc (int type, size_t size);
+    void pte_free (int type, void *ptr, size_t size);
+    int pte_slab_class (int type, size_t size);
+    void *pte_slab_get (int cls);
+    void pte_slab_put (int cls, void *ptr);
+    void pte_slab_init (void);
+    void pte_slab_thread_exit (void);
+    void pte_slab_flush (void);
+
+    void pte_trace_event (int event, const void *object);
+    void pte_trace_free_rings (void);
+
+#ifdef PTE_MUTEX_STATS
+    void pte_mutex_stats_link (pthread_mutex_t mx);
+    void pte_mutex_stats_unlink (pthread_mutex_t mx);
+    unsigned long long pte_mutex_stats_wait_start (void);
+    void pte_mutex_stats_acquired (pthread_mutex_t mx,
+                                   unsigned long long waitStart);
+    void pte_mutex_stats_released (pthread_mutex_t mx);
+    void pte_mutex_stats_failed (pthread_mutex_t mx);
+    void pte_mutex_stats_get (pthread_mutex_t mx, pte_mutex_stats_t * stats);
+#endif
+
+#ifdef PTE_SYNC_REGISTRY
+    pte_sync_entry_t *pte_sync_register (int type, const void *object);
+    void pte_sync_unregister (pte_sync_entry_t * entry);
+    void pte_sync_adopt (pte_sync_entry_t * entry, pte_sync_entry_t * owner);
+    void pte_sync_waited (pte_sync_entry_t * entry, unsigned long long start);
+#endif
+
     void pte_rwlock_cancelwrwait (void *arg);
 
     int pte_threadStart (void *vthreadParms);
@@ -487,23 +890,191 @@ extern "C"
 
     int sem_wait_nocancel (sem_t * sem);
 
+    void pte_sem_wake_any (sem_t s);
+
     unsigned int pte_relmillisecs (const struct timespec * abstime);
 
     void pte_mcs_lock_acquire (pte_mcs_lock_t * lock, pte_mcs_local_node_t * node);
 
     void pte_mcs_lock_release (pte_mcs_local_node_t * node);
 
+    void pte_park_init (void);
+
+    void pte_park (volatile int *addr, int expected);
+
+    void pte_unpark_one (volatile int *addr);
+
     /* Declared in private.c */
     void pte_throw (unsigned int exception);
 
-    int pte_cancellable_wait (pte_osSemaphoreHandle semHandle, unsigned int* timeout);
+    int pte_cancellable_wait (pte_osSemaphoreHandle semHandle, unsigned int* timeout,
+                              const void *traceObject);
+
+    int pte_join (pthread_t thread, void **value_ptr, unsigned int *timeout);
+
+/*
+ * Atomic operations.  The unsuffixed forms are full barriers.  The
+ * suffixed forms state the weakest ordering the caller relies on:
+ * _ACQUIRE when taking a lock or reading a flag that publishes data,
+ * _RELEASE when dropping a lock, _ACQ_REL for an RMW that does both,
+ * and _RELAXED for counters and for spinning reads that are followed
+ * by an acquiring operation.  The _PTR forms work on pointers.
+ *
+ * If the OSAL header defines OS_HAVE_INLINE_ATOMICS and the compiler
+ * has the __atomic builtins, all of them expand inline with exactly
+ * that ordering.  Otherwise they call the OSAL functions, which are
+ * full barriers and so always strong enough.
+ */
+#if defined(OS_HAVE_INLINE_ATOMICS) && defined(__ATOMIC_ACQUIRE)
+
+#define PTE_ATOMIC_EXCHANGE(p, v) \
+  __atomic_exchange_n ((p), (v), __ATOMIC_SEQ_CST)
+#define PTE_ATOMIC_EXCHANGE_ADD(p, v) \
+  __atomic_fetch_add ((p), (v), __ATOMIC_SEQ_CST)
+#define PTE_ATOMIC_COMPARE_EXCHANGE(p, exch, comp) \
+  __sync_val_compare_and_swap ((p), (comp), (exch))
+#define PTE_ATOMIC_COMPARE_EXCHANGE_PTR(p, exch, comp) \
+  __sync_val_compare_and_swap ((p), (comp), (exch))
+#define PTE_ATOMIC_DECREMENT(p) \
+  __atomic_sub_fetch ((p), 1, __ATOMIC_SEQ_CST)
+#define PTE_ATOMIC_INCREMENT(p) \
+  __atomic_add_fetch ((p), 1, __ATOMIC_SEQ_CST)
+
+#define PTE_ATOMIC_LOAD_PTR(p) \
+  __atomic_load_n ((p), __ATOMIC_SEQ_CST)
+
+#define PTE_ATOMIC_LOAD_RELAXED(p) \
+  __atomic_load_n ((p), __ATOMIC_RELAXED)
+#define PTE_ATOMIC_LOAD_ACQUIRE(p) \
+  __atomic_load_n ((p), __ATOMIC_ACQUIRE)
+#define PTE_ATOMIC_LOAD_PTR_RELAXED(p) \
+  __atomic_load_n ((p), __ATOMIC_RELAXED)
+#define PTE_ATOMIC_LOAD_PTR_ACQUIRE(p) \
+  __atomic_load_n ((p), __ATOMIC_ACQUIRE)
+#define PTE_ATOMIC_STORE_RELAXED(p, v) \
+  __atomic_store_n ((p), (v), __ATOMIC_RELAXED)
+#define PTE_ATOMIC_STORE_RELEASE(p, v) \
+  __atomic_store_n ((p), (v), __ATOMIC_RELEASE)
+#define PTE_ATOMIC_EXCHANGE_ACQUIRE(p, v) \
+  __atomic_exchange_n ((p), (v), __ATOMIC_ACQUIRE)
+#define PTE_ATOMIC_EXCHANGE_RELEASE(p, v) \
+  __atomic_exchange_n ((p), (v), __ATOMIC_RELEASE)
+#define PTE_ATOMIC_EXCHANGE_ADD_RELAXED(p, v) \
+  __atomic_fetch_add ((p), (v), __ATOMIC_RELAXED)
+#define PTE_ATOMIC_DECREMENT_ACQ_REL(p) \
+  __atomic_sub_fetch ((p), 1, __ATOMIC_ACQ_REL)
+
+/* int only: returns the old value, like PTE_ATOMIC_COMPARE_EXCHANGE. */
+#define PTE_ATOMIC_COMPARE_EXCHANGE_ORDERED(p, exch, comp, order) \
+  __extension__ ({ int pte_atomic_old_ = (comp); \
+                   (void) __atomic_compare_exchange_n ((p), &pte_atomic_old_, \
+                                                       (exch), 0, (order), \
+                                                       __ATOMIC_RELAXED); \
+                   pte_atomic_old_; })
+#define PTE_ATOMIC_COMPARE_EXCHANGE_ACQUIRE(p, exch, comp) \
+  PTE_ATOMIC_COMPARE_EXCHANGE_ORDERED ((p), (exch), (comp), __ATOMIC_ACQUIRE)
+#define PTE_ATOMIC_COMPARE_EXCHANGE_RELEASE(p, exch, comp) \
+  PTE_ATOMIC_COMPARE_EXCHANGE_ORDERED ((p), (exch), (comp), __ATOMIC_RELEASE)
+
+#else
 
 #define PTE_ATOMIC_EXCHANGE pte_osAtomicExchange
 #define PTE_ATOMIC_EXCHANGE_ADD pte_osAtomicExchangeAdd
 #define PTE_ATOMIC_COMPARE_EXCHANGE pte_osAtomicCompareExchange
+#define PTE_ATOMIC_COMPARE_EXCHANGE_PTR pte_osAtomicCompareExchangePtr
 #define PTE_ATOMIC_DECREMENT pte_osAtomicDecrement
 #define PTE_ATOMIC_INCREMENT pte_osAtomicIncrement
 
+#define PTE_ATOMIC_LOAD_PTR(p) \
+  pte_osAtomicCompareExchangePtr ((void * volatile *) (p), NULL, NULL)
+
+#define PTE_ATOMIC_LOAD_RELAXED(p) (*(int volatile *) (p))
+#define PTE_ATOMIC_LOAD_ACQUIRE(p) pte_osAtomicExchangeAdd ((p), 0)
+#define PTE_ATOMIC_LOAD_PTR_RELAXED(p) (*(void * volatile *) (p))
+#define PTE_ATOMIC_LOAD_PTR_ACQUIRE(p) \
+  pte_osAtomicCompareExchangePtr ((void * volatile *) (p), NULL, NULL)
+#define PTE_ATOMIC_STORE_RELAXED(p, v) \
+  ((void) (*(int volatile *) (p) = (v)))
+#define PTE_ATOMIC_STORE_RELEASE(p, v) \
+  ((void) pte_osAtomicExchange ((p), (v)))
+#define PTE_ATOMIC_EXCHANGE_ACQUIRE pte_osAtomicExchange
+#define PTE_ATOMIC_EXCHANGE_RELEASE pte_osAtomicExchange
+#define PTE_ATOMIC_EXCHANGE_ADD_RELAXED pte_osAtomicExchangeAdd
+#define PTE_ATOMIC_DECREMENT_ACQ_REL pte_osAtomicDecrement
+#define PTE_ATOMIC_COMPARE_EXCHANGE_ACQUIRE pte_osAtomicCompareExchange
+#define PTE_ATOMIC_COMPARE_EXCHANGE_RELEASE pte_osAtomicCompareExchange
+
+#endif
+
+/*
+ * 64-bit and pointer-pair atomics (full barriers) are inlined only
+ * where the cpu has a compare-and-swap that wide.  PTE_ATOMIC_LOAD64
+ * is needed to read a 64-bit value that other threads update, since
+ * a plain load is two loads on a 32-bit cpu.
+ */
+#if defined(OS_HAVE_INLINE_ATOMICS) && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8)
+#define PTE_ATOMIC_EXCHANGE_ADD64(p, v) __sync_fetch_and_add ((p), (v))
+#else
+#define PTE_ATOMIC_EXCHANGE_ADD64 pte_osAtomicExchangeAdd64
+#endif
+
+#define PTE_ATOMIC_LOAD64(p) PTE_ATOMIC_EXCHANGE_ADD64 ((p), 0)
+
+#if defined(OS_HAVE_INLINE_ATOMICS) && __SIZEOF_POINTER__ == 4 \
+    && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8)
+#define PTE_ATOMIC_PAIR_BITS unsigned long long
+#elif defined(OS_HAVE_INLINE_ATOMICS) && __SIZEOF_POINTER__ == 8 \
+    && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+#define PTE_ATOMIC_PAIR_BITS unsigned __int128
+#endif
+
+#ifdef PTE_ATOMIC_PAIR_BITS
+#define PTE_ATOMIC_COMPARE_EXCHANGE_PAIR(p, exch, comp) \
+  __extension__ ({ union { pte_osAtomicPair pair; PTE_ATOMIC_PAIR_BITS bits; } \
+                     pte_atomic_e_, pte_atomic_c_; \
+                   pte_atomic_e_.pair = (exch); \
+                   pte_atomic_c_.pair = (comp); \
+                   pte_atomic_c_.bits = __sync_val_compare_and_swap ( \
+                     (PTE_ATOMIC_PAIR_BITS volatile *) (p), \
+                     pte_atomic_c_.bits, pte_atomic_e_.bits); \
+                   pte_atomic_c_.pair; })
+#else
+#define PTE_ATOMIC_COMPARE_EXCHANGE_PAIR pte_osAtomicCompareExchangePair
+#endif
+
+/*
+ * Hint to the cpu that the caller is busy-waiting: lets the other
+ * hardware thread run, or saves power, where the cpu supports it.
+ */
+#if defined(__arm__) || defined(__aarch64__)
+#define PTE_CPU_RELAX() __asm__ __volatile__ ("yield" ::: "memory")
+#elif defined(__i386__) || defined(__x86_64__)
+#define PTE_CPU_RELAX() __asm__ __volatile__ ("pause" ::: "memory")
+#elif defined(__GNUC__)
+#define PTE_CPU_RELAX() __asm__ __volatile__ ("" ::: "memory")
+#else
+#define PTE_CPU_RELAX() do { } while (0)
+#endif
+
+/*
+ * sp->cancelPending is nonzero while a deferred cancel is pending and
+ * cancelability is enabled, so that cancellation points can return
+ * after one relaxed load when there is nothing to act on.  Whoever
+ * changes sp->state or sp->cancelState, holding sp->cancelLock,
+ * republishes it.
+ */
+#define PTE_CANCEL_PUBLISH(sp) \
+  PTE_ATOMIC_STORE_RELEASE (&(sp)->cancelPending, \
+                            (sp)->state == PThreadStateCancelPending \
+                            && (sp)->cancelState == PTHREAD_CANCEL_ENABLE)
+
+/*
+ * Tracepoint: with no hooks installed this is a single load and
+ * branch, so it can sit on blocking paths.
+ */
+#define PTE_TRACE(event, object) \
+  do { if (pte_trace_hooks != NULL) pte_trace_event ((event), (object)); } while (0)
+
     int  pte_thread_detach_np();
     int  pte_thread_detach_and_exit_np();
 
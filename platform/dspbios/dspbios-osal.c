@@ -35,6 +35,7 @@
 #include <mbx.h>
 
 #include <pthread.h>
+#include <sys/sched.h>
 
 #include "tls-helper.h"
 #include "pte_osal.h"
@@ -172,6 +173,25 @@ pte_osResult pte_osInit(void)
   return result;
 }
 
+/****************************************************************************
+ *
+ * Stacks
+ *
+ ***************************************************************************/
+
+pte_osResult pte_osStackAlloc(unsigned int stackSize, unsigned int guardSize, void **pStackAddr)
+{
+  /* DSP/BIOS has no memory protection, so the guard region is not allocated */
+  *pStackAddr = malloc(stackSize);
+
+  return (*pStackAddr == NULL) ? PTE_OS_NO_RESOURCES : PTE_OS_OK;
+}
+
+void pte_osStackFree(void *stackAddr, unsigned int stackSize, unsigned int guardSize)
+{
+  free(stackAddr);
+}
+
 /****************************************************************************
  *
  * Threads
@@ -198,11 +218,12 @@ void dspbiosStubThreadEntry (void *argv, pte_osThreadEntryPoint entryPoint)
  * stacks from.  This should be done in the projects tcf or cdb file.
  *
  */
-pte_osResult pte_osThreadCreate(pte_osThreadEntryPoint entryPoint,
-                                int stackSize,
-                                int initialPriority,
-                                void *argv,
-                                pte_osThreadHandle* ppte_osThreadHandle)
+static pte_osResult dspbiosThreadCreate(pte_osThreadEntryPoint entryPoint,
+                                        void *stackAddr,
+                                        int stackSize,
+                                        int initialPriority,
+                                        void *argv,
+                                        pte_osThreadHandle* ppte_osThreadHandle)
 {
   TSK_Handle handle;
   TSK_Attrs attrs;
@@ -213,6 +234,12 @@ pte_osResult pte_osThreadCreate(pte_osThreadEntryPoint entryPoint,
   /* Make sure that the stack we're going to allocate is big enough */
   if (stackSize < DEFAULT_STACK_SIZE_BYTES)
     {
+      if (stackAddr != NULL)
+        {
+          result = PTE_OS_INVALID_PARAM;
+          goto FAIL0;
+        }
+
       stackSize = DEFAULT_STACK_SIZE_BYTES;
     }
 
@@ -259,6 +286,12 @@ pte_osResult pte_osThreadCreate(pte_osThreadEntryPoint entryPoint,
   /* Use  value specified by user */
   attrs.stacksize = stackSize;
 
+  /* Caller supplied stack, if any. TSK_delete() does not free it. */
+  if (stackAddr != NULL)
+    {
+      attrs.stack = stackAddr;
+    }
+
   attrs.priority  = -1;
 
   /* Save our TLS structure as the task's environment. */
@@ -285,6 +318,27 @@ FAIL0:
   return result;
 }
 
+pte_osResult pte_osThreadCreate(pte_osThreadEntryPoint entryPoint,
+                                int stackSize,
+                                int initialPriority,
+                                void *argv,
+                                pte_osThreadHandle* ppte_osThreadHandle)
+{
+  return dspbiosThreadCreate(entryPoint, NULL, stackSize, initialPriority,
+                             argv, ppte_osThreadHandle);
+}
+
+pte_osResult pte_osThreadCreateWithStack(pte_osThreadEntryPoint entryPoint,
+                                         void *stackAddr,
+                                         int stackSize,
+                                         int initialPriority,
+                                         void *argv,
+                                         pte_osThreadHandle* ppte_osThreadHandle)
+{
+  return dspbiosThreadCreate(entryPoint, stackAddr, stackSize, initialPriority,
+                             argv, ppte_osThreadHandle);
+}
+
 /* Start executing a thread.
  *
  * Get the priority that the user specified when they called
@@ -509,6 +563,12 @@ void pte_osThreadSleep(unsigned int msecs)
   TSK_sleep(ticks);
 }
 
+unsigned long long pte_osClockGetMicros(void)
+{
+  /* High resolution counts, CLK_countspms() of them per millisecond */
+  return ((unsigned long long) CLK_gethtime() * 1000) / CLK_countspms();
+}
+
 pte_osThreadHandle pte_osThreadGetHandle(void)
 {
   return TSK_self();
@@ -526,6 +586,31 @@ pte_osResult pte_osThreadSetPriority(pte_osThreadHandle threadHandle, int newPri
   return PTE_OS_OK;
 }
 
+pte_osResult pte_osThreadSetSchedPolicy(pte_osThreadHandle threadHandle, int policy)
+{
+  /*
+   * DSP/BIOS tasks are scheduled strictly by priority without
+   * time slicing, i.e. SCHED_FIFO. There is no round robin.
+   */
+  if (policy == SCHED_RR)
+    {
+      return PTE_OS_GENERAL_FAILURE;
+    }
+
+  return PTE_OS_OK;
+}
+
+pte_osResult pte_osThreadSetAffinity(pte_osThreadHandle threadHandle, unsigned int cpuMask)
+{
+  /* DSP/BIOS tasks all run on the one DSP core */
+  if ((cpuMask & 1) == 0)
+    {
+      return PTE_OS_INVALID_PARAM;
+    }
+
+  return PTE_OS_OK;
+}
+
 int pte_osThreadGetMinPriority()
 {
   return TSK_MINPRI;
@@ -542,6 +627,12 @@ int pte_osThreadGetDefaultPriority()
   return ((TSK_MINPRI + TSK_MAXPRI) / 2);
 }
 
+int pte_osThreadComparePriority(int priority1, int priority2)
+{
+  /* A higher number is more urgent */
+  return priority1 - priority2;
+}
+
 /****************************************************************************
  *
  * Mutexes
@@ -781,6 +872,54 @@ int pte_osAtomicCompareExchange(int *pdest, int exchange, int comp)
 
 }
 
+pte_osAtomicPair pte_osAtomicCompareExchangePair(pte_osAtomicPair volatile *pdest,
+                                                 pte_osAtomicPair exchange,
+                                                 pte_osAtomicPair comp)
+{
+
+  pte_osAtomicPair origVal;
+  Uns oldCSR;
+
+  oldCSR = HWI_disable();
+
+
+  origVal = *pdest;
+
+  if (origVal.ptr == comp.ptr && origVal.tag == comp.tag)
+    {
+      *pdest = exchange;
+    }
+
+  HWI_restore(oldCSR);
+
+
+  return origVal;
+
+}
+
+void *pte_osAtomicCompareExchangePtr(void * volatile *pdest, void *exchange, void *comp)
+{
+
+  void *origVal;
+  Uns oldCSR;
+
+  oldCSR = HWI_disable();
+
+
+  origVal = *pdest;
+
+  if (*pdest == comp)
+    {
+      *pdest = exchange;
+    }
+
+  HWI_restore(oldCSR);
+
+
+  return origVal;
+
+}
+
 int pte_osAtomicExchangeAddInt(int volatile* pAddend, int value)
 {
 
@@ -820,6 +959,25 @@ int pte_osAtomicExchangeAdd(int volatile* pAddend, int value)
   return origVal;
 }
 
+long long pte_osAtomicExchangeAdd64(long long volatile* pAddend, long long value)
+{
+
+  long long origVal;
+  Uns oldCSR;
+
+  oldCSR = HWI_disable();
+
+
+  origVal = *pAddend;
+
+  *pAddend += value;
+
+  HWI_restore(oldCSR);
+
+
+  return origVal;
+}
+
 int pte_osAtomicDecrement(int *pdest)
 {
   int val;
@@ -31,6 +31,9 @@
 
 #include "tls-helper.h"
 
+#include <pthread.h>
+#include "implement.h"
+
 static int *keysUsed;
 
 /* We don't protect this - it's only written on startup */
@@ -45,7 +48,7 @@ pte_osResult pteTlsGlobalInit(int maxEntries)
 
   pte_osMutexCreate(&globalTlsLock);
 
-  keysUsed = (int *) malloc(maxEntries * sizeof(int));
+  keysUsed = (int *) pte_alloc(PTE_ALLOC_TLS, maxEntries * sizeof(int));
 
   if (keysUsed != NULL)
     {
@@ -72,7 +75,7 @@ void * pteTlsThreadInit(void)
   void ** pTlsStruct;
   int i;
 
-  pTlsStruct = (void **) malloc(maxTlsValues * sizeof(void*));
+  pTlsStruct = (void **) pte_alloc(PTE_ALLOC_TLS, maxTlsValues * sizeof(void*));
 
   // PTE library assumes that keys are initialized to zero
   for (i=0; i<maxTlsValues;i++)
@@ -175,11 +178,11 @@ pte_osResult pteTlsFree(unsigned int index)
 
 void pteTlsThreadDestroy(void * pTlsThreadStruct)
 {
-  free(pTlsThreadStruct);
+  pte_free(PTE_ALLOC_TLS, pTlsThreadStruct, maxTlsValues * sizeof(void*));
 }
 
 void pteTlsGlobalDestroy(void)
 {
   pte_osMutexDelete(globalTlsLock);
-  free(keysUsed);
+  pte_free(PTE_ALLOC_TLS, keysUsed, maxTlsValues * sizeof(int));
 }
@@ -29,10 +29,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <malloc.h>
 #include <string.h>
 #include <pspkerror.h>
 #include "pte_osal.h"
 #include "pthread.h"
+#include <sys/sched.h>
 #include "tls-helper.h"
 
 /* For ftime */
@@ -159,6 +161,25 @@ pte_osResult pte_osInit(void)
   return result;
 }
 
+/****************************************************************************
+ *
+ * Stacks
+ *
+ ***************************************************************************/
+
+pte_osResult pte_osStackAlloc(unsigned int stackSize, unsigned int guardSize, void **pStackAddr)
+{
+  /* No memory protection on the PSP, so the guard region is not allocated */
+  *pStackAddr = memalign(16, stackSize);
+
+  return (*pStackAddr == NULL) ? PTE_OS_NO_RESOURCES : PTE_OS_OK;
+}
+
+void pte_osStackFree(void *stackAddr, unsigned int stackSize, unsigned int guardSize)
+{
+  free(stackAddr);
+}
+
 /****************************************************************************
  *
  * Threads
@@ -274,6 +295,17 @@ FAIL0:
   return result;
 }
 
+pte_osResult pte_osThreadCreateWithStack(pte_osThreadEntryPoint entryPoint,
+                                         void *stackAddr,
+                                         int stackSize,
+                                         int initialPriority,
+                                         void *argv,
+                                         pte_osThreadHandle* ppte_osThreadHandle)
+{
+  /* sceKernelCreateThread always allocates the stack itself */
+  return PTE_OS_GENERAL_FAILURE;
+}
+
 
 pte_osResult pte_osThreadStart(pte_osThreadHandle osThreadHandle)
 {
@@ -403,6 +435,32 @@ pte_osResult pte_osThreadSetPriority(pte_osThreadHandle threadHandle, int newPri
   return PTE_OS_OK;
 }
 
+pte_osResult pte_osThreadSetSchedPolicy(pte_osThreadHandle threadHandle, int policy)
+{
+  /*
+   * The PSP kernel runs the highest priority ready thread until it
+   * blocks and never time slices, which is SCHED_FIFO behaviour
+   * whatever policy is asked for. There is no round robin.
+   */
+  if (policy == SCHED_RR)
+    {
+      return PTE_OS_GENERAL_FAILURE;
+    }
+
+  return PTE_OS_OK;
+}
+
+pte_osResult pte_osThreadSetAffinity(pte_osThreadHandle threadHandle, unsigned int cpuMask)
+{
+  /* The PSP has a single CPU available to user threads */
+  if ((cpuMask & 1) == 0)
+    {
+      return PTE_OS_INVALID_PARAM;
+    }
+
+  return PTE_OS_OK;
+}
+
 pte_osResult pte_osThreadCancel(pte_osThreadHandle threadHandle)
 {
   SceUID osResult;
@@ -470,6 +528,11 @@ void pte_osThreadSleep(unsigned int msecs)
   sceKernelDelayThread(msecs*1000);
 }
 
+unsigned long long pte_osClockGetMicros(void)
+{
+  return sceKernelGetSystemTimeWide();
+}
+
 int pte_osThreadGetMinPriority()
 {
   return 17;
@@ -485,6 +548,12 @@ int pte_osThreadGetDefaultPriority()
   return 18;
 }
 
+int pte_osThreadComparePriority(int priority1, int priority2)
+{
+  /* A lower number is more urgent */
+  return priority2 - priority1;
+}
+
 /****************************************************************************
  *
  * Mutexes
@@ -768,6 +837,42 @@ int pte_osAtomicCompareExchange(int *pdest, int exchange, int comp)
   return origVal;
 }
 
+pte_osAtomicPair pte_osAtomicCompareExchangePair(pte_osAtomicPair volatile *pdest,
+                                                 pte_osAtomicPair exchange,
+                                                 pte_osAtomicPair comp)
+{
+  int intc = pspSdkDisableInterrupts();
+  pte_osAtomicPair origVal;
+
+  origVal = *pdest;
+
+  if (origVal.ptr == comp.ptr && origVal.tag == comp.tag)
+    {
+      *pdest = exchange;
+    }
+
+  pspSdkEnableInterrupts(intc);
+
+  return origVal;
+}
+
+
+void *pte_osAtomicCompareExchangePtr(void * volatile *pdest, void *exchange, void *comp)
+{
+  int intc = pspSdkDisableInterrupts();
+  void *origVal;
+
+  origVal = *pdest;
+
+  if (*pdest == comp)
+    {
+      *pdest = exchange;
+    }
+
+  pspSdkEnableInterrupts(intc);
+
+  return origVal;
+}
 
 int pte_osAtomicExchangeAdd(int volatile* pAddend, int value)
 {
@@ -783,6 +888,20 @@ int pte_osAtomicExchangeAdd(int volatile* pAddend, int value)
   return origVal;
 }
 
+long long pte_osAtomicExchangeAdd64(long long volatile* pAddend, long long value)
+{
+  long long origVal;
+  int intc = pspSdkDisableInterrupts();
+
+  origVal = *pAddend;
+
+  *pAddend += value;
+
+  pspSdkEnableInterrupts(intc);
+
+  return origVal;
+}
+
 int pte_osAtomicDecrement(int *pdest)
 {
   int val;
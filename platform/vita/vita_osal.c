@@ -72,6 +72,22 @@ pte_osResult PSP2CLDR_STUB pte_osInit(void) // per-process init
     UDF_TRAP;
 }
 
+/****************************************************************************
+ *
+ * Stacks
+ *
+ ***************************************************************************/
+
+pte_osResult PSP2CLDR_STUB pte_osStackAlloc(unsigned int stackSize, unsigned int guardSize, void **pStackAddr)
+{
+    UDF_TRAP;
+}
+
+void PSP2CLDR_STUB pte_osStackFree(void *stackAddr, unsigned int stackSize, unsigned int guardSize)
+{
+    UDF_TRAP;
+}
+
 /****************************************************************************
  *
  * Threads
@@ -87,6 +103,16 @@ pte_osResult PSP2CLDR_STUB pte_osThreadCreate(pte_osThreadEntryPoint entryPoint,
     UDF_TRAP;
 }
 
+pte_osResult PSP2CLDR_STUB pte_osThreadCreateWithStack(pte_osThreadEntryPoint entryPoint,
+                                                       void *stackAddr,
+                                                       int stackSize,
+                                                       int initialPriority,
+                                                       void *argv,
+                                                       pte_osThreadHandle *ppte_osThreadHandle)
+{
+    UDF_TRAP;
+}
+
 pte_osResult PSP2CLDR_STUB pte_osThreadStart(pte_osThreadHandle osThreadHandle)
 {
     UDF_TRAP;
@@ -131,6 +157,16 @@ pte_osResult PSP2CLDR_STUB pte_osThreadSetPriority(pte_osThreadHandle threadHand
     UDF_TRAP;
 }
 
+pte_osResult PSP2CLDR_STUB pte_osThreadSetSchedPolicy(pte_osThreadHandle threadHandle, int policy)
+{
+    UDF_TRAP;
+}
+
+pte_osResult PSP2CLDR_STUB pte_osThreadSetAffinity(pte_osThreadHandle threadHandle, unsigned int cpuMask)
+{
+    UDF_TRAP;
+}
+
 pte_osResult PSP2CLDR_STUB pte_osThreadCancel(pte_osThreadHandle threadHandle)
 {
     UDF_TRAP;
@@ -146,6 +182,11 @@ void PSP2CLDR_STUB pte_osThreadSleep(unsigned int msecs)
     UDF_TRAP;
 }
 
+unsigned long long PSP2CLDR_STUB pte_osClockGetMicros(void)
+{
+    UDF_TRAP;
+}
+
 int pte_osThreadGetMinPriority()
 {
     return pte_osThreadGetDefaultPriority() - 32;
@@ -161,6 +202,12 @@ int pte_osThreadGetDefaultPriority()
     return 160;
 }
 
+int pte_osThreadComparePriority(int priority1, int priority2)
+{
+    /* A lower number is more urgent */
+    return priority2 - priority1;
+}
+
 #ifdef PTE_SUPPORT_ASYNC_CANCEL
 pte_osResult PSP2CLDR_STUB pte_osThreadAsyncCancel(pte_osThreadHandle threadHandle, void (*handlerFunction)(unsigned int), unsigned int arg)
 {
@@ -258,11 +305,34 @@ int pte_osAtomicCompareExchange(int *pdest, int exchange, int comp)
         });
 }
 
+void *pte_osAtomicCompareExchangePtr(void * volatile *pdest, void *exchange, void *comp)
+{
+    return __sync_val_compare_and_swap(pdest, comp, exchange);
+}
+
+pte_osAtomicPair pte_osAtomicCompareExchangePair(pte_osAtomicPair volatile *pdest,
+                                                 pte_osAtomicPair exchange,
+                                                 pte_osAtomicPair comp)
+{
+    union { pte_osAtomicPair pair; unsigned long long bits; } e, c;
+
+    e.pair = exchange;
+    c.pair = comp;
+    c.bits = __sync_val_compare_and_swap((unsigned long long volatile *) pdest,
+                                         c.bits, e.bits);
+    return c.pair;
+}
+
 int pte_osAtomicExchangeAdd(int volatile *pAddend, int value)
 {
     return atomic_fetch_add(pAddend, value);
 }
 
+long long pte_osAtomicExchangeAdd64(long long volatile *pAddend, long long value)
+{
+    return __sync_fetch_and_add(pAddend, value);
+}
+
 int pte_osAtomicDecrement(int *pdest)
 {
     return __sync_sub_and_fetch(pdest, 1);
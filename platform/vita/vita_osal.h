@@ -43,6 +43,9 @@ typedef int pte_osMutexHandle;
 
 #define HAVE_THREAD_SAFE_ERRNO
 
+/* ARMv7 has ldrex/strex, so the library may inline its atomics. */
+#define OS_HAVE_INLINE_ATOMICS
+
 #define POLLING_DELAY_IN_us 100
 
 #define OS_MAX_SEM_VALUE 254
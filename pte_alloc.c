@@ -0,0 +1,163 @@
+/*
+ * pte_alloc.c
+ *
+ * Description:
+ * This translation unit implements the allocation wrappers used for
+ * all of the library's memory (see pte_set_allocator_np).
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <pte_osal.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+
+/*
+ * A block that does not come from a slab cache starts with the
+ * allocator that supplied it (NULL for the C library heap), so that
+ * it goes back there even if another allocator has been installed
+ * since. The union keeps the object that follows aligned.
+ */
+typedef union
+  {
+    const pte_allocator_t * owner;
+    double align;
+    long long alignLong;
+  } pte_alloc_header_t;
+
+
+void *
+pte_alloc (int type, size_t size)
+/*
+ * Allocates 'size' bytes of zeroed memory from the type's slab cache,
+ * the installed allocator, or the C library heap, and counts it
+ * against 'type'.
+ */
+{
+  const pte_allocator_t * allocator = pte_allocator;
+  pte_alloc_counters_t * c = &pte_alloc_counters[type];
+  int cls = pte_slab_class (type, size);
+  void *ptr = NULL;
+
+  if (cls >= 0)
+    {
+      ptr = pte_slab_get (cls);
+    }
+  else
+    {
+      pte_alloc_header_t * header;
+
+      if (allocator != NULL)
+        {
+          header = (pte_alloc_header_t *)
+            (*allocator->alloc) (sizeof (*header) + size, type, allocator->arg);
+        }
+      else
+        {
+          header = (pte_alloc_header_t *) malloc (sizeof (*header) + size);
+        }
+
+      if (header != NULL)
+        {
+          header->owner = allocator;
+          ptr = (void *) (header + 1);
+        }
+    }
+
+  if (ptr != NULL)
+    {
+      memset (ptr, 0, size);
+    }
+
+  if (ptr == NULL)
+    {
+      (void) PTE_ATOMIC_INCREMENT (&c->failures);
+      return NULL;
+    }
+
+  (void) PTE_ATOMIC_INCREMENT (&c->allocs);
+  (void) PTE_ATOMIC_INCREMENT (&c->objects);
+  (void) PTE_ATOMIC_EXCHANGE_ADD (&c->bytes, (int) size);
+
+  return ptr;
+}
+
+
+void
+pte_free (int type, void *ptr, size_t size)
+/*
+ * Gives back memory from pte_alloc(). 'type' and 'size' must be
+ * those it was allocated with. NULL is ignored.
+ */
+{
+  pte_alloc_counters_t * c = &pte_alloc_counters[type];
+  int cls;
+
+  if (ptr == NULL)
+    {
+      return;
+    }
+
+  (void) PTE_ATOMIC_DECREMENT (&c->objects);
+  (void) PTE_ATOMIC_EXCHANGE_ADD (&c->bytes, - (int) size);
+
+  cls = pte_slab_class (type, size);
+
+  if (cls >= 0)
+    {
+      pte_slab_put (cls, ptr);
+    }
+  else
+    {
+      pte_alloc_header_t * header = (pte_alloc_header_t *) ptr - 1;
+      const pte_allocator_t * owner = header->owner;
+
+      if (owner != NULL)
+        {
+          (*owner->free) ((void *) header, sizeof (*header) + size,
+                          type, owner->arg);
+        }
+      else
+        {
+          free ((void *) header);
+        }
+    }
+}
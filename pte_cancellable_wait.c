@@ -47,7 +47,8 @@
 #include "implement.h"
 
 
-int pte_cancellable_wait (pte_osSemaphoreHandle semHandle, unsigned int* timeout)
+int pte_cancellable_wait (pte_osSemaphoreHandle semHandle, unsigned int* timeout,
+                          const void *traceObject)
 {
   int result = EINVAL;
   pte_osResult osResult;
@@ -70,13 +71,27 @@ int pte_cancellable_wait (pte_osSemaphoreHandle semHandle, unsigned int* timeout
     }
 
 
-  if (cancelEnabled)
+  if (sp != NULL && PTE_ATOMIC_LOAD_RELAXED (&sp->cancelPending))
     {
-      osResult = pte_osSemaphoreCancellablePend(semHandle, timeout);
+      /*
+       * Already cancelled: act on it without going to the OS.
+       */
+      osResult = PTE_OS_INTERRUPTED;
     }
   else
     {
-      osResult = pte_osSemaphorePend(semHandle, timeout);
+      PTE_TRACE (PTE_TRACE_BLOCK, traceObject);
+
+      if (cancelEnabled)
+        {
+          osResult = pte_osSemaphoreCancellablePend(semHandle, timeout);
+        }
+      else
+        {
+          osResult = pte_osSemaphorePend(semHandle, timeout);
+        }
+
+      PTE_TRACE (PTE_TRACE_WAKE, traceObject);
     }
 
   switch (osResult)
@@ -106,6 +121,7 @@ int pte_cancellable_wait (pte_osSemaphoreHandle semHandle, unsigned int* timeout
             {
               sp->state = PThreadStateCanceling;
               sp->cancelState = PTHREAD_CANCEL_DISABLE;
+              PTE_CANCEL_PUBLISH (sp);
               (void) pthread_mutex_unlock (&sp->cancelLock);
               pte_throw (PTE_EPS_CANCEL);
 
@@ -48,56 +48,63 @@
 int
 pte_cond_check_need_init (pthread_cond_t * cond)
 {
-  int result = 0;
+  int result;
+  pthread_cond_t cv;
 
   /*
-   * The following guarded test is specifically for statically
-   * initialised condition variables (via PTHREAD_OBJECT_INITIALIZER).
+   * The following test is specifically for statically
+   * initialised condition variables (via PTHREAD_COND_INITIALIZER).
    *
-   * Note that by not providing this synchronisation we risk
-   * introducing race conditions into applications which are
-   * correctly written.
+   * The condition variable is built privately and installed with
+   * a single compare-and-exchange; see pte_mutex_check_need_init().
    *
-   * Approach
-   * --------
-   * We know that static condition variables will not be PROCESS_SHARED
-   * so we can serialise access to internal state using
-   * Win32 Critical Sections rather than Win32 Mutexes.
-   *
-   * If using a single global lock slows applications down too much,
-   * multiple global locks could be created and hashed on some random
-   * value associated with each mutex, the pointer perhaps. At a guess,
-   * a good value for the optimal number of global locks might be
-   * the number of processors + 1.
-   *
-   */
-
-
-  pte_osMutexLock (pte_cond_test_init_lock);
-
-  /*
-   * We got here possibly under race
-   * conditions. Check again inside the critical section.
    * If a static cv has been destroyed, the application can
    * re-initialise it only by calling pthread_cond_init()
    * explicitly.
    */
-  if (*cond == PTHREAD_COND_INITIALIZER)
+  if (*cond == NULL)
     {
-      result = pthread_cond_init (cond, NULL);
+      /*
+       * The cv has been destroyed, so the operation that caused
+       * the auto-initialisation should fail.
+       */
+      return EINVAL;
     }
-  else if (*cond == NULL)
+
+  if (*cond != PTHREAD_COND_INITIALIZER)
     {
       /*
-       * The cv has been destroyed while we were waiting to
-       * initialise it, so the operation that caused the
-       * auto-initialisation should fail.
+       * Another thread has initialised it.
        */
-      result = EINVAL;
+      return 0;
     }
 
+  if ((result = pthread_cond_init (&cv, NULL)) != 0)
+    {
+      return result;
+    }
+
+#ifdef PTE_SYNC_REGISTRY
+  if (cv->syncEntry != NULL)
+    {
+      cv->syncEntry->tag = "PTHREAD_COND_INITIALIZER";
+    }
+#endif
 
-  pte_osMutexUnlock(pte_cond_test_init_lock);
+  if (PTE_ATOMIC_COMPARE_EXCHANGE_PTR ((void * volatile *) cond, (void *) cv,
+                                       (void *) PTHREAD_COND_INITIALIZER)
+      != (void *) PTHREAD_COND_INITIALIZER)
+    {
+      /*
+       * Lost the race, or the cv was destroyed meanwhile.
+       */
+      (void) pthread_cond_destroy (&cv);
+
+      if (*cond == NULL)
+        {
+          result = EINVAL;
+        }
+    }
 
   return result;
 }
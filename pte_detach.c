@@ -59,9 +59,19 @@ pte_thread_detach_common (unsigned char threadShouldExit)
 
           pte_callUserDestroyRoutines (sp->ptHandle);
 
+          pte_slab_thread_exit ();
+
           (void) pthread_mutex_lock (&sp->cancelLock);
           sp->state = PThreadStateLast;
 
+          if (sp->joinAnyWaiter != NULL)
+            {
+              pte_join_any_t * waiter = (pte_join_any_t *) sp->joinAnyWaiter;
+
+              (void) PTE_ATOMIC_COMPARE_EXCHANGE_PTR (&waiter->winner, sp, NULL);
+              (void) pte_osSemaphorePost (waiter->sem, 1);
+            }
+
           /*
            * If the thread is joinable at this point then it MUST be joined
            * or detached explicitly by the application.
@@ -83,6 +93,12 @@ pte_thread_detach_common (unsigned char threadShouldExit)
             }
           else
             {
+              /*
+               * Wake the joiner. The detach state can no longer
+               * change now that the state is PThreadStateLast.
+               */
+              (void) pte_osSemaphorePost (sp->exitSem, 1);
+
               if (threadShouldExit)
                 {
                   pte_osThreadExit();
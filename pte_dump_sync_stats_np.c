@@ -0,0 +1,155 @@
+/*
+ * pte_dump_sync_stats_np.c
+ *
+ * Description:
+ * This translation unit implements the sync statistics report.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdio.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+#ifdef PTE_SYNC_REGISTRY
+
+static const char *pte_sync_type_names[] =
+  {
+    "mutex", "rwlock", "cond", "sem", "spin", "barrier"
+  };
+
+#endif
+
+
+int
+pte_dump_sync_stats_np (FILE * stream)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function prints the wait statistics of every
+ *      registered sync object that threads have blocked on.
+ *
+ * PARAMETERS
+ *      stream
+ *              stdio stream to print to
+ *
+ *
+ * DESCRIPTION
+ *      Prints one line per object giving its type, handle,
+ *      number of waits, longest wait in microseconds and
+ *      tag, followed by a histogram of its wait times. Each
+ *      histogram bucket is printed as "N+:count", counting
+ *      waits of at least N and under 2N microseconds.
+ *
+ *      Objects the library creates inside other objects, such
+ *      as the mutexes of a rwlock, are not listed; their waits
+ *      are counted against the containing object.
+ *
+ *      The statistics are read without locking, so objects
+ *      that are being waited on may show slightly inconsistent
+ *      counts.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully printed,
+ *              EINVAL          'stream' is NULL,
+ *              ENOTSUP         library built without PTE_SYNC_REGISTRY.
+ *
+ * ------------------------------------------------------
+ */
+{
+#ifdef PTE_SYNC_REGISTRY
+  int live = 0;
+  int i;
+  int b;
+
+  if (stream == NULL)
+    {
+      return EINVAL;
+    }
+
+  fprintf (stream, "%-8s %-18s %8s %10s  %s\n",
+           "type", "object", "waits", "max(us)", "tag");
+
+  for (i = 0; i < PTE_SYNC_REGISTRY_SIZE; i++)
+    {
+      pte_sync_entry_t * entry = &pte_sync_registry[i];
+      const char *tag = entry->tag;
+
+      if (entry->state != PTE_SYNC_LIVE)
+        {
+          continue;
+        }
+
+      live++;
+
+      if (entry->waits == 0)
+        {
+          continue;
+        }
+
+      fprintf (stream, "%-8s %-18p %8d %10d  %s\n",
+               pte_sync_type_names[entry->type], entry->object,
+               entry->waits, entry->waitMax,
+               (tag != NULL ? tag : "-"));
+
+      fprintf (stream, "        ");
+
+      for (b = 0; b < PTE_SYNC_HIST_BUCKETS; b++)
+        {
+          if (entry->hist[b] != 0)
+            {
+              fprintf (stream, " %u+:%d",
+                       (b == 0 ? 0 : 1u << b), entry->hist[b]);
+            }
+        }
+
+      fprintf (stream, "\n");
+    }
+
+  fprintf (stream, "%d objects registered, %d not registered (registry full)\n",
+           live, pte_sync_registry_dropped);
+
+  fflush (stream);
+
+  return 0;
+#else
+  return ENOTSUP;
+#endif
+}
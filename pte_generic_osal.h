@@ -64,6 +64,24 @@ typedef enum pte_osResult
  * called before any other OSAL function.
  */
 pte_osResult pte_osInit(void);
+
+/**
+ * Allocates memory for a thread stack, for use with pte_osThreadCreateWithStack().
+ *
+ * @param stackSize Usable size of the stack, in bytes.
+ * @param guardSize Size of an inaccessible guard region to place below the stack.  The OSAL may
+ *                  round this up to its page size, or ignore it if it cannot protect memory.
+ * @param pStackAddr Set to the lowest usable address of the stack.
+ *
+ * @return PTE_OS_OK - Stack successfully allocated.
+ * @return PTE_OS_NO_RESOURCES - Insufficient memory.
+ */
+pte_osResult pte_osStackAlloc(unsigned int stackSize, unsigned int guardSize, void **pStackAddr);
+
+/**
+ * Frees a stack allocated by pte_osStackAlloc().  The sizes are those passed when it was allocated.
+ */
+void pte_osStackFree(void *stackAddr, unsigned int stackSize, unsigned int guardSize);
 //@}
 
 /** @name Mutexes */
@@ -144,6 +162,30 @@ pte_osResult pte_osThreadCreate(pte_osThreadEntryPoint entryPoint,
                                 void *argv,
                                 pte_osThreadHandle* ppte_osThreadHandle);
 
+/**
+ * Creates a new thread that runs on a stack supplied by the caller.  As with
+ * pte_osThreadCreate() the thread must be created suspended.  The OS must not free the stack;
+ * the caller releases it after pte_osThreadDelete() has returned.
+ *
+ * @param entryPoint Entry point to the new thread.
+ * @param stackAddr Lowest address of the stack.
+ * @param stackSize Size of the stack, in bytes.  Unlike pte_osThreadCreate() this is exact.
+ * @param initialPriority The priority that the new thread should be initially set to.
+ * @param argv Parameter to pass to the new thread.
+ * @param ppte_osThreadHandle set to the handle of the new thread.
+ *
+ * @return PTE_OS_OK - New thread successfully created.
+ * @return PTE_OS_NO_RESOURCES - Insufficient resources to create thread
+ * @return PTE_OS_INVALID_PARAM - The stack is too small or misaligned for the OS
+ * @return PTE_OS_GENERAL_FAILURE - The OS cannot run threads on caller supplied stacks, ENOTSUP will be returned
+ */
+pte_osResult pte_osThreadCreateWithStack(pte_osThreadEntryPoint entryPoint,
+                                         void *stackAddr,
+                                         int stackSize,
+                                         int initialPriority,
+                                         void *argv,
+                                         pte_osThreadHandle* ppte_osThreadHandle);
+
 /**
  * Starts executing the specified thread.
  *
@@ -187,6 +229,31 @@ int pte_osThreadGetPriority(pte_osThreadHandle threadHandle);
  */
 pte_osResult pte_osThreadSetPriority(pte_osThreadHandle threadHandle, int newPriority);
 
+/**
+ * Sets the scheduling policy of the specified thread.  May be called on a thread that
+ * has been created but not yet started.
+ *
+ * @param threadHandle handle of the thread.
+ * @param policy SCHED_OTHER, SCHED_FIFO or SCHED_RR.
+ *
+ * @return PTE_OS_OK - policy successfully set
+ * @return PTE_OS_GENERAL_FAILURE - the OS scheduler has no equivalent policy, ENOTSUP will be returned
+ */
+pte_osResult pte_osThreadSetSchedPolicy(pte_osThreadHandle threadHandle, int policy);
+
+/**
+ * Restricts the specified thread to run only on the processors selected by a CPU mask.
+ * May be called on a thread that has been created but not yet started.
+ *
+ * @param threadHandle handle of the thread to pin.
+ * @param cpuMask bit n set allows the thread to run on processor n.  Never zero.
+ *
+ * @return PTE_OS_OK - thread affinity successfully set
+ * @return PTE_OS_INVALID_PARAM - the mask selects no processor available to the thread
+ * @return PTE_OS_GENERAL_FAILURE - operation not supported, ENOTSUP will be returned
+ */
+pte_osResult pte_osThreadSetAffinity(pte_osThreadHandle threadHandle, unsigned int cpuMask);
+
 /**
  * Frees resources associated with the specified thread.  This is called after the thread has terminated
  * and is no longer needed (e.g. after pthread_join returns).  This call will always be made
@@ -242,6 +309,16 @@ int pte_osThreadGetMinPriority();
  */
 int pte_osThreadGetDefaultPriority();
 
+/**
+ * Compares two priorities by urgency.  The min and max priorities only bound
+ * the range: on some OSes (e.g. PSP and Vita) the lower number is the more
+ * urgent, on others it is the less urgent.
+ *
+ * @return A positive value if priority1 is more urgent than priority2,
+ *         a negative value if it is less urgent, or zero if they are equal.
+ */
+int pte_osThreadComparePriority(int priority1, int priority2);
+
 #ifdef PTE_SUPPORT_ASYNC_CANCEL
 /**
  * Asynchronously cancel the specified thread.
@@ -373,7 +450,13 @@ pte_osResult pte_osTlsAlloc(unsigned int *pKey);
 pte_osResult pte_osTlsFree(unsigned int key);
 //@}
 
-/** @name Atomic operations */
+/** @name Atomic operations
+ *
+ * All of these are full memory barriers.  If the platform header
+ * defines OS_HAVE_INLINE_ATOMICS and the compiler has the GCC
+ * __atomic builtins, the library inlines its atomics with the
+ * ordering each use needs instead of calling these.
+ */
 //@{
 
 /**
@@ -411,6 +494,52 @@ int pte_osAtomicExchange(int *pTarg, int val);
  */
 int pte_osAtomicCompareExchange(int *pdest, int exchange, int comp);
 
+/**
+ * Performs an atomic compare-and-exchange operation on a pointer, as
+ * pte_osAtomicCompareExchange() does on an int.  Used to install
+ * objects built privately, such as statically initialised mutexes on
+ * first use.
+ *
+ * @param pdest Pointer to the destination pointer.
+ * @param exchange Exchange value (value to set destination to if destination == comparand)
+ * @param comp The value to compare to destination.
+ *
+ * @return Original value of destination
+ */
+void *pte_osAtomicCompareExchangePtr(void * volatile *pdest, void *exchange, void *comp);
+
+/**
+ * A pointer and a tag of the same width, compared and exchanged
+ * together by pte_osAtomicCompareExchangePair().  Bumping the tag on
+ * every update lets lock-free lists tell a pointer that was popped
+ * and pushed back apart from one that never changed (the ABA
+ * problem).  Aligned to its own size, as double-word CAS
+ * instructions require.
+ */
+typedef struct pte_osAtomicPair
+{
+  void *ptr;
+  unsigned long tag;
+}
+#ifdef __GNUC__
+__attribute__ ((aligned (2 * sizeof (void *))))
+#endif
+pte_osAtomicPair;
+
+/**
+ * Performs an atomic compare-and-exchange operation on a pointer and
+ * tag pair.  The exchange only happens if both halves match.
+ *
+ * @param pdest Pointer to the destination pair.
+ * @param exchange Exchange value (value to set destination to if destination == comparand)
+ * @param comp The value to compare to destination.
+ *
+ * @return Original value of destination
+ */
+pte_osAtomicPair pte_osAtomicCompareExchangePair(pte_osAtomicPair volatile *pdest,
+                                                 pte_osAtomicPair exchange,
+                                                 pte_osAtomicPair comp);
+
 /**
  * Adds the value to target as an atomic operation
  *
@@ -427,6 +556,18 @@ int pte_osAtomicCompareExchange(int *pdest, int exchange, int comp);
  */
 int  pte_osAtomicExchangeAdd(int volatile* pdest, int value);
 
+/**
+ * Adds the value to a 64-bit target as an atomic operation, as
+ * pte_osAtomicExchangeAdd() does on an int.  Adding 0 reads the
+ * target atomically, which a plain load does not on 32-bit cpus.
+ *
+ * @param pdest Pointer to the variable to be updated.
+ * @param value Value to be added to the variable.
+ *
+ * @return Original value of destination
+ */
+long long pte_osAtomicExchangeAdd64(long long volatile *pdest, long long value);
+
 /**
  * Decrements the destination.
  *
@@ -453,6 +594,20 @@ int pte_osAtomicDecrement(int *pdest);
 int pte_osAtomicIncrement(int *pdest);
 //@}
 
+/** @name Time */
+//@{
+
+/**
+ * Returns the time elapsed since an arbitrary fixed point (e.g. boot), in
+ * microseconds.  The value must never go backwards, so it should not follow
+ * changes to the wall clock.  Used for timing measurements such as mutex
+ * contention statistics, not for timeouts.
+ *
+ * @return Current monotonic time in microseconds.
+ */
+unsigned long long pte_osClockGetMicros(void);
+//@}
+
 struct timeb;
 
 int ftime(struct timeb *tb);
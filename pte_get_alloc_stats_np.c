@@ -0,0 +1,95 @@
+/*
+ * pte_get_alloc_stats_np.c
+ *
+ * Description:
+ * This translation unit implements reading the library's allocation
+ * counters.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_get_alloc_stats_np (int type, pte_alloc_stats_t * stats)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function reads the counters kept for one type of
+ *      library allocation.
+ *
+ * PARAMETERS
+ *      type
+ *              one of the PTE_ALLOC_* types
+ *
+ *      stats
+ *              where to store the counters
+ *
+ *
+ * DESCRIPTION
+ *      Gives the number of objects and bytes of the type that
+ *      are currently allocated, the number of allocations made
+ *      and the number that failed. The counters are kept
+ *      whichever allocator is installed.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully read,
+ *              EINVAL          'type' is not valid or 'stats' is NULL.
+ *
+ * ------------------------------------------------------
+ */
+{
+  pte_alloc_counters_t * c;
+
+  if (type < 0 || type >= PTE_ALLOC_TYPES || stats == NULL)
+    {
+      return EINVAL;
+    }
+
+  c = &pte_alloc_counters[type];
+
+  stats->objects = (unsigned long) c->objects;
+  stats->bytes = (unsigned long) c->bytes;
+  stats->allocs = (unsigned long) c->allocs;
+  stats->failures = (unsigned long) c->failures;
+
+  return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * pte_join.c
+ *
+ * Description:
+ * This translation unit implements the wait shared by pthread_join(),
+ * pthread_tryjoin_np() and pthread_timedjoin_np().
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pte_osal.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_join (pthread_t thread, void **value_ptr, unsigned int *timeout)
+/*
+ * Joins 'thread' as pthread_join() does, waiting at most *timeout
+ * milliseconds for it to finish, or forever if 'timeout' is NULL.
+ * A zero timeout only polls and is not a cancellation point.
+ * Returns ETIMEDOUT if the thread is still running.
+ */
+{
+  int result;
+  pthread_t self;
+  pte_thread_t * tp = (pte_thread_t *) thread;
+
+
+  if (NULL == tp)
+    {
+      return ESRCH;
+    }
+
+  /*
+   * The detach state only changes under cancelLock, and a joinable
+   * thread's struct is not freed until it is joined or detached, so
+   * no global lock is needed to check it.
+   */
+  if (PTHREAD_CREATE_DETACHED == PTE_ATOMIC_LOAD_ACQUIRE (&tp->detachState)
+      || !tp->exitSemValid)
+    {
+      return EINVAL;
+    }
+
+  self = pthread_self();
+
+  if (0 == self)
+    {
+      return ENOENT;
+    }
+
+  if (pthread_equal (self, thread))
+    {
+      return EDEADLK;
+    }
+
+  if (timeout != NULL && *timeout == 0)
+    {
+      /*
+       * The exit semaphore is posted after the state is set, so the
+       * state alone tells us whether the thread has finished.
+       */
+      (void) pthread_mutex_lock (&tp->cancelLock);
+      result = (tp->state == PThreadStateLast) ? 0 : ETIMEDOUT;
+      (void) pthread_mutex_unlock (&tp->cancelLock);
+    }
+  else
+    {
+      /*
+       * Pthread_join is a cancelation point.
+       * If we are canceled then our target thread must not be
+       * detached (destroyed), so we return without joining it.
+       */
+      pte_osResult osResult;
+
+      osResult = pte_osSemaphoreCancellablePend (tp->exitSem, timeout);
+
+      if (PTE_OS_OK == osResult)
+        {
+          result = 0;
+        }
+      else if (PTE_OS_TIMEOUT == osResult)
+        {
+          result = ETIMEDOUT;
+        }
+      else if (PTE_OS_INTERRUPTED == osResult)
+        {
+          /* Call was cancelled, but still return success (per spec) */
+          return 0;
+        }
+      else
+        {
+          result = ESRCH;
+        }
+    }
+
+  if (result == 0)
+    {
+      if (value_ptr != NULL)
+        {
+          *value_ptr = tp->exitStatus;
+        }
+
+      /*
+       * The result of making multiple simultaneous calls to
+       * pthread_join() or pthread_detach() specifying the same
+       * target is undefined.
+       *
+       * pthread_detach() still waits for the OS thread to end
+       * before destroying it, but that is only the last few
+       * instructions of the exit path.
+       */
+      result = pthread_detach (thread);
+    }
+
+  return (result);
+
+}				/* pte_join */
@@ -0,0 +1,84 @@
+/*
+ * pte_lock_init_np.c
+ *
+ * Description:
+ * This translation unit implements initialising inline locks.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_lock_init_np (pte_lock_t * lock)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function initialises an inline lock to the
+ *      unlocked state.
+ *
+ * PARAMETERS
+ *      lock
+ *              pointer to the lock
+ *
+ *
+ * DESCRIPTION
+ *      This is the same as assigning PTE_LOCK_INITIALIZER.
+ *      An inline lock holds no resources, so there is no
+ *      destroy function: an unlocked lock may simply be
+ *      reused or freed with the storage it is in.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully initialised,
+ *              EINVAL          'lock' is NULL.
+ *
+ * ------------------------------------------------------
+ */
+{
+  if (lock == NULL)
+    {
+      return EINVAL;
+    }
+
+  lock->state = PTE_LOCK_FREE;
+
+  return 0;
+}
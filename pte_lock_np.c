@@ -0,0 +1,125 @@
+/*
+ * pte_lock_np.c
+ *
+ * Description:
+ * This translation unit implements locking inline locks.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_lock_np (pte_lock_t * lock)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function locks an inline lock, blocking until
+ *      it is available.
+ *
+ * PARAMETERS
+ *      lock
+ *              pointer to the lock
+ *
+ *
+ * DESCRIPTION
+ *      An uncontended lock is taken with a single atomic
+ *      compare-and-exchange on the lock word, with no other
+ *      memory touched. Otherwise the caller spins briefly,
+ *      then marks the lock contended and parks until an
+ *      unlock wakes it.
+ *
+ *      The lock is not recursive and has no owner: locking
+ *      it again from the thread holding it deadlocks. This
+ *      function is not a cancellation point.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully locked,
+ *              EINVAL          'lock' is NULL.
+ *
+ * ------------------------------------------------------
+ */
+{
+  int c;
+  int spins;
+
+  if (lock == NULL)
+    {
+      return EINVAL;
+    }
+
+  c = PTE_ATOMIC_COMPARE_EXCHANGE_ACQUIRE (&lock->state,
+                                           PTE_LOCK_HELD, PTE_LOCK_FREE);
+
+  if (c == PTE_LOCK_FREE)
+    {
+      return 0;
+    }
+
+  for (spins = 0; spins < PTE_LOCK_SPINS && c == PTE_LOCK_HELD; spins++)
+    {
+      if (PTE_ATOMIC_LOAD_RELAXED (&lock->state) == PTE_LOCK_FREE)
+        {
+          c = PTE_ATOMIC_COMPARE_EXCHANGE_ACQUIRE (&lock->state,
+                                                   PTE_LOCK_HELD, PTE_LOCK_FREE);
+          if (c == PTE_LOCK_FREE)
+            {
+              return 0;
+            }
+        }
+    }
+
+  /*
+   * From here on the lock is taken as contended, since other
+   * threads may have parked while it was held.
+   */
+  PTE_TRACE (PTE_TRACE_BLOCK, lock);
+
+  while (PTE_ATOMIC_EXCHANGE_ACQUIRE (&lock->state, PTE_LOCK_CONTENDED)
+         != PTE_LOCK_FREE)
+    {
+      pte_park (&lock->state, PTE_LOCK_CONTENDED);
+    }
+
+  PTE_TRACE (PTE_TRACE_WAKE, lock);
+
+  return 0;
+}
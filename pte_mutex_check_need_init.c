@@ -60,38 +60,22 @@ static pthread_mutexattr_t pte_errorcheck_mutexattr = &pte_errorcheck_mutexattr_
 int
 pte_mutex_check_need_init (pthread_mutex_t * mutex)
 {
-  register int result = 0;
-  register pthread_mutex_t mtx;
+  int result;
+  pthread_mutex_t mtx;
+  pthread_mutex_t mx;
+  const pthread_mutexattr_t * attr;
 
   /*
-   * The following guarded test is specifically for statically
+   * The following test is specifically for statically
    * initialised mutexes (via PTHREAD_MUTEX_INITIALIZER).
    *
-   * Note that by not providing this synchronisation we risk
-   * introducing race conditions into applications which are
-   * correctly written.
-   *
    * Approach
    * --------
-   * We know that static mutexes will not be PROCESS_SHARED
-   * so we can serialise access to internal state using
-   * critical sections rather than mutexes.
-   *
-   * If using a single global lock slows applications down too much,
-   * multiple global locks could be created and hashed on some random
-   * value associated with each mutex, the pointer perhaps. At a guess,
-   * a good value for the optimal number of global locks might be
-   * the number of processors + 1.
+   * The mutex is built privately and installed with a single
+   * compare-and-exchange, so threads touching a static mutex for
+   * the first time never wait on each other. If several race,
+   * one installs its mutex and the others destroy theirs.
    *
-   */
-
-
-  pte_osMutexLock (pte_mutex_test_init_lock);
-
-  /*
-   * We got here possibly under race
-   * conditions. Check again inside the critical section
-   * and only initialise if the mutex is valid (not been destroyed).
    * If a static mutex has been destroyed, the application can
    * re-initialise it only by calling pthread_mutex_init()
    * explicitly.
@@ -100,30 +84,61 @@ pte_mutex_check_need_init (pthread_mutex_t * mutex)
 
   if (mtx == PTHREAD_MUTEX_INITIALIZER)
     {
-      result = pthread_mutex_init (mutex, NULL);
+      attr = NULL;
     }
   else if (mtx == PTHREAD_RECURSIVE_MUTEX_INITIALIZER)
     {
-      result = pthread_mutex_init (mutex, &pte_recursive_mutexattr);
+      attr = &pte_recursive_mutexattr;
     }
   else if (mtx == PTHREAD_ERRORCHECK_MUTEX_INITIALIZER)
     {
-      result = pthread_mutex_init (mutex, &pte_errorcheck_mutexattr);
+      attr = &pte_errorcheck_mutexattr;
     }
   else if (mtx == NULL)
     {
       /*
-       * The mutex has been destroyed while we were waiting to
-       * initialise it, so the operation that caused the
-       * auto-initialisation should fail.
+       * The mutex has been destroyed, so the operation that
+       * caused the auto-initialisation should fail.
+       */
+      return EINVAL;
+    }
+  else
+    {
+      /*
+       * Another thread has initialised it.
        */
-      result = EINVAL;
+      return 0;
     }
 
-  pte_osMutexUnlock(pte_mutex_test_init_lock);
+  if ((result = pthread_mutex_init (&mx, attr)) != 0)
+    {
+      return result;
+    }
 
-  return (result);
-}
+#ifdef PTE_SYNC_REGISTRY
+  if (mx->syncEntry != NULL)
+    {
+      mx->syncEntry->tag =
+        (mtx == PTHREAD_MUTEX_INITIALIZER ? "PTHREAD_MUTEX_INITIALIZER"
+         : mtx == PTHREAD_RECURSIVE_MUTEX_INITIALIZER
+         ? "PTHREAD_RECURSIVE_MUTEX_INITIALIZER"
+         : "PTHREAD_ERRORCHECK_MUTEX_INITIALIZER");
+    }
+#endif
 
+  if (PTE_ATOMIC_COMPARE_EXCHANGE_PTR ((void * volatile *) mutex, (void *) mx,
+                                       (void *) mtx) != (void *) mtx)
+    {
+      /*
+       * Lost the race, or the mutex was destroyed meanwhile.
+       */
+      (void) pthread_mutex_destroy (&mx);
 
+      if (*mutex == NULL)
+        {
+          result = EINVAL;
+        }
+    }
 
+  return (result);
+}
@@ -0,0 +1,412 @@
+/*
+ * pte_mutex_prio.c
+ *
+ * Description:
+ * This translation unit implements the priority inheritance and priority
+ * ceiling protocols for mutexes.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+/*
+ * Bound on the length of a chain of PTHREAD_PRIO_INHERIT mutexes
+ * (owner blocked on a mutex whose owner is blocked on ...) that is
+ * followed when propagating a boost. Guards against cycles formed
+ * by deadlocked applications.
+ */
+#define PTE_PRIO_CHAIN_MAX 16
+
+
+/*
+ * Priorities are OS numbers, and whether a larger number is more
+ * urgent is up to the OS, so they are only ever ordered with
+ * pte_osThreadComparePriority().
+ */
+#define PTE_PRIO_ABOVE(p1, p2) (pte_osThreadComparePriority ((p1), (p2)) > 0)
+
+
+int
+pte_prio_lowest (void)
+{
+  int min = pte_osThreadGetMinPriority ();
+  int max = pte_osThreadGetMaxPriority ();
+
+  return PTE_PRIO_ABOVE (max, min) ? min : max;
+}
+
+
+int
+pte_prio_highest (void)
+{
+  int min = pte_osThreadGetMinPriority ();
+  int max = pte_osThreadGetMaxPriority ();
+
+  return PTE_PRIO_ABOVE (max, min) ? max : min;
+}
+
+
+/*
+ * The more urgent of a thread's base priority and the boosts owed
+ * by the mutexes it owns. Called with pte_mutex_prio_lock held.
+ */
+static int
+pte_prio_wanted (pte_thread_t * tp)
+{
+  int prio = tp->sched_priority;
+  pthread_mutex_t mx;
+
+  for (mx = tp->prioMutexes; mx != NULL; mx = mx->prioNext)
+    {
+      if (PTE_PRIO_ABOVE (mx->prioBoost, prio))
+        {
+          prio = mx->prioBoost;
+        }
+    }
+
+  return prio;
+}
+
+
+/*
+ * Apply pte_prio_wanted() to a thread. Called with
+ * pte_mutex_prio_lock held.
+ */
+static void
+pte_prio_recompute (pte_thread_t * tp)
+{
+  int prio = pte_prio_wanted (tp);
+
+  if (prio != tp->prioEffective)
+    {
+      if (pte_osThreadSetPriority (tp->threadId, prio) == PTE_OS_OK)
+        {
+          tp->prioEffective = prio;
+        }
+    }
+}
+
+
+/*
+ * Recompute what a PTHREAD_PRIO_INHERIT mutex owes its owner from
+ * the threads still blocked on it. Called with pte_mutex_prio_lock
+ * held.
+ */
+static void
+pte_prio_reboost (pthread_mutex_t mx)
+{
+  pte_thread_t * wp;
+  int prio = pte_prio_lowest ();
+
+  for (wp = mx->prioWaiters; wp != NULL; wp = wp->prioWaitNext)
+    {
+      if (PTE_PRIO_ABOVE (wp->prioEffective, prio))
+        {
+          prio = wp->prioEffective;
+        }
+    }
+
+  mx->prioBoost = prio;
+}
+
+
+/*
+ * Take a thread off the waiters of the mutex it is blocked on.
+ * Called with pte_mutex_prio_lock held.
+ */
+static void
+pte_prio_unblock (pte_thread_t * sp)
+{
+  pthread_mutex_t mx = sp->prioBlockedOn;
+  pte_thread_t ** link;
+
+  for (link = &mx->prioWaiters; *link != NULL; link = &(*link)->prioWaitNext)
+    {
+      if (*link == sp)
+        {
+          *link = sp->prioWaitNext;
+          break;
+        }
+    }
+
+  sp->prioWaitNext = NULL;
+  sp->prioBlockedOn = NULL;
+
+  pte_prio_reboost (mx);
+}
+
+
+int
+pte_mutex_prio_check (pthread_mutex_t mx)
+{
+  /*
+   * A thread whose priority is above the ceiling of a
+   * PTHREAD_PRIO_PROTECT mutex may not lock it.
+   */
+  if (mx->protocol == PTHREAD_PRIO_PROTECT)
+    {
+      pte_thread_t * sp = (pte_thread_t *) pthread_self ();
+
+      if (PTE_PRIO_ABOVE (sp->sched_priority, mx->prioceiling))
+        {
+          return EINVAL;
+        }
+    }
+
+  return 0;
+}
+
+
+void
+pte_mutex_prio_wait (pthread_mutex_t mx)
+{
+  /*
+   * Called by a thread about to block on a PTHREAD_PRIO_INHERIT mutex.
+   * Lends the caller's priority to the owner, and on to whatever the
+   * owner is itself blocked on.
+   */
+  pte_thread_t * sp = (pte_thread_t *) pthread_self ();
+  pte_thread_t * owner;
+  int prio;
+  int depth;
+
+  pte_osMutexLock (pte_mutex_prio_lock);
+
+  /*
+   * A waiter woken by a release that lost the race for the mutex
+   * comes back here, and is still on the waiters.
+   */
+  if (sp->prioBlockedOn != mx)
+    {
+      sp->prioBlockedOn = mx;
+      sp->prioWaitNext = mx->prioWaiters;
+      mx->prioWaiters = sp;
+    }
+
+  prio = sp->prioEffective;
+
+  for (depth = 0; depth < PTE_PRIO_CHAIN_MAX; depth++)
+    {
+      if (!PTE_PRIO_ABOVE (prio, mx->prioBoost))
+        {
+          break;
+        }
+
+      mx->prioBoost = prio;
+
+      owner = (pte_thread_t *) mx->ownerThread;
+      if (owner == NULL)
+        {
+          break;
+        }
+
+      pte_prio_recompute (owner);
+
+      mx = owner->prioBlockedOn;
+      if (mx == NULL || mx->protocol != PTHREAD_PRIO_INHERIT)
+        {
+          break;
+        }
+    }
+
+  pte_osMutexUnlock (pte_mutex_prio_lock);
+}
+
+
+void
+pte_mutex_prio_abandon (pthread_mutex_t mx)
+{
+  /*
+   * Called by a thread that gave up waiting (e.g. timed out).
+   * Takes back the boost it lent the owner.
+   */
+  pte_thread_t * sp = (pte_thread_t *) pthread_self ();
+  pte_thread_t * owner;
+  int depth;
+
+  pte_osMutexLock (pte_mutex_prio_lock);
+
+  if (sp->prioBlockedOn == mx)
+    {
+      pte_prio_unblock (sp);
+
+      /*
+       * Lower the owner, and whatever it is blocked on in turn.
+       */
+      for (depth = 0; depth < PTE_PRIO_CHAIN_MAX; depth++)
+        {
+          owner = (pte_thread_t *) mx->ownerThread;
+          if (owner == NULL)
+            {
+              break;
+            }
+
+          pte_prio_recompute (owner);
+
+          mx = owner->prioBlockedOn;
+          if (mx == NULL || mx->protocol != PTHREAD_PRIO_INHERIT)
+            {
+              break;
+            }
+
+          pte_prio_reboost (mx);
+        }
+    }
+
+  pte_osMutexUnlock (pte_mutex_prio_lock);
+}
+
+
+void
+pte_mutex_prio_acquired (pthread_mutex_t mx)
+{
+  /*
+   * Called once the caller owns the mutex (not on recursive relocks).
+   * Records ownership and raises the caller to the ceiling or to the
+   * highest priority still waiting.
+   */
+  pte_thread_t * sp = (pte_thread_t *) pthread_self ();
+
+  pte_osMutexLock (pte_mutex_prio_lock);
+
+  /*
+   * The new owner is owed only what the threads still waiting lent.
+   */
+  if (sp->prioBlockedOn == mx)
+    {
+      pte_prio_unblock (sp);
+    }
+  else if (mx->protocol == PTHREAD_PRIO_INHERIT && mx->prioWaiters == NULL)
+    {
+      mx->prioBoost = pte_prio_lowest ();
+    }
+
+  mx->ownerThread = sp->ptHandle;
+  mx->prioNext = sp->prioMutexes;
+  sp->prioMutexes = mx;
+
+  pte_prio_recompute (sp);
+
+  pte_osMutexUnlock (pte_mutex_prio_lock);
+}
+
+
+void
+pte_mutex_prio_release (pthread_mutex_t mx)
+{
+  /*
+   * Called by the owner immediately before it releases the mutex.
+   * The caller's priority is not lowered here: that is done by
+   * pte_thread_prio_update() after the mutex has been handed on,
+   * so that the owner cannot be preempted before waking a waiter.
+   */
+  pte_thread_t * sp = (pte_thread_t *) pthread_self ();
+  pthread_mutex_t * link;
+
+  pte_osMutexLock (pte_mutex_prio_lock);
+
+  for (link = &sp->prioMutexes; *link != NULL; link = &(*link)->prioNext)
+    {
+      if (*link == mx)
+        {
+          *link = mx->prioNext;
+          break;
+        }
+    }
+
+  mx->prioNext = NULL;
+  mx->ownerThread = NULL;
+
+  /*
+   * Whatever boost the mutex carries is owed by the threads still
+   * blocked on it, and goes to whichever of them gets it next.
+   */
+
+  pte_osMutexUnlock (pte_mutex_prio_lock);
+}
+
+
+void
+pte_thread_prio_update (pte_thread_t * tp)
+{
+  int prio;
+  int prev;
+
+  pte_osMutexLock (pte_mutex_prio_lock);
+
+  prio = pte_prio_wanted (tp);
+  prev = tp->prioEffective;
+
+  if (tp != (pte_thread_t *) pthread_self ()
+      || !PTE_PRIO_ABOVE (prev, prio))
+    {
+      pte_prio_recompute (tp);
+      pte_osMutexUnlock (pte_mutex_prio_lock);
+      return;
+    }
+
+  /*
+   * A thread dropping its own boost does so only after releasing
+   * pte_mutex_prio_lock. Otherwise the waiter it just handed a mutex
+   * to could block on the lock while a thread of intermediate
+   * priority runs, which is the inversion the boost was there to
+   * prevent.
+   */
+  tp->prioEffective = prio;
+  pte_osMutexUnlock (pte_mutex_prio_lock);
+
+  if (pte_osThreadSetPriority (tp->threadId, prio) != PTE_OS_OK)
+    {
+      prio = prev;
+    }
+
+  /*
+   * Another thread may have boosted us again in the meantime, and
+   * the priority just set must not undo that.
+   */
+  pte_osMutexLock (pte_mutex_prio_lock);
+
+  if (tp->prioEffective != prio
+      && pte_osThreadSetPriority (tp->threadId,
+                                  tp->prioEffective) != PTE_OS_OK)
+    {
+      tp->prioEffective = prio;
+    }
+
+  pte_osMutexUnlock (pte_mutex_prio_lock);
+}
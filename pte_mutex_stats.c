@@ -0,0 +1,177 @@
+/*
+ * pte_mutex_stats.c
+ *
+ * Description:
+ * This translation unit implements the bookkeeping behind the mutex
+ * contention statistics (see pthread_mutex_getstats_np).
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pte_osal.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+#ifdef PTE_MUTEX_STATS
+
+void
+pte_mutex_stats_link (pthread_mutex_t mx)
+{
+  pte_osMutexLock (pte_mutex_stats_lock);
+
+  mx->statsPrev = NULL;
+  mx->statsNext = pte_mutex_stats_list;
+
+  if (pte_mutex_stats_list != NULL)
+    {
+      pte_mutex_stats_list->statsPrev = mx;
+    }
+
+  pte_mutex_stats_list = mx;
+
+  pte_osMutexUnlock (pte_mutex_stats_lock);
+}
+
+
+void
+pte_mutex_stats_unlink (pthread_mutex_t mx)
+{
+  pte_osMutexLock (pte_mutex_stats_lock);
+
+  if (mx->statsPrev != NULL)
+    {
+      mx->statsPrev->statsNext = mx->statsNext;
+    }
+  else
+    {
+      pte_mutex_stats_list = mx->statsNext;
+    }
+
+  if (mx->statsNext != NULL)
+    {
+      mx->statsNext->statsPrev = mx->statsPrev;
+    }
+
+  pte_osMutexUnlock (pte_mutex_stats_lock);
+}
+
+
+unsigned long long
+pte_mutex_stats_wait_start (void)
+/*
+ * Called when an acquisition finds the mutex held. Returns the
+ * time the wait began, or 0 if statistics are disabled.
+ */
+{
+  unsigned long long now;
+
+  if (!pte_mutex_stats_enabled)
+    {
+      return 0;
+    }
+
+  now = pte_osClockGetMicros ();
+
+  /* Zero means "did not wait" to pte_mutex_stats_acquired() */
+  return (now != 0 ? now : 1);
+}
+
+
+void
+pte_mutex_stats_acquired (pthread_mutex_t mx, unsigned long long waitStart)
+/*
+ * Called by the new owner, so the statistics need no further locking.
+ */
+{
+  unsigned long long now = pte_osClockGetMicros ();
+
+  mx->stats.acquisitions++;
+
+  if (waitStart != 0)
+    {
+      unsigned long long wait = now - waitStart;
+
+      mx->stats.contended++;
+      mx->stats.waitTotal += wait;
+
+      if (wait > mx->stats.waitMax)
+        {
+          mx->stats.waitMax = wait;
+        }
+    }
+
+  mx->holdStart = (now != 0 ? now : 1);
+}
+
+
+void
+pte_mutex_stats_released (pthread_mutex_t mx)
+/*
+ * Called by the owner just before it releases the mutex.
+ */
+{
+  unsigned long long hold = pte_osClockGetMicros () - mx->holdStart;
+
+  mx->holdStart = 0;
+  mx->stats.holdTotal += hold;
+
+  if (hold > mx->stats.holdMax)
+    {
+      mx->stats.holdMax = hold;
+    }
+}
+
+
+void
+pte_mutex_stats_failed (pthread_mutex_t mx)
+{
+  (void) PTE_ATOMIC_INCREMENT (&mx->statsFailures);
+}
+
+
+void
+pte_mutex_stats_get (pthread_mutex_t mx, pte_mutex_stats_t * stats)
+/*
+ * Takes a snapshot without locking the mutex. While the mutex is in
+ * use the fields may come from different acquisitions.
+ */
+{
+  *stats = mx->stats;
+  stats->failures = (unsigned long) mx->statsFailures;
+}
+
+#endif /* PTE_MUTEX_STATS */
@@ -0,0 +1,97 @@
+/*
+ * pte_mutex_stats_enable_np.c
+ *
+ * Description:
+ * This translation unit implements the mutex contention statistics
+ * switch.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_mutex_stats_enable_np (int enable)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function starts or stops the gathering of mutex
+ *      contention statistics.
+ *
+ * PARAMETERS
+ *      enable
+ *              non-zero to start gathering statistics, zero
+ *              to stop.
+ *
+ *
+ * DESCRIPTION
+ *      While enabled, every mutex counts its acquisitions,
+ *      contended acquisitions and failed trylock/timedlock
+ *      calls, and times how long threads wait for it and
+ *      hold it. Statistics are kept across disabling, and
+ *      can be read with pthread_mutex_getstats_np() and
+ *      pte_mutex_stats_top_np().
+ *
+ *      Statistics are disabled by default. Enabling them adds
+ *      two reads of pte_osClockGetMicros() to each lock/unlock
+ *      pair, and one more when the lock is contended.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ *              2)      Statistics are only available when the
+ *                      library is built with PTE_MUTEX_STATS
+ *                      defined. Otherwise mutexes carry no
+ *                      counters and their fast paths are
+ *                      unchanged.
+ *
+ * RESULTS
+ *              0               successfully changed,
+ *              ENOTSUP         library built without PTE_MUTEX_STATS.
+ *
+ * ------------------------------------------------------
+ */
+{
+#ifdef PTE_MUTEX_STATS
+  pte_mutex_stats_enabled = (enable != 0);
+
+  return 0;
+#else
+  return ENOTSUP;
+#endif
+}
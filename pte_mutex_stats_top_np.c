@@ -0,0 +1,180 @@
+/*
+ * pte_mutex_stats_top_np.c
+ *
+ * Description:
+ * This translation unit implements listing the most contended mutexes.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdlib.h>
+
+#include <pte_osal.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+#ifdef PTE_MUTEX_STATS
+
+typedef struct
+  {
+    pthread_mutex_t mutex;
+    pte_mutex_stats_t stats;
+  } pte_mutex_stats_entry_t;
+
+#endif
+
+
+int
+pte_mutex_stats_top_np (int count,
+                        void (*callback) (pthread_mutex_t mutex,
+                                          const pte_mutex_stats_t * stats,
+                                          void *arg),
+                        void *arg)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function reports the mutexes that threads have
+ *      spent the longest waiting for.
+ *
+ * PARAMETERS
+ *      count
+ *              maximum number of mutexes to report
+ *
+ *      callback
+ *              called once for each reported mutex, with its
+ *              statistics and 'arg'
+ *
+ *      arg
+ *              passed to 'callback'
+ *
+ *
+ * DESCRIPTION
+ *      Ranks all initialised mutexes that have had at least
+ *      one contended acquisition by total wait time, and calls
+ *      'callback' for up to 'count' of them, longest wait
+ *      first.
+ *
+ *      The statistics are copied before the first callback,
+ *      and no library lock is held during callbacks, so they
+ *      may lock mutexes and print freely. The mutex handle
+ *      passed to 'callback' identifies the mutex only; it may
+ *      have been destroyed by the time the callback runs.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully reported,
+ *              EINVAL          'count' is not positive or
+ *                              'callback' is NULL,
+ *              ENOMEM          insufficient memory,
+ *              ENOTSUP         library built without PTE_MUTEX_STATS.
+ *
+ * ------------------------------------------------------
+ */
+{
+#ifdef PTE_MUTEX_STATS
+  pte_mutex_stats_entry_t * top;
+  pte_mutex_stats_entry_t entry;
+  pthread_mutex_t mx;
+  int n = 0;
+  int i;
+
+  if (count <= 0 || callback == NULL)
+    {
+      return EINVAL;
+    }
+
+  top = (pte_mutex_stats_entry_t *) pte_alloc (PTE_ALLOC_MISC, count * sizeof (*top));
+
+  if (top == NULL)
+    {
+      return ENOMEM;
+    }
+
+  pte_osMutexLock (pte_mutex_stats_lock);
+
+  for (mx = pte_mutex_stats_list; mx != NULL; mx = mx->statsNext)
+    {
+      entry.mutex = mx;
+      pte_mutex_stats_get (mx, &entry.stats);
+
+      if (entry.stats.contended == 0)
+        {
+          continue;
+        }
+
+      /*
+       * Insertion into the sorted top list, dropping the last
+       * entry once it is full.
+       */
+      if (n < count)
+        {
+          i = n++;
+        }
+      else if (entry.stats.waitTotal > top[count - 1].stats.waitTotal)
+        {
+          i = count - 1;
+        }
+      else
+        {
+          continue;
+        }
+
+      while (i > 0 && top[i - 1].stats.waitTotal < entry.stats.waitTotal)
+        {
+          top[i] = top[i - 1];
+          i--;
+        }
+
+      top[i] = entry;
+    }
+
+  pte_osMutexUnlock (pte_mutex_stats_lock);
+
+  for (i = 0; i < n; i++)
+    {
+      (*callback) (top[i].mutex, &top[i].stats, arg);
+    }
+
+  pte_free (PTE_ALLOC_MISC, top, count * sizeof (*top));
+
+  return 0;
+#else
+  return ENOTSUP;
+#endif
+}
@@ -60,7 +60,7 @@ pte_new (void)
    */
 
   /* No reuse threads available */
-  tp = (pte_thread_t *) calloc (1, sizeof(pte_thread_t));
+  tp = (pte_thread_t *) pte_alloc (PTE_ALLOC_THREAD, sizeof (pte_thread_t));
 
   if (tp == NULL)
     {
@@ -72,6 +72,8 @@ pte_new (void)
 
   /* Set default state. */
   tp->sched_priority = pte_osThreadGetMinPriority();
+  tp->sched_policy = SCHED_OTHER;
+  tp->prioEffective = tp->sched_priority;
 
   tp->detachState = PTHREAD_CREATE_JOINABLE;
   tp->cancelState = PTHREAD_CANCEL_ENABLE;
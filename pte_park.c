@@ -0,0 +1,175 @@
+/*
+ * pte_park.c
+ *
+ * Description:
+ * This translation unit implements the parking lot that threads
+ * waiting for an inline lock word block in.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pte_osal.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+typedef struct
+  {
+    pte_osMutexHandle lock;
+    pte_park_node_t * head;
+    pte_park_node_t * tail;
+  } pte_park_bucket_t;
+
+static pte_park_bucket_t pte_park_buckets[PTE_PARK_BUCKETS];
+
+#define PTE_PARK_BUCKET(addr) \
+  (&pte_park_buckets[((size_t) (addr) >> 2) & (PTE_PARK_BUCKETS - 1)])
+
+
+void
+pte_park_init (void)
+{
+  int i;
+
+  for (i = 0; i < PTE_PARK_BUCKETS; i++)
+    {
+      pte_osMutexCreate (&pte_park_buckets[i].lock);
+    }
+}
+
+
+void
+pte_park (volatile int *addr, int expected)
+/*
+ * Blocks the calling thread until pte_unpark_one() is called for
+ * 'addr', unless *addr no longer holds 'expected'. Callers must
+ * recheck their condition on return.
+ *
+ * The check is made under the bucket lock, and pte_unpark_one()
+ * takes the same lock, so a waker that changes *addr before
+ * unparking cannot miss a thread that has decided to park.
+ */
+{
+  pte_thread_t * sp = (pte_thread_t *) pthread_self ();
+  pte_park_bucket_t * b = PTE_PARK_BUCKET (addr);
+  pte_park_node_t node;
+
+  if (!sp->parkSemValid)
+    {
+      if (pte_osSemaphoreCreate (0, &sp->parkSem) != PTE_OS_OK)
+        {
+          /*
+           * Nothing to block on; let the holder run instead.
+           */
+          pte_osThreadSleep (1);
+          return;
+        }
+      sp->parkSemValid = 1;
+    }
+
+  node.next = NULL;
+  node.addr = addr;
+  node.sem = sp->parkSem;
+
+  pte_osMutexLock (b->lock);
+
+  if (*addr != expected)
+    {
+      pte_osMutexUnlock (b->lock);
+      return;
+    }
+
+  if (b->tail == NULL)
+    {
+      b->head = &node;
+    }
+  else
+    {
+      b->tail->next = &node;
+    }
+  b->tail = &node;
+
+  pte_osMutexUnlock (b->lock);
+
+  (void) pte_osSemaphorePend (node.sem, NULL);
+}
+
+
+void
+pte_unpark_one (volatile int *addr)
+/*
+ * Wakes the longest parked thread waiting on 'addr', if any.
+ */
+{
+  pte_park_bucket_t * b = PTE_PARK_BUCKET (addr);
+  pte_park_node_t * prev = NULL;
+  pte_park_node_t * node;
+
+  pte_osMutexLock (b->lock);
+
+  for (node = b->head; node != NULL; prev = node, node = node->next)
+    {
+      if (node->addr == addr)
+        {
+          if (prev == NULL)
+            {
+              b->head = node->next;
+            }
+          else
+            {
+              prev->next = node->next;
+            }
+
+          if (b->tail == node)
+            {
+              b->tail = prev;
+            }
+
+          break;
+        }
+    }
+
+  pte_osMutexUnlock (b->lock);
+
+  /*
+   * The node is on the parked thread's stack, but that thread stays
+   * parked until this post.
+   */
+  if (node != NULL)
+    {
+      (void) pte_osSemaphorePost (node->sem, 1);
+    }
+}
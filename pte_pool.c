@@ -0,0 +1,433 @@
+/*
+ * pte_pool.c
+ *
+ * Description:
+ * This translation unit implements the thread pool internals:
+ * the task queue, worker parking and the worker routine.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <string.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+
+/*
+ * The pte_osAtomic* operations are full memory barriers, so a cell's
+ * routine and arg are published by the exchange on its sequence and
+ * are safe to read once the dequeuePos compare-and-exchange succeeds.
+ *
+ * Positions wrap; differences are taken in unsigned arithmetic.
+ */
+#define PTE_POOL_DIFF(a, b) ((int) ((unsigned int) (a) - (unsigned int) (b)))
+#define PTE_POOL_NEXT(a, n) ((int) ((unsigned int) (a) + (unsigned int) (n)))
+
+
+int
+pte_pool_push (pte_pool_t pool, void (*routine) (void *), void *arg)
+/*
+ * Append a task to the pool's queue.
+ *
+ * Returns 0 or EAGAIN if the queue is full.
+ */
+{
+  pte_pool_task_t * cell;
+  int pos = pool->enqueuePos;
+  int seen;
+  int dif;
+
+  for (;;)
+    {
+      cell = &pool->tasks[pos & pool->mask];
+      dif = PTE_POOL_DIFF (cell->sequence, pos);
+
+      if (dif == 0)
+        {
+          seen = PTE_ATOMIC_COMPARE_EXCHANGE (&pool->enqueuePos,
+                                              PTE_POOL_NEXT (pos, 1),
+                                              pos);
+          if (seen == pos)
+            {
+              break;
+            }
+          pos = seen;
+        }
+      else if (dif < 0)
+        {
+          /* The consumer of this cell's previous lap hasn't finished */
+          return EAGAIN;
+        }
+      else
+        {
+          pos = pool->enqueuePos;
+        }
+    }
+
+  cell->routine = routine;
+  cell->arg = arg;
+  (void) PTE_ATOMIC_EXCHANGE (&cell->sequence, PTE_POOL_NEXT (pos, 1));
+
+  return 0;
+}
+
+
+static int
+pte_pool_pop (pte_pool_t pool, void (**routine) (void *), void **arg)
+/*
+ * Take the oldest task from the pool's queue.
+ *
+ * Returns 1 if a task was taken, 0 if the queue is empty.
+ */
+{
+  pte_pool_task_t * cell;
+  int pos = pool->dequeuePos;
+  int seen;
+  int dif;
+
+  for (;;)
+    {
+      cell = &pool->tasks[pos & pool->mask];
+      dif = PTE_POOL_DIFF (cell->sequence, PTE_POOL_NEXT (pos, 1));
+
+      if (dif == 0)
+        {
+          seen = PTE_ATOMIC_COMPARE_EXCHANGE (&pool->dequeuePos,
+                                              PTE_POOL_NEXT (pos, 1),
+                                              pos);
+          if (seen == pos)
+            {
+              break;
+            }
+          pos = seen;
+        }
+      else if (dif < 0)
+        {
+          return 0;
+        }
+      else
+        {
+          pos = pool->dequeuePos;
+        }
+    }
+
+  *routine = cell->routine;
+  *arg = cell->arg;
+
+  /* Hand the cell to the producer one lap ahead */
+  (void) PTE_ATOMIC_EXCHANGE (&cell->sequence,
+                              PTE_POOL_NEXT (pos, pool->mask + 1));
+
+  return 1;
+}
+
+
+void
+pte_pool_wake (int *count, pte_osSemaphoreHandle semHandle, int all)
+/*
+ * Wake one, or all, of the threads counted in '*count' that are
+ * parked, or about to park, on 'semHandle'. Each wakeup removes the
+ * woken thread from the count and posts exactly one unit.
+ */
+{
+  int n = *count;
+  int seen;
+
+  if (all)
+    {
+      n = PTE_ATOMIC_EXCHANGE (count, 0);
+      if (n > 0)
+        {
+          (void) pte_osSemaphorePost (semHandle, n);
+        }
+      return;
+    }
+
+  while (n > 0)
+    {
+      seen = PTE_ATOMIC_COMPARE_EXCHANGE (count, n - 1, n);
+      if (seen == n)
+        {
+          (void) pte_osSemaphorePost (semHandle, 1);
+          return;
+        }
+      n = seen;
+    }
+}
+
+
+void
+pte_pool_unpark (int *count, pte_osSemaphoreHandle semHandle)
+/*
+ * Called by a thread that added itself to '*count' and then found
+ * it need not park after all. If a waker already removed it from
+ * the count then a unit is on its way and must be consumed, or it
+ * would wake some later sleeper for nothing.
+ */
+{
+  int n = *count;
+  int seen;
+
+  while (n > 0)
+    {
+      seen = PTE_ATOMIC_COMPARE_EXCHANGE (count, n - 1, n);
+      if (seen == n)
+        {
+          return;
+        }
+      n = seen;
+    }
+
+  (void) pte_osSemaphorePend (semHandle, NULL);
+}
+
+
+void
+pte_pool_task_done (pte_pool_t pool)
+{
+  if (PTE_ATOMIC_DECREMENT (&pool->outstanding) == 0)
+    {
+      pte_pool_wake (&pool->waiters, pool->doneSem, 1);
+    }
+}
+
+
+int
+pte_pool_is_worker (pte_pool_t pool)
+{
+  pthread_t self = pthread_self ();
+  int result = 0;
+  int i;
+
+  (void) pthread_mutex_lock (&pool->lock);
+
+  for (i = 0; i < pool->nthreads; i++)
+    {
+      if (pthread_equal (pool->workers[i], self))
+        {
+          result = 1;
+          break;
+        }
+    }
+
+  (void) pthread_mutex_unlock (&pool->lock);
+
+  return result;
+}
+
+
+int
+pte_pool_run (pte_thread_t * sp, void (*routine) (void *), void *arg,
+              int cancelState)
+/*
+ * Run one task with the given cancelability state, deferred. A task
+ * that calls pthread_exit(), or acts on a cancellation request, ends
+ * only itself: the cleanup handlers it pushed run and control
+ * returns here. Tasks may nest; the caller's cancelability, cleanup
+ * mark and start mark are restored afterwards.
+ *
+ * Returns 0, PTE_EPS_EXIT or PTE_EPS_CANCEL.
+ */
+{
+  int result = 0;
+  int oldState;
+  int oldType;
+  void *oldMark;
+#ifdef PTE_CLEANUP_C
+  jmp_buf saved;
+#endif
+
+  (void) pthread_mutex_lock (&sp->cancelLock);
+  oldState = sp->cancelState;
+  oldType = sp->cancelType;
+  sp->cancelState = cancelState;
+  sp->cancelType = PTHREAD_CANCEL_DEFERRED;
+  PTE_CANCEL_PUBLISH (sp);
+  (void) pthread_mutex_unlock (&sp->cancelLock);
+
+  oldMark = sp->cleanupMark;
+  sp->cleanupMark = pthread_getspecific (pte_cleanupKey);
+
+#ifdef PTE_CLEANUP_C
+
+  memcpy (saved, sp->start_mark, sizeof (jmp_buf));
+
+  result = setjmp (sp->start_mark);
+
+  if (0 == result)
+    {
+      (*routine) (arg);
+    }
+
+  memcpy (sp->start_mark, saved, sizeof (jmp_buf));
+
+#else /* PTE_CLEANUP_C */
+
+#ifdef PTE_CLEANUP_CXX
+
+  try
+    {
+      (*routine) (arg);
+    }
+  catch (pte_exception_cancel &)
+    {
+      result = PTE_EPS_CANCEL;
+    }
+  catch (pte_exception_exit &)
+    {
+      result = PTE_EPS_EXIT;
+    }
+
+#else
+
+#error ERROR [__FILE__, line __LINE__]: Cleanup type undefined.
+
+#endif /* PTE_CLEANUP_CXX */
+
+#endif /* PTE_CLEANUP_C */
+
+  sp->cleanupMark = oldMark;
+
+  if (result == PTE_EPS_EXIT)
+    {
+      sp->exitStatus = NULL;
+    }
+
+  if (result != PTE_EPS_CANCEL)
+    {
+      (void) pthread_mutex_lock (&sp->cancelLock);
+      sp->cancelState = oldState;
+      sp->cancelType = oldType;
+      PTE_CANCEL_PUBLISH (sp);
+      (void) pthread_mutex_unlock (&sp->cancelLock);
+    }
+
+  return result;
+}
+
+
+static void
+pte_pool_replace (pte_pool_t pool)
+/*
+ * Start a new worker in place of the calling one.
+ *
+ * A cancelled worker can't carry on: the OS keeps the cancel request
+ * latched for the life of the thread, so every later cancellable
+ * wait would fail. Instead it hands its slot to a fresh thread and
+ * exits, detached. Once the pool is shutting down the slot is left
+ * for pte_pool_destroy_np() to join.
+ */
+{
+  pthread_t self = pthread_self ();
+  pthread_t tid;
+  int i;
+
+  (void) pthread_mutex_lock (&pool->lock);
+
+  if (!pool->shutdown)
+    {
+      for (i = 0; i < pool->nthreads; i++)
+        {
+          if (pthread_equal (pool->workers[i], self))
+            {
+              if (pthread_create (&tid, &pool->attr, pte_pool_worker, pool) == 0)
+                {
+                  pool->workers[i] = tid;
+                  (void) pthread_detach (self);
+                }
+              break;
+            }
+        }
+    }
+
+  (void) pthread_mutex_unlock (&pool->lock);
+}
+
+
+void *
+pte_pool_worker (void *arg)
+{
+  pte_pool_t pool = (pte_pool_t) arg;
+  pte_thread_t * sp = (pte_thread_t *) pthread_self ();
+  void (*routine) (void *);
+  void *routineArg;
+  int result;
+
+  for (;;)
+    {
+      if (!pte_pool_pop (pool, &routine, &routineArg))
+        {
+          if (pool->shutdown)
+            {
+              break;
+            }
+
+          /*
+           * Announce that we are going to sleep, then look again:
+           * a submitter either sees us in 'sleepers' or we see
+           * its task.
+           */
+          (void) PTE_ATOMIC_INCREMENT (&pool->sleepers);
+
+          if (!pte_pool_pop (pool, &routine, &routineArg))
+            {
+              if (pool->shutdown)
+                {
+                  pte_pool_unpark (&pool->sleepers, pool->workSem);
+                  break;
+                }
+
+              (void) pte_osSemaphorePend (pool->workSem, NULL);
+              continue;
+            }
+
+          pte_pool_unpark (&pool->sleepers, pool->workSem);
+        }
+
+      result = pte_pool_run (sp, routine, routineArg, PTHREAD_CANCEL_ENABLE);
+
+      pte_pool_task_done (pool);
+
+      if (result == PTE_EPS_CANCEL)
+        {
+          pte_pool_replace (pool);
+          break;
+        }
+    }
+
+  return NULL;
+}
@@ -0,0 +1,233 @@
+/*
+ * pte_pool_create_np.c
+ *
+ * Description:
+ * This translation unit implements thread pool primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdlib.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_pool_create_np (pte_pool_t * pool,
+                    int nthreads,
+                    int queuesize,
+                    const pthread_attr_t * attr)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function creates a pool of worker threads that
+ *      run tasks submitted with pte_pool_submit_np().
+ *
+ * PARAMETERS
+ *      pool
+ *              pointer to an instance of pte_pool_t
+ *
+ *      nthreads
+ *              number of worker threads; zero or less means
+ *              one per processor.
+ *
+ *      queuesize
+ *              number of tasks that can wait to be run,
+ *              rounded up to a power of two; zero or less
+ *              means PTE_POOL_DEFAULT_QUEUE.
+ *
+ *      attr
+ *              attributes for the worker threads, or NULL.
+ *
+ *
+ * DESCRIPTION
+ *      The workers are started immediately and stay alive
+ *      until pte_pool_destroy_np(), so running a task costs
+ *      none of the thread creation and destruction work of
+ *      pthread_create() and pthread_join(). Idle workers
+ *      block on a semaphore.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ *              2)      The attributes must not name a stack
+ *                      address, since the workers can't share a
+ *                      stack, and must not be detached.
+ *
+ * RESULTS
+ *              0               successfully created pool,
+ *              EINVAL          'attr' is invalid or not usable
+ *                              for the workers,
+ *              ENOMEM          insufficient memory,
+ *              EAGAIN          insufficient resources to
+ *                              start the workers.
+ *
+ * ------------------------------------------------------
+ */
+{
+  pte_pool_t pl;
+  int result;
+  int size;
+  int i;
+
+  if (pool == NULL)
+    {
+      return EINVAL;
+    }
+
+  if (attr != NULL)
+    {
+      if (pte_is_attr (attr) != 0
+          || (*attr)->stackaddr != NULL
+          || (*attr)->detachstate != PTHREAD_CREATE_JOINABLE)
+        {
+          return EINVAL;
+        }
+    }
+
+  if (nthreads <= 0)
+    {
+      nthreads = pthread_num_processors_np ();
+    }
+
+  if (queuesize <= 0)
+    {
+      queuesize = PTE_POOL_DEFAULT_QUEUE;
+    }
+
+  for (size = 2; size < queuesize && size < (1 << 30); size <<= 1)
+    {
+    }
+
+  pl = (pte_pool_t) pte_alloc (PTE_ALLOC_POOL, sizeof (*pl));
+
+  if (pl == NULL)
+    {
+      return ENOMEM;
+    }
+
+  pl->tasks = (pte_pool_task_t *) pte_alloc (PTE_ALLOC_POOL,
+                                             size * sizeof (pte_pool_task_t));
+  pl->workers = (pthread_t *) pte_alloc (PTE_ALLOC_POOL,
+                                         nthreads * sizeof (pthread_t));
+  pl->workersSize = nthreads;
+
+  if (pl->tasks == NULL || pl->workers == NULL)
+    {
+      result = ENOMEM;
+      goto FAIL0;
+    }
+
+  pl->mask = size - 1;
+
+  for (i = 0; i < size; i++)
+    {
+      pl->tasks[i].sequence = i;
+    }
+
+  if ((result = pthread_attr_init (&pl->attr)) != 0)
+    {
+      goto FAIL0;
+    }
+
+  if (attr != NULL)
+    {
+      *pl->attr = **attr;
+    }
+
+  if ((result = pthread_mutex_init (&pl->lock, NULL)) != 0)
+    {
+      goto FAIL1;
+    }
+
+  if (pte_osSemaphoreCreate (0, &pl->workSem) != PTE_OS_OK)
+    {
+      result = EAGAIN;
+      goto FAIL2;
+    }
+
+  if (pte_osSemaphoreCreate (0, &pl->doneSem) != PTE_OS_OK)
+    {
+      result = EAGAIN;
+      goto FAIL3;
+    }
+
+  /*
+   * Hold the lock so that no worker looks itself up in
+   * pl->workers before its entry is filled in.
+   */
+  (void) pthread_mutex_lock (&pl->lock);
+
+  for (pl->nthreads = 0; pl->nthreads < nthreads; pl->nthreads++)
+    {
+      result = pthread_create (&pl->workers[pl->nthreads], &pl->attr,
+                               pte_pool_worker, pl);
+      if (result != 0)
+        {
+          break;
+        }
+    }
+
+  (void) pthread_mutex_unlock (&pl->lock);
+
+  if (result != 0)
+    {
+      /* Stop the workers we did start */
+      (void) pte_pool_destroy_np (pl);
+      return result;
+    }
+
+  *pool = pl;
+
+  return 0;
+
+FAIL3:
+  (void) pte_osSemaphoreDelete (pl->workSem);
+
+FAIL2:
+  (void) pthread_mutex_destroy (&pl->lock);
+
+FAIL1:
+  (void) pthread_attr_destroy (&pl->attr);
+
+FAIL0:
+  pte_free (PTE_ALLOC_POOL, pl->workers, nthreads * sizeof (pthread_t));
+  pte_free (PTE_ALLOC_POOL, pl->tasks, size * sizeof (pte_pool_task_t));
+  pte_free (PTE_ALLOC_POOL, pl, sizeof (*pl));
+
+  return result;
+}
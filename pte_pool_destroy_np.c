@@ -0,0 +1,128 @@
+/*
+ * pte_pool_destroy_np.c
+ *
+ * Description:
+ * This translation unit implements thread pool primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdlib.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_pool_destroy_np (pte_pool_t pool)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function stops a pool's workers and frees the
+ *      pool.
+ *
+ * PARAMETERS
+ *      pool
+ *              pool created with pte_pool_create_np()
+ *
+ *
+ * DESCRIPTION
+ *      Tasks already submitted are run before the workers
+ *      exit; this function returns once they have all
+ *      finished and the workers have been joined. No tasks
+ *      may be submitted once destruction has begun.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully destroyed pool,
+ *              EINVAL          'pool' is invalid or already
+ *                              being destroyed,
+ *              EDEADLK         called from one of the pool's tasks.
+ *
+ * ------------------------------------------------------
+ */
+{
+  int i;
+
+  if (pool == NULL)
+    {
+      return EINVAL;
+    }
+
+  if (pte_pool_is_worker (pool))
+    {
+      return EDEADLK;
+    }
+
+  (void) pthread_mutex_lock (&pool->lock);
+
+  if (pool->shutdown)
+    {
+      (void) pthread_mutex_unlock (&pool->lock);
+      return EINVAL;
+    }
+
+  (void) PTE_ATOMIC_EXCHANGE (&pool->shutdown, 1);
+
+  (void) pthread_mutex_unlock (&pool->lock);
+
+  /*
+   * Workers only park when the queue is empty; once woken they
+   * see 'shutdown' and exit after draining it.
+   */
+  pte_pool_wake (&pool->sleepers, pool->workSem, 1);
+
+  /* No worker replaces itself once 'shutdown' is set */
+  for (i = 0; i < pool->nthreads; i++)
+    {
+      (void) pthread_join (pool->workers[i], NULL);
+    }
+
+  (void) pte_osSemaphoreDelete (pool->doneSem);
+  (void) pte_osSemaphoreDelete (pool->workSem);
+  (void) pthread_mutex_destroy (&pool->lock);
+  (void) pthread_attr_destroy (&pool->attr);
+
+  pte_free (PTE_ALLOC_POOL, pool->workers,
+            pool->workersSize * sizeof (pthread_t));
+  pte_free (PTE_ALLOC_POOL, pool->tasks,
+            (pool->mask + 1) * sizeof (pte_pool_task_t));
+  pte_free (PTE_ALLOC_POOL, pool, sizeof (*pool));
+
+  return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * pte_pool_submit_np.c
+ *
+ * Description:
+ * This translation unit implements thread pool primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_pool_submit_np (pte_pool_t pool,
+                    void (*routine) (void *),
+                    void *arg)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function queues a task for a pool's workers.
+ *
+ * PARAMETERS
+ *      pool
+ *              pool created with pte_pool_create_np()
+ *
+ *      routine
+ *              function to run
+ *
+ *      arg
+ *              argument passed to 'routine'
+ *
+ *
+ * DESCRIPTION
+ *      The task is appended to the pool's lock-free queue and
+ *      an idle worker, if there is one, is woken to run it.
+ *      Tasks start in submission order but may finish in any
+ *      order.
+ *
+ *      Every task starts with cancelability enabled and
+ *      deferred, whatever the previous task on that worker
+ *      left behind. A task that calls pthread_exit(), or is
+ *      cancelled, ends without ending its worker; its cleanup
+ *      handlers are run as for a thread.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ *              2)      pthread_self() in a task refers to the
+ *                      worker running it; cancelling that thread
+ *                      cancels the task at its next cancellation
+ *                      point.
+ *
+ * RESULTS
+ *              0               successfully queued task,
+ *              EINVAL          'pool' or 'routine' is invalid or
+ *                              the pool is being destroyed,
+ *              EAGAIN          the queue is full.
+ *
+ * ------------------------------------------------------
+ */
+{
+  int result;
+
+  if (pool == NULL || routine == NULL || pool->shutdown)
+    {
+      return EINVAL;
+    }
+
+  /*
+   * Count the task before it becomes visible so that
+   * pte_pool_wait_np() can't see an idle pool with work queued.
+   */
+  (void) PTE_ATOMIC_INCREMENT (&pool->outstanding);
+
+  result = pte_pool_push (pool, routine, arg);
+
+  if (result != 0)
+    {
+      pte_pool_task_done (pool);
+      return result;
+    }
+
+  if (pool->sleepers > 0)
+    {
+      pte_pool_wake (&pool->sleepers, pool->workSem, 0);
+    }
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * pte_pool_wait_np.c
+ *
+ * Description:
+ * This translation unit implements thread pool primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_pool_wait_np (pte_pool_t pool)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function waits until every task submitted to a
+ *      pool has finished.
+ *
+ * PARAMETERS
+ *      pool
+ *              pool created with pte_pool_create_np()
+ *
+ *
+ * DESCRIPTION
+ *      This function returns once the pool has no queued or
+ *      running tasks. Tasks submitted while waiting, by this
+ *      or other threads, are waited for too.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ *              2)      This function is a cancellation point.
+ *
+ * RESULTS
+ *              0               all tasks have finished,
+ *              EINVAL          'pool' is invalid,
+ *              EDEADLK         called from one of the pool's tasks.
+ *
+ * ------------------------------------------------------
+ */
+{
+  if (pool == NULL)
+    {
+      return EINVAL;
+    }
+
+  if (pool->outstanding == 0)
+    {
+      return 0;
+    }
+
+  if (pte_pool_is_worker (pool))
+    {
+      return EDEADLK;
+    }
+
+  while (pool->outstanding != 0)
+    {
+      (void) PTE_ATOMIC_INCREMENT (&pool->waiters);
+
+      if (pool->outstanding == 0)
+        {
+          pte_pool_unpark (&pool->waiters, pool->doneSem);
+          break;
+        }
+
+      (void) pte_cancellable_wait (pool->doneSem, NULL, pool);
+    }
+
+  return 0;
+}
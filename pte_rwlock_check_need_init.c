@@ -47,56 +47,63 @@
 int
 pte_rwlock_check_need_init (pthread_rwlock_t * rwlock)
 {
-  int result = 0;
+  int result;
+  pthread_rwlock_t rwl;
 
   /*
-   * The following guarded test is specifically for statically
+   * The following test is specifically for statically
    * initialised rwlocks (via PTHREAD_RWLOCK_INITIALIZER).
    *
-   * Note that by not providing this synchronisation we risk
-   * introducing race conditions into applications which are
-   * correctly written.
+   * The rwlock is built privately and installed with a single
+   * compare-and-exchange; see pte_mutex_check_need_init().
    *
-   * Approach
-   * --------
-   * We know that static rwlocks will not be PROCESS_SHARED
-   * so we can serialise access to internal state using
-   * critical sections rather than mutexes.
-   *
-   * If using a single global lock slows applications down too much,
-   * multiple global locks could be created and hashed on some random
-   * value associated with each mutex, the pointer perhaps. At a guess,
-   * a good value for the optimal number of global locks might be
-   * the number of processors + 1.
-   *
-   */
-
-
-  pte_osMutexLock (pte_rwlock_test_init_lock);
-
-  /*
-   * We got here possibly under race
-   * conditions. Check again inside the critical section
-   * and only initialise if the rwlock is valid (not been destroyed).
    * If a static rwlock has been destroyed, the application can
    * re-initialise it only by calling pthread_rwlock_init()
    * explicitly.
    */
-  if (*rwlock == PTHREAD_RWLOCK_INITIALIZER)
+  if (*rwlock == NULL)
     {
-      result = pthread_rwlock_init (rwlock, NULL);
+      /*
+       * The rwlock has been destroyed, so the operation that
+       * caused the auto-initialisation should fail.
+       */
+      return EINVAL;
     }
-  else if (*rwlock == NULL)
+
+  if (*rwlock != PTHREAD_RWLOCK_INITIALIZER)
     {
       /*
-       * The rwlock has been destroyed while we were waiting to
-       * initialise it, so the operation that caused the
-       * auto-initialisation should fail.
+       * Another thread has initialised it.
        */
-      result = EINVAL;
+      return 0;
     }
 
-  pte_osMutexUnlock(pte_rwlock_test_init_lock);
+  if ((result = pthread_rwlock_init (&rwl, NULL)) != 0)
+    {
+      return result;
+    }
+
+#ifdef PTE_SYNC_REGISTRY
+  if (rwl->syncEntry != NULL)
+    {
+      rwl->syncEntry->tag = "PTHREAD_RWLOCK_INITIALIZER";
+    }
+#endif
+
+  if (PTE_ATOMIC_COMPARE_EXCHANGE_PTR ((void * volatile *) rwlock, (void *) rwl,
+                                       (void *) PTHREAD_RWLOCK_INITIALIZER)
+      != (void *) PTHREAD_RWLOCK_INITIALIZER)
+    {
+      /*
+       * Lost the race, or the rwlock was destroyed meanwhile.
+       */
+      (void) pthread_rwlock_destroy (&rwl);
+
+      if (*rwlock == NULL)
+        {
+          result = EINVAL;
+        }
+    }
 
   return result;
 }
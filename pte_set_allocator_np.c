@@ -0,0 +1,106 @@
+/*
+ * pte_set_allocator_np.c
+ *
+ * Description:
+ * This translation unit implements installing the allocator used for
+ * the library's memory.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_set_allocator_np (const pte_allocator_t * allocator)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function installs the allocator the library uses
+ *      for thread structures, sync objects, attributes, keys,
+ *      thread local storage and all its other memory.
+ *
+ * PARAMETERS
+ *      allocator
+ *              allocator to use, or NULL for the C library
+ *              heap. The structure is not copied and must stay
+ *              valid until all the memory it supplied has been
+ *              given back.
+ *
+ *
+ * DESCRIPTION
+ *      Each allocation is made with alloc, passing the size,
+ *      the PTE_ALLOC_* type of the object and the allocator's
+ *      arg, and is later given back to free with the same
+ *      size and type, so fixed-size allocators need no header.
+ *      Memory returned by alloc need not be zeroed.
+ *
+ *      The size asked for includes a pointer-sized header in
+ *      which the library records the allocator. Memory always
+ *      goes back to the allocator that supplied it, so the
+ *      allocator may be switched at any time; a replaced one
+ *      must keep working until everything it supplied has
+ *      been freed.
+ *
+ *      Mutex, condition variable, semaphore, read-write lock,
+ *      barrier and spinlock structs are not allocated one by
+ *      one: the library carves them from PTE_ALLOC_SLAB chunks
+ *      that are only given back by pthread_terminate().
+ *
+ *      Both functions may be called by several threads at
+ *      once, and must not call into this library.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully installed,
+ *              EINVAL          'allocator' lacks alloc or free.
+ *
+ * ------------------------------------------------------
+ */
+{
+  if (allocator != NULL
+      && (allocator->alloc == NULL || allocator->free == NULL))
+    {
+      return EINVAL;
+    }
+
+  pte_allocator = allocator;
+
+  return 0;
+}
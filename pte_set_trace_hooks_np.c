@@ -0,0 +1,101 @@
+/*
+ * pte_set_trace_hooks_np.c
+ *
+ * Description:
+ * This translation unit implements installing scheduling trace hooks.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_set_trace_hooks_np (const pte_trace_hooks_t * hooks)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function installs the hooks called at the
+ *      library's scheduling tracepoints.
+ *
+ * PARAMETERS
+ *      hooks
+ *              hooks to call, or NULL to remove the installed
+ *              hooks. The structure is not copied and must stay
+ *              valid until it is replaced or removed.
+ *
+ *
+ * DESCRIPTION
+ *      Threads call the block hook just before they wait on a
+ *      mutex, condition variable, barrier or semaphore and the
+ *      wake hook as soon as the wait ends, for whatever reason.
+ *      The object passed is the pthread_mutex_t, pthread_cond_t,
+ *      pthread_barrier_t or sem_t value (not its address), or
+ *      the pte_pool_t or pte_task_t waited for. Waits on a
+ *      condition variable or barrier are reported once for it
+ *      and once, nested, for the semaphore it uses internally.
+ *
+ *      The handoff hook is called by a thread that wakes the
+ *      waiters of a mutex, condition variable or barrier. The
+ *      create hook is called by pthread_create() before the
+ *      new thread runs, the exit hook by a thread as it exits
+ *      and the cancel hook by pthread_cancel(); all three are
+ *      passed the pthread_t concerned.
+ *
+ *      Hooks run on the thread that caused the event, often
+ *      with library locks held, and so must not block or call
+ *      back into the library's blocking functions.
+ *
+ *      When no hooks are installed each tracepoint costs one
+ *      load and one predictable branch.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ *              2)      Installing hooks stops the recorder started
+ *                      by pte_trace_start_np().
+ *
+ * RESULTS
+ *              0               successfully installed.
+ *
+ * ------------------------------------------------------
+ */
+{
+  pte_trace_hooks = hooks;
+
+  return 0;
+}
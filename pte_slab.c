@@ -0,0 +1,417 @@
+/*
+ * pte_slab.c
+ *
+ * Description:
+ * This translation unit implements the slab caches that sync objects
+ * are allocated from.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdlib.h>
+
+#include <pte_osal.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+#define PTE_SLAB_ROUND(size) \
+  (((size) + PTE_SLAB_ALIGN - 1) & ~((size_t) PTE_SLAB_ALIGN - 1))
+
+/*
+ * A chunk of slots. The header is followed by the cache line aligned
+ * slots; the chunks of each type are linked so that pthread_terminate()
+ * can free them.
+ */
+typedef struct pte_slab_chunk_t_ pte_slab_chunk_t;
+
+struct pte_slab_chunk_t_
+  {
+    pte_slab_chunk_t * next;
+    size_t size;
+  };
+
+/*
+ * A free slot. The link is kept in the slot itself.
+ */
+typedef struct pte_slab_slot_t_ pte_slab_slot_t;
+
+struct pte_slab_slot_t_
+  {
+    pte_slab_slot_t * next;
+  };
+
+typedef struct
+  {
+    int type;
+    size_t size;		/* Slot size, a multiple of PTE_SLAB_ALIGN */
+    pte_osMutexHandle lock;	/* Guards the fields below */
+    pte_slab_slot_t * free;
+    int freeCount;
+    int slots;			/* Slots in all chunks */
+    pte_slab_chunk_t * chunks;
+  } pte_slab_class_t;
+
+/*
+ * A thread's free slots, PTE_SLAB_MAGAZINE per type, kept in an OS
+ * TLS slot. Threads that have exited have PTE_SLAB_NO_MAGAZINE.
+ */
+typedef struct
+  {
+    int count[PTE_SLAB_CLASSES];
+    void *slots[PTE_SLAB_CLASSES][PTE_SLAB_MAGAZINE];
+  } pte_slab_magazine_t;
+
+#define PTE_SLAB_NO_MAGAZINE ((pte_slab_magazine_t *) 1)
+
+static pte_slab_class_t pte_slab_classes[PTE_SLAB_CLASSES] =
+  {
+    {PTE_ALLOC_MUTEX, PTE_SLAB_ROUND (sizeof (struct pthread_mutex_t_))},
+    {PTE_ALLOC_COND, PTE_SLAB_ROUND (sizeof (struct pthread_cond_t_))},
+    {PTE_ALLOC_SEM, PTE_SLAB_ROUND (sizeof (struct sem_t_))},
+    {PTE_ALLOC_RWLOCK, PTE_SLAB_ROUND (sizeof (struct pthread_rwlock_t_))},
+    {PTE_ALLOC_BARRIER, PTE_SLAB_ROUND (sizeof (struct pthread_barrier_t_))},
+    {PTE_ALLOC_SPIN, PTE_SLAB_ROUND (sizeof (struct pthread_spinlock_t_))}
+  };
+
+static unsigned int pte_slab_key;
+
+
+int
+pte_slab_class (int type, size_t size)
+{
+  /*
+   * Returns the slab class for objects of 'type' and 'size', or
+   * -1 if they come straight from the allocator.
+   */
+  int cls;
+
+  for (cls = 0; cls < PTE_SLAB_CLASSES; cls++)
+    {
+      if (pte_slab_classes[cls].type == type)
+        {
+          return size <= pte_slab_classes[cls].size ? cls : -1;
+        }
+    }
+
+  return -1;
+}
+
+
+static int
+pte_slab_grow (pte_slab_class_t * c)
+{
+  /*
+   * Adds a chunk's slots to the free list. Called without the lock.
+   */
+  pte_slab_chunk_t * chunk;
+  pte_slab_slot_t * head = NULL;
+  pte_slab_slot_t * tail = NULL;
+  size_t count = PTE_SLAB_CHUNK / c->size;
+  size_t bytes;
+  char *slot;
+  size_t i;
+
+  if (count == 0)
+    {
+      count = 1;
+    }
+
+  bytes = sizeof (pte_slab_chunk_t) + PTE_SLAB_ALIGN - 1 + count * c->size;
+
+  chunk = (pte_slab_chunk_t *) pte_alloc (PTE_ALLOC_SLAB, bytes);
+
+  if (chunk == NULL)
+    {
+      return ENOMEM;
+    }
+
+  chunk->size = bytes;
+
+  slot = (char *) PTE_SLAB_ROUND ((size_t) (chunk + 1));
+
+  for (i = 0; i < count; i++, slot += c->size)
+    {
+      pte_slab_slot_t * s = (pte_slab_slot_t *) slot;
+
+      s->next = NULL;
+
+      if (tail == NULL)
+        {
+          head = s;
+        }
+      else
+        {
+          tail->next = s;
+        }
+
+      tail = s;
+    }
+
+  pte_osMutexLock (c->lock);
+  chunk->next = c->chunks;
+  c->chunks = chunk;
+  tail->next = c->free;
+  c->free = head;
+  c->freeCount += (int) count;
+  c->slots += (int) count;
+  pte_osMutexUnlock (c->lock);
+
+  return 0;
+}
+
+
+static int
+pte_slab_take (pte_slab_class_t * c, void **slots, int n)
+{
+  /*
+   * Moves up to 'n' free slots to 'slots', growing the cache if it
+   * is empty. Returns the number moved, 0 only if out of memory.
+   */
+  int taken = 0;
+
+  for (;;)
+    {
+      pte_osMutexLock (c->lock);
+
+      while (taken < n && c->free != NULL)
+        {
+          slots[taken++] = (void *) c->free;
+          c->free = c->free->next;
+          c->freeCount--;
+        }
+
+      pte_osMutexUnlock (c->lock);
+
+      if (taken > 0 || pte_slab_grow (c) != 0)
+        {
+          return taken;
+        }
+    }
+}
+
+
+static void
+pte_slab_give (pte_slab_class_t * c, void **slots, int n)
+{
+  int i;
+
+  pte_osMutexLock (c->lock);
+
+  for (i = 0; i < n; i++)
+    {
+      pte_slab_slot_t * s = (pte_slab_slot_t *) slots[i];
+
+      s->next = c->free;
+      c->free = s;
+    }
+
+  c->freeCount += n;
+
+  pte_osMutexUnlock (c->lock);
+}
+
+
+static pte_slab_magazine_t *
+pte_slab_magazine (int create)
+{
+  /*
+   * Returns the calling thread's magazine, or NULL if it has none.
+   * One is only created for threads started by pthread_create(),
+   * since they are the ones certain to get to
+   * pte_slab_thread_exit(). An implicit thread (one the OS started,
+   * given a handle by pthread_self()) may exit without the library
+   * seeing it, and would strand the slots in its magazine, so it
+   * uses the shared free lists directly.
+   */
+  pte_slab_magazine_t * m;
+  pte_thread_t * sp;
+
+  m = (pte_slab_magazine_t *) pte_osTlsGetValue (pte_slab_key);
+
+  if (m == PTE_SLAB_NO_MAGAZINE)
+    {
+      return NULL;
+    }
+
+  if (m == NULL && create)
+    {
+      sp = (pte_thread_t *) pthread_getspecific (pte_selfThreadKey);
+
+      if (sp == NULL || sp->implicit)
+        {
+          return NULL;
+        }
+
+      m = (pte_slab_magazine_t *) pte_alloc (PTE_ALLOC_MISC, sizeof (*m));
+
+      if (m != NULL)
+        {
+          pte_osTlsSetValue (pte_slab_key, m);
+        }
+    }
+
+  return m;
+}
+
+
+void *
+pte_slab_get (int cls)
+{
+  pte_slab_class_t * c = &pte_slab_classes[cls];
+  pte_slab_magazine_t * m = pte_slab_magazine (1);
+  void *slot;
+
+  if (m == NULL)
+    {
+      return pte_slab_take (c, &slot, 1) ? slot : NULL;
+    }
+
+  if (m->count[cls] == 0)
+    {
+      m->count[cls] = pte_slab_take (c, m->slots[cls], PTE_SLAB_MAGAZINE / 2);
+
+      if (m->count[cls] == 0)
+        {
+          return NULL;
+        }
+    }
+
+  return m->slots[cls][--m->count[cls]];
+}
+
+
+void
+pte_slab_put (int cls, void *ptr)
+{
+  pte_slab_class_t * c = &pte_slab_classes[cls];
+  pte_slab_magazine_t * m = pte_slab_magazine (0);
+
+  if (m == NULL)
+    {
+      pte_slab_give (c, &ptr, 1);
+      return;
+    }
+
+  if (m->count[cls] == PTE_SLAB_MAGAZINE)
+    {
+      m->count[cls] -= PTE_SLAB_MAGAZINE / 2;
+      pte_slab_give (c, &m->slots[cls][m->count[cls]], PTE_SLAB_MAGAZINE / 2);
+    }
+
+  m->slots[cls][m->count[cls]++] = ptr;
+}
+
+
+void
+pte_slab_init (void)
+{
+  int cls;
+
+  for (cls = 0; cls < PTE_SLAB_CLASSES; cls++)
+    {
+      pte_osMutexCreate (&pte_slab_classes[cls].lock);
+    }
+
+  pte_osTlsAlloc (&pte_slab_key);
+}
+
+
+void
+pte_slab_thread_exit (void)
+{
+  /*
+   * Gives the calling thread's free slots back to the shared free
+   * lists. Any slots it frees from now on go straight there.
+   */
+  pte_slab_magazine_t * m = pte_slab_magazine (0);
+  int cls;
+
+  pte_osTlsSetValue (pte_slab_key, PTE_SLAB_NO_MAGAZINE);
+
+  if (m != NULL)
+    {
+      for (cls = 0; cls < PTE_SLAB_CLASSES; cls++)
+        {
+          pte_slab_give (&pte_slab_classes[cls], m->slots[cls], m->count[cls]);
+        }
+
+      pte_free (PTE_ALLOC_MISC, m, sizeof (*m));
+    }
+}
+
+
+void
+pte_slab_flush (void)
+{
+  /*
+   * Frees the chunks of every type whose slots are all free. Slots
+   * still held by objects or by other threads' magazines keep their
+   * type's chunks alive.
+   */
+  int cls;
+
+  pte_slab_thread_exit ();
+  pte_osTlsSetValue (pte_slab_key, NULL);
+  pte_osTlsFree (pte_slab_key);
+
+  for (cls = 0; cls < PTE_SLAB_CLASSES; cls++)
+    {
+      pte_slab_class_t * c = &pte_slab_classes[cls];
+      pte_slab_chunk_t * chunk = NULL;
+
+      pte_osMutexLock (c->lock);
+
+      if (c->freeCount == c->slots)
+        {
+          chunk = c->chunks;
+          c->chunks = NULL;
+          c->free = NULL;
+          c->freeCount = 0;
+          c->slots = 0;
+        }
+
+      pte_osMutexUnlock (c->lock);
+
+      while (chunk != NULL)
+        {
+          pte_slab_chunk_t * next = chunk->next;
+
+          pte_free (PTE_ALLOC_SLAB, chunk, chunk->size);
+          chunk = next;
+        }
+    }
+}
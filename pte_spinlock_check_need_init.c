@@ -47,43 +47,63 @@
 int
 pte_spinlock_check_need_init (pthread_spinlock_t * lock)
 {
-  int result = 0;
+  int result;
+  pthread_spinlock_t s;
 
   /*
-   * The following guarded test is specifically for statically
+   * The following test is specifically for statically
    * initialised spinlocks (via PTHREAD_SPINLOCK_INITIALIZER).
    *
-   * Note that by not providing this synchronisation we risk
-   * introducing race conditions into applications which are
-   * correctly written.
-   */
-
-
-  pte_osMutexLock (pte_spinlock_test_init_lock);
-
-  /*
-   * We got here possibly under race
-   * conditions. Check again inside the critical section
-   * and only initialise if the spinlock is valid (not been destroyed).
+   * The spinlock is built privately and installed with a single
+   * compare-and-exchange; see pte_mutex_check_need_init().
+   *
    * If a static spinlock has been destroyed, the application can
    * re-initialise it only by calling pthread_spin_init()
    * explicitly.
    */
-  if (*lock == PTHREAD_SPINLOCK_INITIALIZER)
+  if (*lock == NULL)
     {
-      result = pthread_spin_init (lock, PTHREAD_PROCESS_PRIVATE);
+      /*
+       * The spinlock has been destroyed, so the operation that
+       * caused the auto-initialisation should fail.
+       */
+      return EINVAL;
     }
-  else if (*lock == NULL)
+
+  if (*lock != PTHREAD_SPINLOCK_INITIALIZER)
     {
       /*
-       * The spinlock has been destroyed while we were waiting to
-       * initialise it, so the operation that caused the
-       * auto-initialisation should fail.
+       * Another thread has initialised it.
        */
-      result = EINVAL;
+      return 0;
+    }
+
+  if ((result = pthread_spin_init (&s, PTHREAD_PROCESS_PRIVATE)) != 0)
+    {
+      return result;
+    }
+
+#ifdef PTE_SYNC_REGISTRY
+  if (s->syncEntry != NULL)
+    {
+      s->syncEntry->tag = "PTHREAD_SPINLOCK_INITIALIZER";
     }
+#endif
 
-  pte_osMutexUnlock(pte_spinlock_test_init_lock);
+  if (PTE_ATOMIC_COMPARE_EXCHANGE_PTR ((void * volatile *) lock, (void *) s,
+                                       (void *) PTHREAD_SPINLOCK_INITIALIZER)
+      != (void *) PTHREAD_SPINLOCK_INITIALIZER)
+    {
+      /*
+       * Lost the race, or the spinlock was destroyed meanwhile.
+       */
+      (void) pthread_spin_destroy (&s);
+
+      if (*lock == NULL)
+        {
+          result = EINVAL;
+        }
+    }
 
   return (result);
 }
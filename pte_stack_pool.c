@@ -0,0 +1,289 @@
+/*
+ * pte_stack_pool.c
+ *
+ * Description:
+ * This translation unit implements the library managed pool of thread
+ * stacks (see pthread_setstackpool_np).
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdlib.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+/*
+ * Pooled stack sizes are rounded up to this many bytes so that
+ * threads asking for similar sizes can share stacks.
+ */
+#define PTE_STACK_POOL_ROUND 4096
+
+/*
+ * A free stack. The link is kept in the (unused) stack memory itself.
+ */
+typedef struct pte_pooled_stack_t_ pte_pooled_stack_t;
+
+struct pte_pooled_stack_t_
+  {
+    pte_pooled_stack_t * next;
+    unsigned int stackSize;
+  };
+
+/*
+ * A stack still in use by a thread that has destroyed itself.
+ * The OS thread has exited but has not been deleted. Like the link
+ * of a free stack, the record lives at the lowest address of the
+ * stack: a thread on its way out is running near the top, so
+ * retiring needs no allocation and cannot fail.
+ */
+typedef struct pte_retired_stack_t_ pte_retired_stack_t;
+
+struct pte_retired_stack_t_
+  {
+    pte_retired_stack_t * next;
+    pte_osThreadHandle threadId;
+    void *stackAddr;
+    unsigned int stackSize;
+  };
+
+static pte_pooled_stack_t * pte_stack_pool_free = NULL;
+static int pte_stack_pool_count = 0;
+static int pte_stack_pool_inuse = 0;
+static pte_retired_stack_t * pte_stack_pool_retired = NULL;
+
+
+static void
+pte_stack_pool_reap (void)
+{
+  pte_retired_stack_t * retired;
+  pte_retired_stack_t * keep = NULL;
+
+  pte_osMutexLock (pte_stack_pool_lock);
+  retired = pte_stack_pool_retired;
+  pte_stack_pool_retired = NULL;
+  pte_osMutexUnlock (pte_stack_pool_lock);
+
+  while (retired != NULL)
+    {
+      pte_retired_stack_t * next = retired->next;
+
+      /*
+       * The thread is at most a few instructions from the end of
+       * pte_osThreadExit(), so this wait is short.
+       */
+      if (pte_osThreadWaitForEnd (retired->threadId) == PTE_OS_OK)
+        {
+          pte_osThreadDelete (retired->threadId);
+
+          /* This reuses the record's memory */
+          pte_stack_pool_put (retired->stackAddr, retired->stackSize);
+        }
+      else
+        {
+          retired->next = keep;
+          keep = retired;
+        }
+
+      retired = next;
+    }
+
+  if (keep != NULL)
+    {
+      pte_osMutexLock (pte_stack_pool_lock);
+
+      while (keep != NULL)
+        {
+          retired = keep->next;
+          keep->next = pte_stack_pool_retired;
+          pte_stack_pool_retired = keep;
+          keep = retired;
+        }
+
+      pte_osMutexUnlock (pte_stack_pool_lock);
+    }
+}
+
+
+void *
+pte_stack_pool_get (unsigned int *stackSize)
+{
+  /*
+   * Returns a stack of at least *stackSize bytes, updating *stackSize
+   * to its actual size, or NULL if the pool is disabled.
+   */
+  pte_pooled_stack_t ** link;
+  pte_pooled_stack_t * stack = NULL;
+  unsigned int size = *stackSize;
+  void *stackAddr = NULL;
+
+  if (pte_stack_pool_max <= 0)
+    {
+      return NULL;
+    }
+
+  if (pte_stack_pool_retired != NULL)
+    {
+      pte_stack_pool_reap ();
+    }
+
+  if (size < PTHREAD_STACK_MIN)
+    {
+      size = PTHREAD_STACK_MIN;
+    }
+
+  size = (size + PTE_STACK_POOL_ROUND - 1) & ~(PTE_STACK_POOL_ROUND - 1);
+
+  pte_osMutexLock (pte_stack_pool_lock);
+
+  for (link = &pte_stack_pool_free; *link != NULL; link = &(*link)->next)
+    {
+      if ((*link)->stackSize == size)
+        {
+          stack = *link;
+          *link = stack->next;
+          pte_stack_pool_count--;
+          break;
+        }
+    }
+
+  pte_osMutexUnlock (pte_stack_pool_lock);
+
+  if (stack != NULL)
+    {
+      stackAddr = (void *) stack;
+    }
+  else if (pte_osStackAlloc (size, pte_stack_pool_guard, &stackAddr) != PTE_OS_OK)
+    {
+      return NULL;
+    }
+
+  (void) PTE_ATOMIC_INCREMENT (&pte_stack_pool_inuse);
+
+  *stackSize = size;
+
+  return stackAddr;
+}
+
+
+void
+pte_stack_pool_put (void *stackAddr, unsigned int stackSize)
+{
+  pte_pooled_stack_t * stack = (pte_pooled_stack_t *) stackAddr;
+
+  (void) PTE_ATOMIC_DECREMENT (&pte_stack_pool_inuse);
+
+  pte_osMutexLock (pte_stack_pool_lock);
+
+  if (pte_stack_pool_count < pte_stack_pool_max)
+    {
+      stack->next = pte_stack_pool_free;
+      stack->stackSize = stackSize;
+      pte_stack_pool_free = stack;
+      pte_stack_pool_count++;
+      stack = NULL;
+    }
+
+  pte_osMutexUnlock (pte_stack_pool_lock);
+
+  if (stack != NULL)
+    {
+      pte_osStackFree (stackAddr, stackSize, pte_stack_pool_guard);
+    }
+}
+
+
+void
+pte_stack_pool_retire (pte_osThreadHandle threadId,
+                       void *stackAddr, unsigned int stackSize)
+{
+  /*
+   * Called by a thread that is about to exit on a pooled stack.
+   * The caller must then call pte_osThreadExit() and leave its
+   * deletion to pte_stack_pool_reap().
+   */
+  pte_retired_stack_t * retired = (pte_retired_stack_t *) stackAddr;
+
+  retired->threadId = threadId;
+  retired->stackAddr = stackAddr;
+  retired->stackSize = stackSize;
+
+  pte_osMutexLock (pte_stack_pool_lock);
+  retired->next = pte_stack_pool_retired;
+  pte_stack_pool_retired = retired;
+  pte_osMutexUnlock (pte_stack_pool_lock);
+}
+
+
+int
+pte_stack_pool_busy (void)
+{
+  /*
+   * Non-zero while any thread, running or exited but not yet
+   * collected, holds a pooled stack.
+   */
+  return pte_stack_pool_inuse != 0;
+}
+
+
+void
+pte_stack_pool_flush (void)
+{
+  /*
+   * Frees every cached stack. Stacks of exited threads are
+   * collected first.
+   */
+  pte_pooled_stack_t * stack;
+
+  if (pte_stack_pool_retired != NULL)
+    {
+      pte_stack_pool_reap ();
+    }
+
+  pte_osMutexLock (pte_stack_pool_lock);
+  stack = pte_stack_pool_free;
+  pte_stack_pool_free = NULL;
+  pte_stack_pool_count = 0;
+  pte_osMutexUnlock (pte_stack_pool_lock);
+
+  while (stack != NULL)
+    {
+      pte_pooled_stack_t * next = stack->next;
+
+      pte_osStackFree ((void *) stack, stack->stackSize, pte_stack_pool_guard);
+      stack = next;
+    }
+}
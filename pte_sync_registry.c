@@ -0,0 +1,166 @@
+/*
+ * pte_sync_registry.c
+ *
+ * Description:
+ * This translation unit implements the sync object registry (see
+ * pte_dump_sync_stats_np).
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <limits.h>
+#include <string.h>
+
+#include <pte_osal.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+#ifdef PTE_SYNC_REGISTRY
+
+pte_sync_entry_t *
+pte_sync_register (int type, const void *object)
+/*
+ * Claims a free entry for a new object. Searches start at a different
+ * entry for each call, so creators rarely contend for the same one.
+ * Returns NULL, and counts the object as dropped, if the table is full.
+ */
+{
+  unsigned int start;
+  unsigned int i;
+
+  start = (unsigned int) PTE_ATOMIC_EXCHANGE_ADD (&pte_sync_registry_next, 1);
+
+  for (i = 0; i < PTE_SYNC_REGISTRY_SIZE; i++)
+    {
+      pte_sync_entry_t * entry =
+        &pte_sync_registry[(start + i) % PTE_SYNC_REGISTRY_SIZE];
+
+      if (entry->state == PTE_SYNC_FREE &&
+          PTE_ATOMIC_COMPARE_EXCHANGE (&entry->state,
+                                       PTE_SYNC_CLAIMED,
+                                       PTE_SYNC_FREE) == PTE_SYNC_FREE)
+        {
+          entry->type = type;
+          entry->object = object;
+          entry->tag = NULL;
+          entry->owner = NULL;
+          entry->waits = 0;
+          entry->waitMax = 0;
+          memset (entry->hist, 0, sizeof (entry->hist));
+
+          (void) PTE_ATOMIC_EXCHANGE (&entry->state, PTE_SYNC_LIVE);
+
+          return entry;
+        }
+    }
+
+  (void) PTE_ATOMIC_INCREMENT (&pte_sync_registry_dropped);
+
+  return NULL;
+}
+
+
+void
+pte_sync_unregister (pte_sync_entry_t * entry)
+{
+  if (entry != NULL)
+    {
+      (void) PTE_ATOMIC_EXCHANGE (&entry->state, PTE_SYNC_FREE);
+    }
+}
+
+
+void
+pte_sync_adopt (pte_sync_entry_t * entry, pte_sync_entry_t * owner)
+/*
+ * Marks 'entry' as part of the object registered as 'owner'. Its waits
+ * are counted against the owner, and it is left out of reports.
+ */
+{
+  if (entry != NULL && owner != NULL)
+    {
+      entry->owner = owner;
+      (void) PTE_ATOMIC_EXCHANGE (&entry->state, PTE_SYNC_INTERNAL);
+    }
+}
+
+
+void
+pte_sync_waited (pte_sync_entry_t * entry, unsigned long long start)
+/*
+ * Records a wait that began at 'start' (from pte_osClockGetMicros)
+ * and has just ended.
+ */
+{
+  unsigned long long elapsed;
+  int usecs;
+  int bucket;
+  int old;
+  int prev;
+
+  if (entry == NULL)
+    {
+      return;
+    }
+
+  elapsed = pte_osClockGetMicros () - start;
+  usecs = (elapsed > INT_MAX ? INT_MAX : (int) elapsed);
+
+  while (entry->owner != NULL)
+    {
+      entry = entry->owner;
+    }
+
+  for (bucket = 0;
+       bucket < PTE_SYNC_HIST_BUCKETS - 1 && (usecs >> (bucket + 1)) != 0;
+       bucket++)
+    {
+    }
+
+  (void) PTE_ATOMIC_INCREMENT (&entry->waits);
+  (void) PTE_ATOMIC_INCREMENT (&entry->hist[bucket]);
+
+  old = entry->waitMax;
+
+  while (usecs > old &&
+         (prev = PTE_ATOMIC_COMPARE_EXCHANGE (&entry->waitMax, usecs, old)) != old)
+    {
+      old = prev;
+    }
+}
+
+#endif /* PTE_SYNC_REGISTRY */
@@ -0,0 +1,166 @@
+/*
+ * pte_sync_reporter_np.c
+ *
+ * Description:
+ * This translation unit implements the periodic sync statistics
+ * reporter thread.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdio.h>
+
+#include <pte_osal.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+#ifdef PTE_SYNC_REGISTRY
+
+/* Protected by pte_sync_reporter_lock */
+static int pte_sync_reporter_running = 0;
+static pthread_t pte_sync_reporter_thread;
+static pte_osSemaphoreHandle pte_sync_reporter_wake;
+static FILE * pte_sync_reporter_stream;
+static unsigned int pte_sync_reporter_interval;
+
+
+static void *
+pte_sync_reporter (void *arg)
+{
+  for (;;)
+    {
+      unsigned int timeout = pte_sync_reporter_interval;
+
+      /* Only a request to stop posts the semaphore */
+      if (pte_osSemaphorePend (pte_sync_reporter_wake, &timeout) == PTE_OS_OK)
+        {
+          break;
+        }
+
+      (void) pte_dump_sync_stats_np (pte_sync_reporter_stream);
+    }
+
+  return NULL;
+}
+
+#endif
+
+
+int
+pte_sync_reporter_np (FILE * stream, unsigned int intervalMsecs)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function starts or stops a background thread that
+ *      prints the sync statistics report periodically.
+ *
+ * PARAMETERS
+ *      stream
+ *              stdio stream to print to
+ *
+ *      intervalMsecs
+ *              time between reports in milliseconds; zero
+ *              stops the reporter.
+ *
+ *
+ * DESCRIPTION
+ *      The thread calls pte_dump_sync_stats_np() every
+ *      'intervalMsecs' milliseconds. Calling this function
+ *      again while the reporter is running replaces it with
+ *      one using the new stream and interval. The reporter is
+ *      stopped by pthread_terminate().
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully started or stopped,
+ *              EINVAL          'stream' is NULL and 'intervalMsecs'
+ *                              is not zero,
+ *              EAGAIN          insufficient resources to start
+ *                              the thread,
+ *              ENOTSUP         library built without PTE_SYNC_REGISTRY.
+ *
+ * ------------------------------------------------------
+ */
+{
+#ifdef PTE_SYNC_REGISTRY
+  int result = 0;
+
+  if (stream == NULL && intervalMsecs != 0)
+    {
+      return EINVAL;
+    }
+
+  pte_osMutexLock (pte_sync_reporter_lock);
+
+  if (pte_sync_reporter_running)
+    {
+      pte_osSemaphorePost (pte_sync_reporter_wake, 1);
+      (void) pthread_join (pte_sync_reporter_thread, NULL);
+      pte_osSemaphoreDelete (pte_sync_reporter_wake);
+      pte_sync_reporter_running = 0;
+    }
+
+  if (intervalMsecs != 0)
+    {
+      pte_sync_reporter_stream = stream;
+      pte_sync_reporter_interval = intervalMsecs;
+
+      if (pte_osSemaphoreCreate (0, &pte_sync_reporter_wake) != PTE_OS_OK)
+        {
+          result = EAGAIN;
+        }
+      else if (pthread_create (&pte_sync_reporter_thread, NULL,
+                               pte_sync_reporter, NULL) != 0)
+        {
+          pte_osSemaphoreDelete (pte_sync_reporter_wake);
+          result = EAGAIN;
+        }
+      else
+        {
+          pte_sync_reporter_running = 1;
+        }
+    }
+
+  pte_osMutexUnlock (pte_sync_reporter_lock);
+
+  return result;
+#else
+  return ENOTSUP;
+#endif
+}
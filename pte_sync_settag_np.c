@@ -0,0 +1,115 @@
+/*
+ * pte_sync_settag_np.c
+ *
+ * Description:
+ * This translation unit implements tagging registered sync objects.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_sync_settag_np (const void *object, const char *tag)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function names a mutex, rwlock, condition
+ *      variable, semaphore, spin lock or barrier in sync
+ *      statistics reports.
+ *
+ * PARAMETERS
+ *      object
+ *              the object's handle, e.g. a pthread_mutex_t
+ *              or sem_t value (not its address)
+ *
+ *      tag
+ *              string printed with the object's statistics,
+ *              or NULL for none. The string is not copied and
+ *              must outlive the object.
+ *
+ *
+ * DESCRIPTION
+ *      Use PTE_SYNC_SITE as the tag to record where the
+ *      object was created, e.g.
+ *
+ *              pthread_mutex_init (&m, NULL);
+ *              pte_sync_settag_np (m, PTE_SYNC_SITE);
+ *
+ *      A statically initialised object is registered when it
+ *      is first used, and tagged with the name of its
+ *      initializer until this function is called.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully tagged,
+ *              EINVAL          'object' is NULL,
+ *              ESRCH           'object' is not registered, either
+ *                              because it is not initialised or
+ *                              because the registry was full,
+ *              ENOTSUP         library built without PTE_SYNC_REGISTRY.
+ *
+ * ------------------------------------------------------
+ */
+{
+#ifdef PTE_SYNC_REGISTRY
+  int i;
+
+  if (object == NULL)
+    {
+      return EINVAL;
+    }
+
+  for (i = 0; i < PTE_SYNC_REGISTRY_SIZE; i++)
+    {
+      pte_sync_entry_t * entry = &pte_sync_registry[i];
+
+      if (entry->state == PTE_SYNC_LIVE && entry->object == object)
+        {
+          entry->tag = tag;
+          return 0;
+        }
+    }
+
+  return ESRCH;
+#else
+  return ENOTSUP;
+#endif
+}
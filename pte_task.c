@@ -0,0 +1,464 @@
+/*
+ * pte_task.c
+ *
+ * Description:
+ * This translation unit implements the work-stealing task scheduler
+ * internals: worker deques, stealing, task running and the worker routine.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdlib.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+
+/*
+ * As in pte_pool.c, the pte_osAtomic* operations are full memory
+ * barriers and deque indices wrap, so they are compared by their
+ * difference.
+ */
+#define PTE_TASK_DIFF(a, b) ((int) ((unsigned int) (a) - (unsigned int) (b)))
+#define PTE_TASK_ADD(a, n)  ((int) ((unsigned int) (a) + (unsigned int) (n)))
+#define PTE_TASK_SLOT(i)    ((unsigned int) (i) & (PTE_TASK_DEQUE_SIZE - 1))
+
+
+pte_task_t
+pte_task_alloc (pte_task_worker_t * w)
+/*
+ * Get a task from the calling worker's cache, or allocate one.
+ * 'w' is NULL if the caller is not a worker.
+ */
+{
+  pte_task_t task;
+
+  if (w != NULL && w->freeTasks != NULL)
+    {
+      task = w->freeTasks;
+      w->freeTasks = task->next;
+      w->nfree--;
+      return task;
+    }
+
+  return (pte_task_t) pte_alloc (PTE_ALLOC_POOL, sizeof (*task));
+}
+
+
+void
+pte_task_free (pte_task_worker_t * w, pte_task_t task)
+{
+  if (w != NULL && w->nfree < PTE_TASK_CACHE)
+    {
+      task->next = w->freeTasks;
+      w->freeTasks = task;
+      w->nfree++;
+      return;
+    }
+
+  pte_free (PTE_ALLOC_POOL, task, sizeof (*task));
+}
+
+
+int
+pte_task_push (pte_task_worker_t * w, pte_task_t task)
+/*
+ * Push a task on the bottom of the calling worker's own deque.
+ *
+ * Returns 0 or EAGAIN if the deque is full.
+ */
+{
+  int b = w->bottom;
+
+  /* A stale 'top' only makes the deque look fuller than it is */
+  if (PTE_TASK_DIFF (b, w->top) >= PTE_TASK_DEQUE_SIZE)
+    {
+      return EAGAIN;
+    }
+
+  w->deque[PTE_TASK_SLOT (b)] = task;
+  (void) PTE_ATOMIC_EXCHANGE (&w->bottom, PTE_TASK_ADD (b, 1));
+
+  return 0;
+}
+
+
+pte_task_t
+pte_task_pop (pte_task_worker_t * w)
+/*
+ * Pop the newest task from the bottom of the calling worker's own
+ * deque, or return NULL if it is empty.
+ */
+{
+  int b = PTE_TASK_ADD (w->bottom, -1);
+  int t;
+  int dif;
+  pte_task_t task;
+
+  /* Claim the bottom slot before looking at 'top' */
+  (void) PTE_ATOMIC_EXCHANGE (&w->bottom, b);
+
+  t = w->top;
+  dif = PTE_TASK_DIFF (b, t);
+
+  if (dif < 0)
+    {
+      (void) PTE_ATOMIC_EXCHANGE (&w->bottom, PTE_TASK_ADD (b, 1));
+      return NULL;
+    }
+
+  task = w->deque[PTE_TASK_SLOT (b)];
+
+  if (dif == 0)
+    {
+      /* Last task: race any thief for it */
+      if (PTE_ATOMIC_COMPARE_EXCHANGE (&w->top, PTE_TASK_ADD (t, 1), t) != t)
+        {
+          task = NULL;
+        }
+
+      (void) PTE_ATOMIC_EXCHANGE (&w->bottom, PTE_TASK_ADD (t, 1));
+    }
+
+  return task;
+}
+
+
+static pte_task_t
+pte_task_steal_from (pte_task_worker_t * v)
+/*
+ * Take the oldest task from the top of victim 'v's deque. Returns
+ * NULL if it is empty or another thread took the task first.
+ */
+{
+  int t = PTE_ATOMIC_EXCHANGE_ADD (&v->top, 0);
+  int b = v->bottom;
+  pte_task_t task;
+
+  if (PTE_TASK_DIFF (b, t) <= 0)
+    {
+      return NULL;
+    }
+
+  task = v->deque[PTE_TASK_SLOT (t)];
+
+  if (PTE_ATOMIC_COMPARE_EXCHANGE (&v->top, PTE_TASK_ADD (t, 1), t) != t)
+    {
+      return NULL;
+    }
+
+  return task;
+}
+
+
+pte_task_t
+pte_task_steal (pte_task_worker_t * w)
+/*
+ * Find work for worker 'w', whose own deque is empty: first the
+ * injection list, then the other workers' deques starting from a
+ * random victim.
+ */
+{
+  pte_task_sched_t * s = &pte_task_sched;
+  pte_task_t task = NULL;
+  int start;
+  int i;
+
+  if (s->injectHead != NULL)
+    {
+      pte_osMutexLock (pte_task_lock);
+
+      task = s->injectHead;
+      if (task != NULL)
+        {
+          s->injectHead = task->next;
+          if (s->injectHead == NULL)
+            {
+              s->injectTail = NULL;
+            }
+        }
+
+      pte_osMutexUnlock (pte_task_lock);
+
+      if (task != NULL)
+        {
+          return task;
+        }
+    }
+
+  w->seed = w->seed * 1103515245 + 12345;
+  start = (int) ((w->seed >> 16) % (unsigned int) s->nworkers);
+
+  for (i = 0; i < s->nworkers; i++)
+    {
+      pte_task_worker_t * v = &s->workers[(start + i) % s->nworkers];
+
+      if (v != w && (task = pte_task_steal_from (v)) != NULL)
+        {
+          break;
+        }
+    }
+
+  return task;
+}
+
+
+void
+pte_task_inject (pte_task_t task)
+/*
+ * Queue a task spawned by a thread that is not a worker.
+ */
+{
+  pte_task_sched_t * s = &pte_task_sched;
+
+  task->next = NULL;
+
+  pte_osMutexLock (pte_task_lock);
+
+  if (s->injectTail != NULL)
+    {
+      s->injectTail->next = task;
+    }
+  else
+    {
+      s->injectHead = task;
+    }
+  s->injectTail = task;
+
+  pte_osMutexUnlock (pte_task_lock);
+}
+
+
+void
+pte_task_notify (void)
+/*
+ * Called after making a task available: wake a parked worker.
+ */
+{
+  pte_task_sched_t * s = &pte_task_sched;
+
+  if (s->sleepers > 0)
+    {
+      pte_pool_wake (&s->sleepers, s->workSem, 0);
+    }
+}
+
+
+void
+pte_task_run (pte_thread_t * sp, pte_task_t task)
+/*
+ * Run a task on the calling worker and mark it done.
+ *
+ * Tasks run with cancelability disabled: a cancellation request for
+ * the worker is not acted upon, and so can't cut short whichever
+ * task happens to be running. A task that calls pthread_exit() ends
+ * only itself, popping only the cleanup handlers it pushed, even if
+ * it was run by a worker waiting in pte_task_sync_np() for another.
+ */
+{
+  (void) pte_pool_run (sp, task->routine, task->arg, PTHREAD_CANCEL_DISABLE);
+
+  switch (PTE_ATOMIC_EXCHANGE (&task->state, PTE_TASK_DONE))
+    {
+    case PTE_TASK_WAITING:
+      /* The syncing thread stays parked, so the task is intact, until this */
+      (void) pte_osSemaphorePost (task->waitSem, 1);
+      break;
+
+    case PTE_TASK_ABANDONED:
+      /* Nobody will sync it */
+      pte_task_free ((pte_task_worker_t *) sp->taskWorker, task);
+      break;
+    }
+}
+
+
+int
+pte_task_park (pte_thread_t * sp, pte_task_t task)
+/*
+ * Block the calling thread until 'task' is done.
+ *
+ * The syncing thread parks on a semaphore of its own, named in the
+ * task, and the thread finishing the task posts it exactly once. A
+ * shared semaphore would not do: wakeups are anonymous, so a thread
+ * waiting for one task could take the wakeup meant for another.
+ *
+ * Returns 0, or EAGAIN if no semaphore could be created.
+ */
+{
+  if (!sp->parkSemValid)
+    {
+      if (pte_osSemaphoreCreate (0, &sp->parkSem) != PTE_OS_OK)
+        {
+          return EAGAIN;
+        }
+      sp->parkSemValid = 1;
+    }
+
+  task->waitSem = sp->parkSem;
+
+  if (PTE_ATOMIC_COMPARE_EXCHANGE (&task->state,
+                                   PTE_TASK_WAITING,
+                                   PTE_TASK_QUEUED) != PTE_TASK_QUEUED)
+    {
+      /* Already done */
+      return 0;
+    }
+
+  if (sp->taskWorker != NULL)
+    {
+      PTE_TRACE (PTE_TRACE_BLOCK, task);
+      (void) pte_osSemaphorePend (sp->parkSem, NULL);
+      PTE_TRACE (PTE_TRACE_WAKE, task);
+    }
+  else
+    {
+      (void) pte_cancellable_wait (sp->parkSem, NULL, task);
+    }
+
+  return 0;
+}
+
+
+void
+pte_task_stop (int nstarted)
+/*
+ * Stop the first 'nstarted' workers and free the scheduler. The
+ * caller has set pte_task_sched.shutdown and does not hold
+ * pte_task_lock.
+ */
+{
+  pte_task_sched_t * s = &pte_task_sched;
+  pte_task_t task;
+  int i;
+
+  pte_pool_wake (&s->sleepers, s->workSem, 1);
+
+  for (i = 0; i < nstarted; i++)
+    {
+      (void) pthread_join (s->workers[i].thread, NULL);
+    }
+
+  for (i = 0; i < s->nworkers; i++)
+    {
+      while ((task = s->workers[i].freeTasks) != NULL)
+        {
+          s->workers[i].freeTasks = task->next;
+          pte_free (PTE_ALLOC_POOL, task, sizeof (*task));
+        }
+
+      pte_free (PTE_ALLOC_POOL, s->workers[i].deque,
+                PTE_TASK_DEQUE_SIZE * sizeof (pte_task_t));
+    }
+
+  pte_free (PTE_ALLOC_POOL, s->workers,
+            s->nworkers * sizeof (pte_task_worker_t));
+
+  (void) pte_osSemaphoreDelete (s->workSem);
+
+  pte_osMutexLock (pte_task_lock);
+  s->workers = NULL;
+  s->nworkers = 0;
+  s->running = 0;
+  pte_osMutexUnlock (pte_task_lock);
+}
+
+
+void *
+pte_task_worker (void *arg)
+{
+  pte_task_worker_t * w = (pte_task_worker_t *) arg;
+  pte_thread_t * sp = (pte_thread_t *) pthread_self ();
+  pte_task_sched_t * s = &pte_task_sched;
+  pte_task_t task;
+  int spins = 0;
+
+  sp->taskWorker = w;
+
+  for (;;)
+    {
+      task = pte_task_pop (w);
+
+      if (task == NULL)
+        {
+          task = pte_task_steal (w);
+        }
+
+      if (task != NULL)
+        {
+          pte_task_run (sp, task);
+          spins = 0;
+          continue;
+        }
+
+      if (s->shutdown)
+        {
+          break;
+        }
+
+      /* Work tends to arrive in bursts: keep looking for a while */
+      if (++spins < PTE_TASK_SPINS)
+        {
+          continue;
+        }
+
+      spins = 0;
+
+      /* See pte_pool_worker() */
+      (void) PTE_ATOMIC_INCREMENT (&s->sleepers);
+
+      task = pte_task_steal (w);
+
+      if (task != NULL)
+        {
+          pte_pool_unpark (&s->sleepers, s->workSem);
+          pte_task_run (sp, task);
+          continue;
+        }
+
+      if (s->shutdown)
+        {
+          pte_pool_unpark (&s->sleepers, s->workSem);
+          break;
+        }
+
+      (void) pte_osSemaphorePend (s->workSem, NULL);
+    }
+
+  sp->taskWorker = NULL;
+
+  return NULL;
+}
@@ -0,0 +1,168 @@
+/*
+ * pte_task_init_np.c
+ *
+ * Description:
+ * This translation unit implements work-stealing task scheduler primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdlib.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_task_init_np (int nworkers)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function starts the work-stealing task scheduler.
+ *
+ * PARAMETERS
+ *      nworkers
+ *              number of worker threads; zero or less means
+ *              one per processor.
+ *
+ *
+ * DESCRIPTION
+ *      Each worker keeps the tasks it spawns in its own deque
+ *      and runs the newest first. A worker with nothing to do
+ *      steals the oldest task from another worker, picked at
+ *      random, and parks on a semaphore if it finds nothing
+ *      for a while.
+ *
+ *      Calling this function is optional: the first
+ *      pte_task_spawn_np() starts the scheduler with one worker
+ *      per processor.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully started scheduler,
+ *              EBUSY           the scheduler is already running,
+ *              ENOMEM          insufficient memory,
+ *              EAGAIN          insufficient resources to
+ *                              start the workers.
+ *
+ * ------------------------------------------------------
+ */
+{
+  pte_task_sched_t * s = &pte_task_sched;
+  int result = 0;
+  int i;
+
+  if (nworkers <= 0)
+    {
+      nworkers = pthread_num_processors_np ();
+    }
+
+  pte_osMutexLock (pte_task_lock);
+
+  if (s->running)
+    {
+      pte_osMutexUnlock (pte_task_lock);
+      return EBUSY;
+    }
+
+  s->workers = (pte_task_worker_t *) pte_alloc (PTE_ALLOC_POOL,
+                                                nworkers * sizeof (pte_task_worker_t));
+
+  if (s->workers == NULL)
+    {
+      pte_osMutexUnlock (pte_task_lock);
+      return ENOMEM;
+    }
+
+  for (i = 0; i < nworkers; i++)
+    {
+      s->workers[i].deque = (pte_task_t *) pte_alloc (PTE_ALLOC_POOL,
+                                                      PTE_TASK_DEQUE_SIZE * sizeof (pte_task_t));
+      if (s->workers[i].deque == NULL)
+        {
+          result = ENOMEM;
+        }
+
+      s->workers[i].seed = (unsigned int) i + 1;
+    }
+
+  if (result == 0 && pte_osSemaphoreCreate (0, &s->workSem) != PTE_OS_OK)
+    {
+      result = EAGAIN;
+    }
+
+  if (result != 0)
+    {
+      for (i = 0; i < nworkers; i++)
+        {
+          pte_free (PTE_ALLOC_POOL, s->workers[i].deque,
+                    PTE_TASK_DEQUE_SIZE * sizeof (pte_task_t));
+        }
+      pte_free (PTE_ALLOC_POOL, s->workers,
+                nworkers * sizeof (pte_task_worker_t));
+      s->workers = NULL;
+
+      pte_osMutexUnlock (pte_task_lock);
+      return result;
+    }
+
+  s->nworkers = nworkers;
+  s->shutdown = 0;
+  s->sleepers = 0;
+  s->running = 1;
+
+  for (i = 0; i < nworkers; i++)
+    {
+      result = pthread_create (&s->workers[i].thread, NULL,
+                               pte_task_worker, &s->workers[i]);
+      if (result != 0)
+        {
+          break;
+        }
+    }
+
+  pte_osMutexUnlock (pte_task_lock);
+
+  if (result != 0)
+    {
+      (void) PTE_ATOMIC_EXCHANGE (&s->shutdown, 1);
+      pte_task_stop (i);
+    }
+
+  return result;
+}
@@ -0,0 +1,101 @@
+/*
+ * pte_task_shutdown_np.c
+ *
+ * Description:
+ * This translation unit implements work-stealing task scheduler primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_task_shutdown_np (void)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function stops the work-stealing task scheduler.
+ *
+ * PARAMETERS
+ *      N/A
+ *
+ *
+ * DESCRIPTION
+ *      The workers are woken, exit and are joined. Every
+ *      spawned task should have been synced beforehand. The
+ *      scheduler can be started again afterwards.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully stopped scheduler,
+ *              EINVAL          the scheduler is not running or
+ *                              is already stopping,
+ *              EDEADLK         called from a task.
+ *
+ * ------------------------------------------------------
+ */
+{
+  pte_task_sched_t * s = &pte_task_sched;
+  pte_thread_t * sp;
+
+  sp = (pte_thread_t *) pthread_getspecific (pte_selfThreadKey);
+
+  if (sp != NULL && sp->taskWorker != NULL)
+    {
+      return EDEADLK;
+    }
+
+  pte_osMutexLock (pte_task_lock);
+
+  if (!s->running || s->shutdown)
+    {
+      pte_osMutexUnlock (pte_task_lock);
+      return EINVAL;
+    }
+
+  (void) PTE_ATOMIC_EXCHANGE (&s->shutdown, 1);
+
+  /* Workers may need the lock to drain the injection list */
+  pte_osMutexUnlock (pte_task_lock);
+
+  pte_task_stop (s->nworkers);
+
+  return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * pte_task_spawn_np.c
+ *
+ * Description:
+ * This translation unit implements work-stealing task scheduler primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_task_spawn_np (pte_task_t * task,
+                   void (*routine) (void *),
+                   void *arg)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function makes a task available to the
+ *      work-stealing scheduler.
+ *
+ * PARAMETERS
+ *      task
+ *              pointer to an instance of pte_task_t, to be
+ *              passed to pte_task_sync_np()
+ *
+ *      routine
+ *              function to run
+ *
+ *      arg
+ *              argument passed to 'routine'
+ *
+ *
+ * DESCRIPTION
+ *      Called from a task, this pushes the new task on the
+ *      calling worker's own deque, where it is either popped
+ *      again by pte_task_sync_np() or stolen by an idle
+ *      worker. Called from any other thread, the task is
+ *      queued for the workers to pick up. If the worker's
+ *      deque is full the task is run at once.
+ *
+ *      Tasks run with cancelability disabled. A task that
+ *      calls pthread_exit() ends only itself; the cleanup
+ *      handlers it pushed are run, those of the tasks below
+ *      it on the same worker are not.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ *              2)      The scheduler is started by the first call
+ *                      if pte_task_init_np() hasn't been called.
+ *
+ * RESULTS
+ *              0               successfully spawned task,
+ *              EINVAL          'task' or 'routine' is invalid, or
+ *                              the scheduler is stopping,
+ *              ENOMEM          insufficient memory,
+ *              EAGAIN          insufficient resources to
+ *                              start the scheduler.
+ *
+ * ------------------------------------------------------
+ */
+{
+  pte_task_sched_t * s = &pte_task_sched;
+  pte_thread_t * sp;
+  pte_task_worker_t * w = NULL;
+  pte_task_t t;
+  int result;
+
+  if (task == NULL || routine == NULL)
+    {
+      return EINVAL;
+    }
+
+  if (!s->running)
+    {
+      result = pte_task_init_np (0);
+
+      if (result != 0 && result != EBUSY)
+        {
+          return result;
+        }
+    }
+
+  if (s->shutdown)
+    {
+      return EINVAL;
+    }
+
+  sp = (pte_thread_t *) pthread_getspecific (pte_selfThreadKey);
+
+  if (sp != NULL)
+    {
+      w = (pte_task_worker_t *) sp->taskWorker;
+    }
+
+  t = pte_task_alloc (w);
+
+  if (t == NULL)
+    {
+      return ENOMEM;
+    }
+
+  t->routine = routine;
+  t->arg = arg;
+  t->state = PTE_TASK_QUEUED;
+
+  *task = t;
+
+  if (w == NULL)
+    {
+      pte_task_inject (t);
+    }
+  else if (pte_task_push (w, t) != 0)
+    {
+      pte_task_run (sp, t);
+      return 0;
+    }
+
+  pte_task_notify ();
+
+  return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * pte_task_sync_np.c
+ *
+ * Description:
+ * This translation unit implements work-stealing task scheduler primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+static void
+pte_task_abandon (void *arg)
+/*
+ * Cleanup handler for a thread cancelled while parked in
+ * pte_task_sync_np(). Whichever of this thread and the one finishing
+ * the task comes second frees it.
+ */
+{
+  pte_task_t task = (pte_task_t) arg;
+  pte_thread_t * sp = (pte_thread_t *) pthread_self ();
+
+  if (PTE_ATOMIC_COMPARE_EXCHANGE (&task->state,
+                                   PTE_TASK_ABANDONED,
+                                   PTE_TASK_WAITING) == PTE_TASK_DONE)
+    {
+      /* Take the post meant for us so it can't wake a later park */
+      (void) pte_osSemaphorePend (sp->parkSem, NULL);
+      pte_task_free (NULL, task);
+    }
+}
+
+
+int
+pte_task_sync_np (pte_task_t task)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function waits for a task spawned with
+ *      pte_task_spawn_np() to finish, and releases it.
+ *
+ * PARAMETERS
+ *      task
+ *              task to wait for
+ *
+ *
+ * DESCRIPTION
+ *      Called from a task, the worker runs other tasks while
+ *      it waits: its own newest first, which is usually the
+ *      one being waited for, then stolen ones. Only when there
+ *      is nothing to run does it park until the task is done.
+ *
+ *      Called from any other thread, this function blocks
+ *      and is a cancellation point. If the thread is
+ *      cancelled the task still runs, and is released when it
+ *      finishes.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ *              2)      'task' may not be used afterwards.
+ *
+ * RESULTS
+ *              0               the task has finished,
+ *              EINVAL          'task' is invalid,
+ *              EAGAIN          insufficient resources to block;
+ *                              'task' was not released.
+ *
+ * ------------------------------------------------------
+ */
+{
+  pte_thread_t * sp;
+  pte_task_worker_t * w;
+  pte_task_t other;
+  int spins = 0;
+  int result = 0;
+
+  if (task == NULL)
+    {
+      return EINVAL;
+    }
+
+  sp = (pte_thread_t *) pthread_self ();
+
+  if (sp == NULL)
+    {
+      return EAGAIN;
+    }
+
+  w = (pte_task_worker_t *) sp->taskWorker;
+
+  if (w != NULL)
+    {
+      while (task->state != PTE_TASK_DONE)
+        {
+          other = pte_task_pop (w);
+
+          if (other == NULL)
+            {
+              other = pte_task_steal (w);
+            }
+
+          if (other != NULL)
+            {
+              pte_task_run (sp, other);
+              spins = 0;
+              continue;
+            }
+
+          if (++spins < PTE_TASK_SPINS)
+            {
+              continue;
+            }
+
+          /* Nothing to help with: the task is running elsewhere */
+          if (pte_task_park (sp, task) == 0)
+            {
+              break;
+            }
+
+          spins = 0;
+        }
+    }
+  else
+    {
+      pthread_cleanup_push (pte_task_abandon, (void *) task);
+
+      result = pte_task_park (sp, task);
+
+      pthread_cleanup_pop (0);
+
+      if (result != 0)
+        {
+          return result;
+        }
+    }
+
+  pte_task_free (w, task);
+
+  return 0;
+}
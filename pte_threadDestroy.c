@@ -63,15 +63,38 @@ pte_threadDestroyCommon (pthread_t thread, unsigned char shouldThreadExit)
        */
       memcpy (&threadCopy, tp, sizeof (threadCopy));
 
-      free(tp);
+      pte_free (PTE_ALLOC_THREAD, tp, sizeof (*tp));
 
       (void) pthread_mutex_destroy(&threadCopy.cancelLock);
       (void) pthread_mutex_destroy(&threadCopy.threadLock);
 
+      if (threadCopy.parkSemValid)
+        {
+          (void) pte_osSemaphoreDelete(threadCopy.parkSem);
+        }
+
+      if (threadCopy.exitSemValid)
+        {
+          (void) pte_osSemaphoreDelete(threadCopy.exitSem);
+        }
+
       if (threadCopy.threadId != 0)
         {
           if (shouldThreadExit)
             {
+              /*
+               * A pooled stack is still in use until the thread has
+               * gone, so leave deleting the thread and recycling the
+               * stack to a later pte_stack_pool_get().
+               */
+              if (threadCopy.poolStack != NULL)
+                {
+                  pte_stack_pool_retire(threadCopy.threadId,
+                                        threadCopy.poolStack,
+                                        threadCopy.poolStackSize);
+                  pte_osThreadExit();
+                }
+
               pte_osThreadExitAndDelete(threadCopy.threadId);
             }
           else
@@ -80,6 +103,11 @@ pte_threadDestroyCommon (pthread_t thread, unsigned char shouldThreadExit)
             }
         }
 
+      if (threadCopy.poolStack != NULL)
+        {
+          pte_stack_pool_put(threadCopy.poolStack, threadCopy.poolStackSize);
+        }
+
 
 
     }
@@ -95,11 +95,19 @@ int pte_threadStart (void *vthreadParms)
   sp = (pte_thread_t *) self;
   start = threadParms->start;
   arg = threadParms->arg;
-//  free (threadParms);
+  pte_free (PTE_ALLOC_THREADPARMS, threadParms, sizeof (*threadParms));
 
   pthread_setspecific (pte_selfThreadKey, sp);
 
-  sp->state = PThreadStateRunning;
+  /*
+   * Don't lose a cancel made before we got here.
+   */
+  (void) pthread_mutex_lock (&sp->cancelLock);
+  if (sp->state < PThreadStateCancelPending)
+    {
+      sp->state = PThreadStateRunning;
+    }
+  (void) pthread_mutex_unlock (&sp->cancelLock);
 
 #ifdef PTE_CLEANUP_C
 
@@ -234,6 +242,8 @@ int pte_threadStart (void *vthreadParms)
    * must be cleaned up explicitly by the application
    * (by calling pte_thread_detach_np()).
    */
+  PTE_TRACE (PTE_TRACE_EXIT, sp);
+
   (void) pte_thread_detach_and_exit_np ();
 
   //pte_osThreadExit(status);
@@ -128,8 +128,17 @@ pte_throw (unsigned int exception)
 
 void
 pte_pop_cleanup_all (int execute)
+/*
+ * Pop the cleanup handlers pushed since the thread started or, in a
+ * thread pool or task scheduler worker, since the current task
+ * started.
+ */
 {
-  while (NULL != pte_pop_cleanup (execute))
+  pte_thread_t * sp = (pte_thread_t *) pthread_getspecific (pte_selfThreadKey);
+  void *mark = (sp != NULL) ? sp->cleanupMark : NULL;
+
+  while (pthread_getspecific (pte_cleanupKey) != mark
+         && NULL != pte_pop_cleanup (execute))
     {
     }
 }
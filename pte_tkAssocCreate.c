@@ -89,7 +89,7 @@ pte_tkAssocCreate (pte_thread_t * sp, pthread_key_t key)
    * Both key->keyLock and thread->threadLock are locked on
    * entry to this routine.
    */
-  assoc = (ThreadKeyAssoc *) calloc (1, sizeof (*assoc));
+  assoc = (ThreadKeyAssoc *) pte_alloc (PTE_ALLOC_KEYASSOC, sizeof (*assoc));
 
   if (assoc == NULL)
     {
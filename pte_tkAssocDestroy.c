@@ -116,7 +116,7 @@ pte_tkAssocDestroy (ThreadKeyAssoc * assoc)
           assoc->key->threads = next;
         }
 
-      free (assoc);
+      pte_free (PTE_ALLOC_KEYASSOC, assoc, sizeof (*assoc));
     }
 
 }				/* pte_tkAssocDestroy */
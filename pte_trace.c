@@ -0,0 +1,243 @@
+/*
+ * pte_trace.c
+ *
+ * Description:
+ * This translation unit implements the tracepoint dispatch and the
+ * built-in trace recorder (see pte_trace_start_np).
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdlib.h>
+
+#include <pte_osal.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+
+void
+pte_trace_event (int event, const void *object)
+/*
+ * Calls the installed hook for 'event'. Reached through PTE_TRACE()
+ * only when hooks are installed; they are read once so that a
+ * concurrent pte_set_trace_hooks_np() cannot mix two sets.
+ */
+{
+  const pte_trace_hooks_t * hooks = pte_trace_hooks;
+  void (*hook) (const void *object, void *arg) = NULL;
+
+  if (hooks == NULL)
+    {
+      return;
+    }
+
+  switch (event)
+    {
+    case PTE_TRACE_BLOCK:
+      hook = hooks->block;
+      break;
+    case PTE_TRACE_WAKE:
+      hook = hooks->wake;
+      break;
+    case PTE_TRACE_HANDOFF:
+      hook = hooks->handoff;
+      break;
+    case PTE_TRACE_CREATE:
+      hook = hooks->create;
+      break;
+    case PTE_TRACE_EXIT:
+      hook = hooks->exit;
+      break;
+    case PTE_TRACE_CANCEL:
+      hook = hooks->cancel;
+      break;
+    }
+
+  if (hook != NULL)
+    {
+      (*hook) (object, hooks->arg);
+    }
+}
+
+
+static pte_trace_ring_t *
+pte_trace_ring_new (void)
+/*
+ * Allocates an event ring for the calling thread and links it on the
+ * list of rings. Returns NULL once the recorder has been stopped.
+ */
+{
+  pte_trace_ring_t * ring = NULL;
+
+  pte_osMutexLock (pte_trace_lock);
+
+  if (pte_trace_ring_size > 0)
+    {
+      ring = (pte_trace_ring_t *) pte_alloc (PTE_ALLOC_MISC,
+                                             sizeof (pte_trace_ring_t) +
+                                             pte_trace_ring_size *
+                                             sizeof (pte_trace_record_t));
+
+      if (ring != NULL)
+        {
+          ring->tid = ++pte_trace_next_tid;
+          ring->head = 0;
+          ring->size = pte_trace_ring_size;
+          ring->records = (pte_trace_record_t *) (ring + 1);
+          ring->next = pte_trace_rings;
+          pte_trace_rings = ring;
+        }
+    }
+
+  pte_osMutexUnlock (pte_trace_lock);
+
+  return ring;
+}
+
+
+static void
+pte_trace_record (int event, const void *object)
+/*
+ * Appends an event to the calling thread's ring, overwriting the
+ * oldest event once the ring is full. Only the owning thread writes
+ * to a ring, so no lock is taken; the atomic increment of 'head'
+ * publishes the record to pte_trace_dump_np().
+ */
+{
+  pte_thread_t * sp = (pte_thread_t *) pthread_self ();
+  pte_trace_ring_t * ring;
+  pte_trace_record_t * r;
+
+  if (sp == NULL)
+    {
+      return;
+    }
+
+  ring = (pte_trace_ring_t *) sp->traceRing;
+
+  if (ring == NULL)
+    {
+      if ((ring = pte_trace_ring_new ()) == NULL)
+        {
+          return;
+        }
+
+      sp->traceRing = ring;
+    }
+
+  r = &ring->records[(unsigned int) ring->head % ring->size];
+  r->time = pte_osClockGetMicros ();
+  r->object = object;
+  r->event = event;
+
+  (void) PTE_ATOMIC_INCREMENT (&ring->head);
+}
+
+
+static void
+pte_trace_record_block (const void *object, void *arg)
+{
+  pte_trace_record (PTE_TRACE_BLOCK, object);
+}
+
+static void
+pte_trace_record_wake (const void *object, void *arg)
+{
+  pte_trace_record (PTE_TRACE_WAKE, object);
+}
+
+static void
+pte_trace_record_handoff (const void *object, void *arg)
+{
+  pte_trace_record (PTE_TRACE_HANDOFF, object);
+}
+
+static void
+pte_trace_record_create (const void *object, void *arg)
+{
+  pte_trace_record (PTE_TRACE_CREATE, object);
+}
+
+static void
+pte_trace_record_exit (const void *object, void *arg)
+{
+  pte_trace_record (PTE_TRACE_EXIT, object);
+}
+
+static void
+pte_trace_record_cancel (const void *object, void *arg)
+{
+  pte_trace_record (PTE_TRACE_CANCEL, object);
+}
+
+/*
+ * The hooks pte_trace_start_np() installs
+ */
+const pte_trace_hooks_t pte_trace_recorder =
+  {
+    pte_trace_record_block,
+    pte_trace_record_wake,
+    pte_trace_record_handoff,
+    pte_trace_record_create,
+    pte_trace_record_exit,
+    pte_trace_record_cancel,
+    NULL
+  };
+
+
+void
+pte_trace_free_rings (void)
+/*
+ * Frees every thread's event ring. Only called when the library is
+ * terminated, as running threads keep pointers to their rings.
+ */
+{
+  pte_trace_ring_t * ring;
+
+  pte_osMutexLock (pte_trace_lock);
+
+  while ((ring = pte_trace_rings) != NULL)
+    {
+      pte_trace_rings = ring->next;
+      pte_free (PTE_ALLOC_MISC, ring, sizeof (pte_trace_ring_t) +
+                ring->size * sizeof (pte_trace_record_t));
+    }
+
+  pte_trace_ring_size = 0;
+
+  pte_osMutexUnlock (pte_trace_lock);
+}
@@ -0,0 +1,159 @@
+/*
+ * pte_trace_dump_np.c
+ *
+ * Description:
+ * This translation unit implements writing the recorded scheduling
+ * events as a Chrome trace.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdio.h>
+
+#include <pte_osal.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+static const char *pte_trace_event_names[] =
+  {
+    "block", "wake", "handoff", "create", "exit", "cancel"
+  };
+
+
+int
+pte_trace_dump_np (FILE * stream)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function writes the events recorded since
+ *      pte_trace_start_np() as Chrome trace event JSON.
+ *
+ * PARAMETERS
+ *      stream
+ *              stdio stream to write to
+ *
+ *
+ * DESCRIPTION
+ *      The output can be loaded into chrome://tracing or the
+ *      Perfetto UI. Each recording thread is shown as a track
+ *      named "pte thread N", numbered in the order threads
+ *      first recorded an event. A wait is shown as a slice
+ *      from its block to its wake event, with the object
+ *      waited on as an argument; handoff, create, exit and
+ *      cancel events are shown as instants.
+ *
+ *      Threads keep recording while the events are written,
+ *      so call pte_trace_stop_np() first for a consistent
+ *      trace.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully written,
+ *              EINVAL          'stream' is NULL.
+ *
+ * ------------------------------------------------------
+ */
+{
+  pte_trace_ring_t * ring;
+  const char *sep = "";
+
+  if (stream == NULL)
+    {
+      return EINVAL;
+    }
+
+  fprintf (stream, "{\"traceEvents\":[");
+
+  pte_osMutexLock (pte_trace_lock);
+
+  for (ring = pte_trace_rings; ring != NULL; ring = ring->next)
+    {
+      unsigned int head = (unsigned int) PTE_ATOMIC_EXCHANGE_ADD (&ring->head, 0);
+      unsigned int i = (head > (unsigned int) ring->size
+                        ? head - ring->size : 0);
+      int depth = 0;
+
+      fprintf (stream, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+               "\"tid\":%d,\"args\":{\"name\":\"pte thread %d\"}}",
+               sep, ring->tid, ring->tid);
+      sep = ",";
+
+      for (; i < head; i++)
+        {
+          pte_trace_record_t * r = &ring->records[i % ring->size];
+          const char *ph;
+
+          switch (r->event)
+            {
+            case PTE_TRACE_BLOCK:
+              ph = "B";
+              depth++;
+              break;
+            case PTE_TRACE_WAKE:
+              /*
+               * Skip wakes whose block was overwritten
+               */
+              if (depth == 0)
+                {
+                  continue;
+                }
+              ph = "E";
+              depth--;
+              break;
+            default:
+              ph = "i\",\"s\":\"t";
+              break;
+            }
+
+          fprintf (stream, "%s\n{\"name\":\"%s\",\"cat\":\"pte\",\"ph\":\"%s\","
+                   "\"ts\":%llu,\"pid\":1,\"tid\":%d,"
+                   "\"args\":{\"object\":\"%p\"}}",
+                   sep, pte_trace_event_names[r->event], ph, r->time,
+                   ring->tid, r->object);
+        }
+    }
+
+  pte_osMutexUnlock (pte_trace_lock);
+
+  fprintf (stream, "\n]}\n");
+
+  fflush (stream);
+
+  return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * pte_trace_start_np.c
+ *
+ * Description:
+ * This translation unit implements starting the built-in trace
+ * recorder.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pte_osal.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_trace_start_np (int eventsPerThread)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function starts recording the library's
+ *      scheduling events for pte_trace_dump_np().
+ *
+ * PARAMETERS
+ *      eventsPerThread
+ *              number of events kept for each thread; once a
+ *              thread has recorded that many its oldest events
+ *              are overwritten.
+ *
+ *
+ * DESCRIPTION
+ *      Installs trace hooks (see pte_set_trace_hooks_np) that
+ *      append each event, with a pte_osClockGetMicros() time
+ *      stamp, to a ring belonging to the thread. A thread's
+ *      ring is allocated the first time it records an event
+ *      and is written without locking; rings are kept after
+ *      their threads exit, until the library is terminated.
+ *
+ *      Events recorded before this call are discarded. Rings
+ *      allocated by an earlier recording keep their size.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ *              2)      Any hooks installed with
+ *                      pte_set_trace_hooks_np() are replaced.
+ *
+ * RESULTS
+ *              0               successfully started,
+ *              EINVAL          'eventsPerThread' is not positive.
+ *
+ * ------------------------------------------------------
+ */
+{
+  pte_trace_ring_t * ring;
+
+  if (eventsPerThread <= 0)
+    {
+      return EINVAL;
+    }
+
+  pte_osMutexLock (pte_trace_lock);
+
+  pte_trace_ring_size = eventsPerThread;
+
+  for (ring = pte_trace_rings; ring != NULL; ring = ring->next)
+    {
+      (void) PTE_ATOMIC_EXCHANGE (&ring->head, 0);
+    }
+
+  pte_osMutexUnlock (pte_trace_lock);
+
+  pte_trace_hooks = &pte_trace_recorder;
+
+  return 0;
+}
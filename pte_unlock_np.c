@@ -0,0 +1,92 @@
+/*
+ * pte_unlock_np.c
+ *
+ * Description:
+ * This translation unit implements unlocking inline locks.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pte_unlock_np (pte_lock_t * lock)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function unlocks an inline lock, waking one
+ *      thread waiting for it.
+ *
+ * PARAMETERS
+ *      lock
+ *              pointer to the lock
+ *
+ *
+ * DESCRIPTION
+ *      Any thread may unlock the lock, not just the one that
+ *      locked it. The woken thread competes with threads
+ *      that have not yet parked, so the lock is not FIFO.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully unlocked,
+ *              EPERM           'lock' was not locked,
+ *              EINVAL          'lock' is NULL.
+ *
+ * ------------------------------------------------------
+ */
+{
+  int c;
+
+  if (lock == NULL)
+    {
+      return EINVAL;
+    }
+
+  c = PTE_ATOMIC_EXCHANGE_RELEASE (&lock->state, PTE_LOCK_FREE);
+
+  if (c == PTE_LOCK_CONTENDED)
+    {
+      PTE_TRACE (PTE_TRACE_HANDOFF, lock);
+      pte_unpark_one (&lock->state);
+    }
+
+  return c == PTE_LOCK_FREE ? EPERM : 0;
+}
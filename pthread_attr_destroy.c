@@ -80,7 +80,7 @@ pthread_attr_destroy (pthread_attr_t * attr)
    * Set the attribute object to a specific invalid value.
    */
   (*attr)->valid = 0;
-  free (*attr);
+  pte_free (PTE_ALLOC_ATTR, *attr, sizeof (**attr));
   *attr = NULL;
 
   return 0;
@@ -0,0 +1,84 @@
+/*
+ * pthread_attr_getaffinity_np.c
+ *
+ * Description:
+ * This translation unit implements operations on thread attribute objects.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pthread_attr_getaffinity_np (const pthread_attr_t * attr,
+                             unsigned int *cpumask)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function determines the set of processors on
+ *      which threads created with 'attr' may run.
+ *
+ * PARAMETERS
+ *      attr
+ *              pointer to an instance of pthread_attr_t
+ *
+ *      cpumask
+ *              pointer to an unsigned int into which is
+ *              returned the CPU mask. Zero means that no
+ *              affinity has been requested.
+ *
+ *
+ * DESCRIPTION
+ *      This function determines the set of processors on
+ *      which threads created with 'attr' may run.
+ *
+ * RESULTS
+ *              0               successfully retrieved affinity,
+ *              EINVAL          'attr' or 'cpumask' is invalid.
+ *
+ * ------------------------------------------------------
+ */
+{
+  if (pte_is_attr (attr) != 0 || cpumask == NULL)
+    {
+      return EINVAL;
+    }
+
+  *cpumask = (*attr)->cpuaffinity;
+  return 0;
+}
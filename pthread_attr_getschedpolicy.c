@@ -61,7 +61,7 @@ pthread_attr_getschedpolicy (pthread_attr_t * attr, int *policy)
       return EINVAL;
     }
 
-  *policy = SCHED_OTHER;
+  *policy = (*attr)->schedpolicy;
 
   return 0;
 }
@@ -81,7 +81,7 @@ pthread_attr_init (pthread_attr_t * attr)
       return EINVAL;
     }
 
-  attr_result = (pthread_attr_t) malloc (sizeof (*attr_result));
+  attr_result = (pthread_attr_t) pte_alloc (PTE_ALLOC_ATTR, sizeof (*attr_result));
 
   if (attr_result == NULL)
     {
@@ -110,6 +110,8 @@ pthread_attr_init (pthread_attr_t * attr)
   attr_result->param.sched_priority = pte_osThreadGetDefaultPriority();
   attr_result->inheritsched = PTHREAD_EXPLICIT_SCHED;
   attr_result->contentionscope = PTHREAD_SCOPE_SYSTEM;
+  attr_result->cpuaffinity = 0;
+  attr_result->schedpolicy = SCHED_OTHER;
 
   attr_result->valid = PTE_ATTR_VALID;
 
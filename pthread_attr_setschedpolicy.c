@@ -52,10 +52,16 @@ pthread_attr_setschedpolicy (pthread_attr_t * attr, int policy)
       return EINVAL;
     }
 
-  if (policy != SCHED_OTHER)
+  if (policy < SCHED_MIN || policy > SCHED_MAX)
     {
-      return ENOTSUP;
+      return EINVAL;
     }
 
+  /*
+   * Whether the OS can honour SCHED_FIFO or SCHED_RR is only
+   * known when pthread_create() applies the policy.
+   */
+  (*attr)->schedpolicy = policy;
+
   return 0;
 }
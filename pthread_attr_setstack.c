@@ -0,0 +1,108 @@
+/*
+ * pthread_attr_setstack.c
+ *
+ * Description:
+ * This translation unit implements operations on thread attribute objects.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pthread_attr_setstack (pthread_attr_t * attr, void *stackaddr,
+                       size_t stacksize)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      Threads created with 'attr' will run on the stack
+ *      of 'stacksize' bytes starting at 'stackaddr'.
+ *
+ * PARAMETERS
+ *      attr
+ *              pointer to an instance of pthread_attr_t
+ *
+ *      stackaddr
+ *              lowest address of the stack
+ *
+ *      stacksize
+ *              size of the stack, in bytes
+ *
+ *
+ * DESCRIPTION
+ *      Threads created with 'attr' will run on the stack
+ *      of 'stacksize' bytes starting at 'stackaddr'. The
+ *      stack is passed to pte_osThreadCreateWithStack().
+ *      The application owns the stack and may reuse it
+ *      once the thread has been joined.
+ *
+ *      NOTES:
+ *              1)      Only one thread at a time may run on a
+ *                      given stack.
+ *
+ *              2)      pthread_create() returns ENOTSUP if the
+ *                      OS cannot run threads on caller supplied
+ *                      stacks.
+ *
+ * RESULTS
+ *              0               successfully set stack,
+ *              EINVAL          'attr' or 'stackaddr' is invalid,
+ *                              or 'stacksize' is below
+ *                              PTHREAD_STACK_MIN.
+ *
+ * ------------------------------------------------------
+ */
+{
+  if (pte_is_attr (attr) != 0 || stackaddr == NULL)
+    {
+      return EINVAL;
+    }
+
+#if PTHREAD_STACK_MIN > 0
+
+  if (stacksize < PTHREAD_STACK_MIN)
+    {
+      return EINVAL;
+    }
+
+#endif
+
+  (*attr)->stackaddr = stackaddr;
+  (*attr)->stacksize = stacksize;
+  return 0;
+}
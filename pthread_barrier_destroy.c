@@ -64,10 +64,16 @@ pthread_barrier_destroy (pthread_barrier_t * barrier)
     {
       if (0 == (result = sem_destroy (&(b->semBarrierBreeched[1]))))
         {
-          (void) free (b);
+#ifdef PTE_SYNC_REGISTRY
+          pte_sync_unregister (b->syncEntry);
+#endif
+          pte_free (PTE_ALLOC_BARRIER, b, sizeof (*b));
           return 0;
         }
       (void) sem_init (&(b->semBarrierBreeched[0]), b->pshared, 0);
+#ifdef PTE_SYNC_REGISTRY
+      pte_sync_adopt (b->semBarrierBreeched[0]->syncEntry, b->syncEntry);
+#endif
     }
 
   *barrier = b;
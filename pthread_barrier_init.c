@@ -57,7 +57,7 @@ pthread_barrier_init (pthread_barrier_t * barrier,
       return EINVAL;
     }
 
-  if (NULL != (b = (pthread_barrier_t) calloc (1, sizeof (*b))))
+  if (NULL != (b = (pthread_barrier_t) pte_alloc (PTE_ALLOC_BARRIER, sizeof (*b))))
     {
       b->pshared = (attr != NULL && *attr != NULL
                     ? (*attr)->pshared : PTHREAD_PROCESS_PRIVATE);
@@ -77,12 +77,17 @@ pthread_barrier_init (pthread_barrier_t * barrier,
         {
           if (0 == sem_init (&(b->semBarrierBreeched[1]), b->pshared, 0))
             {
+#ifdef PTE_SYNC_REGISTRY
+              b->syncEntry = pte_sync_register (PTE_SYNC_BARRIER, b);
+              pte_sync_adopt (b->semBarrierBreeched[0]->syncEntry, b->syncEntry);
+              pte_sync_adopt (b->semBarrierBreeched[1]->syncEntry, b->syncEntry);
+#endif
               *barrier = b;
               return 0;
             }
           (void) sem_destroy (&(b->semBarrierBreeched[0]));
         }
-      (void) free (b);
+      pte_free (PTE_ALLOC_BARRIER, b, sizeof (*b));
     }
 
   return ENOMEM;
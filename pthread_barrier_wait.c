@@ -59,11 +59,17 @@ pthread_barrier_wait (pthread_barrier_t * barrier)
   b = *barrier;
   step = b->iStep;
 
-  if (0 == PTE_ATOMIC_DECREMENT ((int *) &(b->nCurrentBarrierHeight)))
+  /*
+   * Release our writes to the last thread in, and let it acquire
+   * everyone's before it posts the others through.
+   */
+  if (0 == PTE_ATOMIC_DECREMENT_ACQ_REL ((int *) &(b->nCurrentBarrierHeight)))
     {
       /* Must be done before posting the semaphore. */
       b->nCurrentBarrierHeight = b->nInitialBarrierHeight;
 
+      PTE_TRACE (PTE_TRACE_HANDOFF, b);
+
       /*
        * There is no race condition between the semaphore wait and post
        * because we are using two alternating semas and all threads have
@@ -82,8 +88,9 @@ pthread_barrier_wait (pthread_barrier_t * barrier)
       /*
        * Use the non-cancelable version of sem_wait().
        */
-      result = sem_wait (&(b->semBarrierBreeched[step]));
-//      result = sem_wait_nocancel (&(b->semBarrierBreeched[step]));
+      PTE_TRACE (PTE_TRACE_BLOCK, b);
+      result = sem_wait_nocancel (&(b->semBarrierBreeched[step]));
+      PTE_TRACE (PTE_TRACE_WAKE, b);
     }
 
   /*
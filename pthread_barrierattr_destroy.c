@@ -84,7 +84,7 @@ pthread_barrierattr_destroy (pthread_barrierattr_t * attr)
       pthread_barrierattr_t ba = *attr;
 
       *attr = NULL;
-      free (ba);
+      pte_free (PTE_ALLOC_ATTR, ba, sizeof (*ba));
     }
 
   return (result);
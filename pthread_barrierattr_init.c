@@ -76,7 +76,7 @@ pthread_barrierattr_init (pthread_barrierattr_t * attr)
   pthread_barrierattr_t ba;
   int result = 0;
 
-  ba = (pthread_barrierattr_t) calloc (1, sizeof (*ba));
+  ba = (pthread_barrierattr_t) pte_alloc (PTE_ALLOC_ATTR, sizeof (*ba));
 
   if (ba == NULL)
     {
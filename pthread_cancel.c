@@ -103,6 +103,8 @@ pthread_cancel (pthread_t thread)
 
   tp = (pte_thread_t *) thread;
 
+  PTE_TRACE (PTE_TRACE_CANCEL, tp);
+
   /*
    * Lock for async-cancel safety.
    */
@@ -116,6 +118,7 @@ pthread_cancel (pthread_t thread)
         {
           tp->state = PThreadStateCanceling;
           tp->cancelState = PTHREAD_CANCEL_DISABLE;
+          PTE_CANCEL_PUBLISH (tp);
 
           (void) pthread_mutex_unlock (&tp->cancelLock);
           pte_throw (PTE_EPS_CANCEL);
@@ -170,6 +173,7 @@ pthread_cancel (pthread_t thread)
       if (tp->state < PThreadStateCancelPending)
         {
           tp->state = PThreadStateCancelPending;
+          PTE_CANCEL_PUBLISH (tp);
 
           if (pte_osThreadCancel(tp->threadId) != PTE_OS_OK)
             {
@@ -144,8 +144,9 @@ pthread_cond_destroy (pthread_cond_t * cond)
        * Close the gate; this will synchronize this thread with
        * all already signaled waiters to let them retract their
        * waiter status - SEE NOTE 1 ABOVE!!!
+       * Not a cancellation point: we hold pte_cond_list_lock.
        */
-      if (sem_wait (&(cv->semBlockLock)) != 0)
+      if (sem_wait_nocancel (&(cv->semBlockLock)) != 0)
         {
           return errno;
         }
@@ -213,7 +214,11 @@ pthread_cond_destroy (pthread_cond_t * cond)
               cv->next->prev = cv->prev;
             }
 
-          (void) free (cv);
+#ifdef PTE_SYNC_REGISTRY
+          pte_sync_unregister (cv->syncEntry);
+#endif
+
+          pte_free (PTE_ALLOC_COND, cv, sizeof (*cv));
         }
 
       pte_osMutexUnlock(pte_cond_list_lock);
@@ -225,31 +230,22 @@ pthread_cond_destroy (pthread_cond_t * cond)
        * See notes in pte_cond_check_need_init() above also.
        */
 
-      pte_osMutexLock (pte_cond_test_init_lock);
-
       /*
-       * Check again.
+       * This is all we need to do to destroy a statically
+       * initialised cond that has not yet been used (initialised).
+       * A thread initialising it meanwhile will fail to install its
+       * cond and get EINVAL.
        */
-      if (*cond == PTHREAD_COND_INITIALIZER)
+      if (PTE_ATOMIC_COMPARE_EXCHANGE_PTR ((void * volatile *) cond, NULL,
+                                           (void *) PTHREAD_COND_INITIALIZER)
+          != (void *) PTHREAD_COND_INITIALIZER)
         {
           /*
-           * This is all we need to do to destroy a statically
-           * initialised cond that has not yet been used (initialised).
-           * If we get to here, another thread waiting to initialise
-           * this cond will get an EINVAL. That's OK.
-           */
-          *cond = NULL;
-        }
-      else
-        {
-          /*
-           * The cv has been initialised while we were waiting
+           * The cond has been initialised meanwhile
            * so assume it's in use.
            */
           result = EBUSY;
         }
-
-      pte_osMutexUnlock(pte_cond_test_init_lock);
     }
 
   return ((result != 0) ? result : ((result1 != 0) ? result1 : result2));
@@ -95,7 +95,7 @@ pthread_cond_init (pthread_cond_t * cond, const pthread_condattr_t * attr)
       goto DONE;
     }
 
-  cv = (pthread_cond_t) calloc (1, sizeof (*cv));
+  cv = (pthread_cond_t) pte_alloc (PTE_ALLOC_COND, sizeof (*cv));
 
   if (cv == NULL)
     {
@@ -140,12 +140,18 @@ FAIL1:
   (void) sem_destroy (&(cv->semBlockLock));
 
 FAIL0:
-  (void) free (cv);
+  pte_free (PTE_ALLOC_COND, cv, sizeof (*cv));
   cv = NULL;
 
 DONE:
   if (0 == result)
     {
+#ifdef PTE_SYNC_REGISTRY
+      cv->syncEntry = pte_sync_register (PTE_SYNC_COND, cv);
+      pte_sync_adopt (cv->semBlockLock->syncEntry, cv->syncEntry);
+      pte_sync_adopt (cv->semBlockQueue->syncEntry, cv->syncEntry);
+      pte_sync_adopt (cv->mtxUnblockLock->syncEntry, cv->syncEntry);
+#endif
 
       pte_osMutexLock (pte_cond_list_lock);
 
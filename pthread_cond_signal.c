@@ -116,8 +116,7 @@ pte_cond_unblock (pthread_cond_t * cond, int unblockAll)
   else if (cv->nWaitersBlocked > cv->nWaitersGone)
     {
       /* Use the non-cancellable version of sem_wait() */
-//      if (sem_wait_nocancel (&(cv->semBlockLock)) != 0)
-      if (sem_wait (&(cv->semBlockLock)) != 0)
+      if (sem_wait_nocancel (&(cv->semBlockLock)) != 0)
         {
           result = errno;
           (void) pthread_mutex_unlock (&(cv->mtxUnblockLock));
@@ -146,6 +145,8 @@ pte_cond_unblock (pthread_cond_t * cond, int unblockAll)
 
   if ((result = pthread_mutex_unlock (&(cv->mtxUnblockLock))) == 0)
     {
+      PTE_TRACE (PTE_TRACE_HANDOFF, cv);
+
       if (sem_post_multiple (&(cv->semBlockQueue), nSignalsToIssue) != 0)
         {
           result = errno;
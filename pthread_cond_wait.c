@@ -288,6 +288,8 @@ pte_cond_wait_cleanup (void *args)
   int nSignalsWasLeft;
   int result;
 
+  PTE_TRACE (PTE_TRACE_WAKE, cv);
+
   /*
    * Whether we got here as a result of signal/broadcast or because of
    * timeout on wait or thread cancellation we indicate that we are no
@@ -307,8 +309,7 @@ pte_cond_wait_cleanup (void *args)
   else if (INT_MAX / 2 == ++(cv->nWaitersGone))
     {
       /* Use the non-cancellable version of sem_wait() */
-//      if (sem_wait_nocancel (&(cv->semBlockLock)) != 0)
-      if (sem_wait (&(cv->semBlockLock)) != 0)
+      if (sem_wait_nocancel (&(cv->semBlockLock)) != 0)
         {
           *resultPtr = errno;
           /*
@@ -388,8 +389,11 @@ pte_cond_timedwait (pthread_cond_t * cond,
 
   cv = *cond;
 
-  /* Thread can be cancelled in sem_wait() but this is OK */
-  if (sem_wait (&(cv->semBlockLock)) != 0)
+  /*
+   * Internal gate: a pending cancel is acted on by sem_timedwait()
+   * below, once the cleanup handler is in place.
+   */
+  if (sem_wait_nocancel (&(cv->semBlockLock)) != 0)
     {
       return errno;
     }
@@ -410,6 +414,11 @@ pte_cond_timedwait (pthread_cond_t * cond,
 
   pthread_cleanup_push (pte_cond_wait_cleanup, (void *) &cleanup_args);
 
+  /*
+   * The cleanup handler traces the wake, however the wait ends
+   */
+  PTE_TRACE (PTE_TRACE_BLOCK, cv);
+
   /*
    * Now we can release 'mutex' and...
    */
@@ -83,7 +83,7 @@ pthread_condattr_destroy (pthread_condattr_t * attr)
     }
   else
     {
-      (void) free (*attr);
+      pte_free (PTE_ALLOC_ATTR, *attr, sizeof (**attr));
 
       *attr = NULL;
       result = 0;
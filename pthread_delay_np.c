@@ -94,7 +94,6 @@ pthread_delay_np (struct timespec *interval)
   unsigned int secs_in_millisecs;
   unsigned int millisecs;
   pthread_t self;
-  pte_thread_t * sp;
 
   if (interval == NULL)
     {
@@ -122,45 +121,15 @@ pthread_delay_np (struct timespec *interval)
       return ENOMEM;
     }
 
-  sp = (pte_thread_t *) self;
+  /*
+   * A pending deferred cancelation cancels us immediately; one that
+   * arrives while we sleep is acted on when we wake.
+   */
+  pthread_testcancel ();
 
-  if (sp->cancelState == PTHREAD_CANCEL_ENABLE)
-    {
-      pte_osResult cancelStatus;
-      /*
-       * Async cancelation won't catch us until wait_time is up.
-       * Deferred cancelation will cancel us immediately.
-       */
-      cancelStatus = pte_osThreadCheckCancel(sp->threadId);
-
-      if (cancelStatus == PTE_OS_INTERRUPTED)
-        {
-          /*
-           * Canceling!
-           */
-          (void) pthread_mutex_lock (&sp->cancelLock);
-          if (sp->state < PThreadStateCanceling)
-            {
-              sp->state = PThreadStateCanceling;
-              sp->cancelState = PTHREAD_CANCEL_DISABLE;
-              (void) pthread_mutex_unlock (&sp->cancelLock);
+  pte_osThreadSleep (wait_time);
 
-              pte_throw (PTE_EPS_CANCEL);
-            }
-
-          (void) pthread_mutex_unlock (&sp->cancelLock);
-          return ESRCH;
-        }
-      else if (cancelStatus != PTE_OS_OK)
-        {
-          return EINVAL;
-        }
-    }
-  else
-
-    {
-      pte_osThreadSleep (wait_time);
-    }
+  pthread_testcancel ();
 
   return (0);
 }
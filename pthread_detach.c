@@ -78,8 +78,6 @@ pthread_detach (pthread_t thread)
   pte_thread_t * tp = (pte_thread_t *) thread;
 
 
-  pte_osMutexLock (pte_thread_reuse_lock);
-
   if (NULL == tp)
     {
       result = ESRCH;
@@ -119,8 +117,6 @@ pthread_detach (pthread_t thread)
         }
     }
 
-  pte_osMutexUnlock(pte_thread_reuse_lock);
-
   if (result == 0)
     {
       /* Thread is joinable */
@@ -94,6 +94,14 @@ pthread_exit (void *value_ptr)
 
   sp->exitStatus = value_ptr;
 
+  if (sp->implicit)
+    {
+      /*
+       * pte_threadStart() traces the exit of threads we created
+       */
+      PTE_TRACE (PTE_TRACE_EXIT, sp);
+    }
+
   pte_throw (PTE_EPS_EXIT);
 
   /* Never reached. */
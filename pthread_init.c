@@ -79,11 +79,19 @@ int pthread_init(void)
    * Set up the global locks.
    */
   pte_osMutexCreate (&pte_thread_reuse_lock);
-  pte_osMutexCreate (&pte_mutex_test_init_lock);
   pte_osMutexCreate (&pte_cond_list_lock);
-  pte_osMutexCreate (&pte_cond_test_init_lock);
-  pte_osMutexCreate (&pte_rwlock_test_init_lock);
-  pte_osMutexCreate (&pte_spinlock_test_init_lock);
+  pte_osMutexCreate (&pte_mutex_prio_lock);
+  pte_osMutexCreate (&pte_stack_pool_lock);
+  pte_osMutexCreate (&pte_task_lock);
+  pte_osMutexCreate (&pte_trace_lock);
+  pte_slab_init ();
+  pte_park_init ();
+#ifdef PTE_MUTEX_STATS
+  pte_osMutexCreate (&pte_mutex_stats_lock);
+#endif
+#ifdef PTE_SYNC_REGISTRY
+  pte_osMutexCreate (&pte_sync_reporter_lock);
+#endif
 
 
   return (pte_processInitialized);
@@ -83,81 +83,6 @@ pthread_join (pthread_t thread, void **value_ptr)
  * ------------------------------------------------------
  */
 {
-  int result;
-  pthread_t self;
-  pte_thread_t * tp = (pte_thread_t *) thread;
-
-
-  pte_osMutexLock (pte_thread_reuse_lock);
-
-  if (NULL == tp)
-    {
-      result = ESRCH;
-    }
-  else if (PTHREAD_CREATE_DETACHED == tp->detachState)
-    {
-      result = EINVAL;
-    }
-  else
-    {
-      result = 0;
-    }
-
-  pte_osMutexUnlock(pte_thread_reuse_lock);
-
-  if (result == 0)
-    {
-      /*
-       * The target thread is joinable and can't be reused before we join it.
-       */
-      self = pthread_self();
-
-      if (0 == self)
-        {
-          result = ENOENT;
-        }
-      else if (pthread_equal (self, thread))
-        {
-          result = EDEADLK;
-        }
-      else
-        {
-          /*
-           * Pthread_join is a cancelation point.
-           * If we are canceled then our target thread must not be
-           * detached (destroyed). This is guarranteed because
-           * pthreadCancelableWait will not return if we
-           * are canceled.
-           */
-
-          result = pte_osThreadWaitForEnd(tp->threadId);
-
-          if (PTE_OS_OK == result)
-            {
-              if (value_ptr != NULL)
-                {
-                  *value_ptr = tp->exitStatus;
-                }
-
-              /*
-               * The result of making multiple simultaneous calls to
-               * pthread_join() or pthread_detach() specifying the same
-               * target is undefined.
-               */
-              result = pthread_detach (thread);
-            }
-	  else if (result == PTE_OS_INTERRUPTED)
-	    {
-	      /* Call was cancelled, but still return success (per spec) */
-	      result = 0;
-	    }
-          else
-            {
-              result = ESRCH;
-            }
-        }
-    }
-
-  return (result);
+  return pte_join (thread, value_ptr, NULL);
 
 }				/* pthread_join */
@@ -0,0 +1,258 @@
+/*
+ * pthread_join_any_np.c
+ *
+ * Description:
+ * This translation unit implements joining whichever of several threads
+ * finishes first.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pte_osal.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+
+/*
+ * Returns the first of the n threads that has finished, or NULL.
+ */
+static pte_thread_t *
+pte_join_any_poll (pthread_t * threads, int n)
+{
+  pte_thread_t * tp;
+  int i;
+
+  for (i = 0; i < n; i++)
+    {
+      tp = (pte_thread_t *) threads[i];
+
+      if (tp->state == PThreadStateLast)
+        {
+          return tp;
+        }
+    }
+
+  return NULL;
+}
+
+int
+pthread_join_any_np (pthread_t * threads, int n, int *which, void **value_ptr)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function waits for any one of 'n' threads to
+ *      terminate and joins it.
+ *
+ * PARAMETERS
+ *      threads
+ *              array of 'n' instances of pthread_t
+ *
+ *      n
+ *              number of threads in the array
+ *
+ *      which
+ *              pointer to an int that receives the array index
+ *              of the thread joined, or NULL
+ *
+ *      value_ptr
+ *              pointer to an instance of pointer to void
+ *
+ *
+ * DESCRIPTION
+ *      This function waits until one of the threads in
+ *      'threads' has terminated, then joins it as
+ *      pthread_join() would: its exit value is returned if
+ *      'value_ptr' is not NULL and it is detached. The other
+ *      threads are left as they were, and can be joined by
+ *      another call with the joined entry removed.
+ *
+ *      Each thread waited on is told about the caller, so the
+ *      caller is woken by the first thread that finishes and
+ *      no thread is polled. A thread must not be waited on
+ *      by more than one join at a time.
+ *
+ *      This function is a cancellation point.
+ *
+ * RESULTS
+ *              0               a thread has completed
+ *              EINVAL          'n' is not positive, or a thread is
+ *                              not a joinable thread,
+ *              ESRCH           a NULL thread was given,
+ *              ENOENT          thread couldn't find it's own valid handle,
+ *              EDEADLK         attempt to join thread with self,
+ *              EAGAIN          insufficient resources,
+ *              EINTR           the wait was interrupted
+ *
+ * ------------------------------------------------------
+ */
+{
+  pte_join_any_t waiter;
+  pte_thread_t * tp;
+  pthread_t self;
+  unsigned int timeout = 0;
+  pte_osResult osResult = PTE_OS_OK;
+  int registered;
+  int i;
+
+  if (threads == NULL || n <= 0)
+    {
+      return EINVAL;
+    }
+
+  self = pthread_self ();
+
+  if (0 == self)
+    {
+      return ENOENT;
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      tp = (pte_thread_t *) threads[i];
+
+      if (NULL == tp)
+        {
+          return ESRCH;
+        }
+
+      if (PTHREAD_CREATE_DETACHED == tp->detachState || !tp->exitSemValid)
+        {
+          return EINVAL;
+        }
+
+      if (pthread_equal (self, threads[i]))
+        {
+          return EDEADLK;
+        }
+    }
+
+  /*
+   * Reap a thread that has already finished without registering.
+   */
+  waiter.winner = pte_join_any_poll (threads, n);
+
+  if (waiter.winner == NULL)
+    {
+      if (pte_osSemaphoreCreate (0, &waiter.sem) != PTE_OS_OK)
+        {
+          return EAGAIN;
+        }
+
+      /*
+       * Registration and the exiting thread's check both happen
+       * under the thread's cancelLock, so a thread either sees the
+       * waiter or was already PThreadStateLast when registering.
+       */
+      for (registered = 0; registered < n; registered++)
+        {
+          tp = (pte_thread_t *) threads[registered];
+
+          (void) pthread_mutex_lock (&tp->cancelLock);
+
+          if (tp->state == PThreadStateLast)
+            {
+              (void) PTE_ATOMIC_COMPARE_EXCHANGE_PTR (&waiter.winner, tp, NULL);
+            }
+          else
+            {
+              tp->joinAnyWaiter = &waiter;
+            }
+
+          (void) pthread_mutex_unlock (&tp->cancelLock);
+
+          if (PTE_ATOMIC_LOAD_PTR (&waiter.winner) != NULL)
+            {
+              registered++;
+              break;
+            }
+        }
+
+      if (PTE_ATOMIC_LOAD_PTR (&waiter.winner) == NULL)
+        {
+          /*
+           * The winner is set before the first post.
+           */
+          osResult = pte_osSemaphoreCancellablePend (waiter.sem, NULL);
+        }
+
+      /*
+       * Once deregistered no thread can touch the waiter any more.
+       */
+      for (i = 0; i < registered; i++)
+        {
+          tp = (pte_thread_t *) threads[i];
+
+          (void) pthread_mutex_lock (&tp->cancelLock);
+          if (tp->joinAnyWaiter == &waiter)
+            {
+              tp->joinAnyWaiter = NULL;
+            }
+          (void) pthread_mutex_unlock (&tp->cancelLock);
+        }
+
+      (void) pte_osSemaphoreDelete (waiter.sem);
+
+      if (PTE_OS_INTERRUPTED == osResult)
+        {
+          /*
+           * Canceled: act on it now that the waiter is gone.
+           */
+          pthread_testcancel ();
+
+          return EINTR;
+        }
+      else if (PTE_OS_OK != osResult)
+        {
+          return EINVAL;
+        }
+    }
+
+  for (i = 0; threads[i] != (pthread_t) waiter.winner; i++)
+    {
+    }
+
+  if (which != NULL)
+    {
+      *which = i;
+    }
+
+  /*
+   * The winner has finished, so this cannot time out.
+   */
+  return pte_join (threads[i], value_ptr, &timeout);
+
+}				/* pthread_join_any_np */
@@ -0,0 +1,197 @@
+/*
+ * pthread_join_batch_np.c
+ *
+ * Description:
+ * This translation unit implements joining a set of threads in one call.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pte_osal.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pthread_join_batch_np (pthread_t * threads, int n, void **value_ptrs)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function waits for all of 'n' threads to
+ *      terminate and joins them.
+ *
+ * PARAMETERS
+ *      threads
+ *              array of 'n' instances of pthread_t
+ *
+ *      n
+ *              number of threads in the array
+ *
+ *      value_ptrs
+ *              array of 'n' pointers to void, or NULL
+ *
+ *
+ * DESCRIPTION
+ *      This function is equivalent to calling pthread_join()
+ *      on each thread in turn, storing the exit value of
+ *      threads[i] in value_ptrs[i] if 'value_ptrs' is not
+ *      NULL. Every thread is checked before any is waited
+ *      for, so on an error no thread has been joined. A
+ *      thread must not appear in 'threads' more than once.
+ *
+ *      This function is a cancellation point. If it is
+ *      canceled no thread has been joined.
+ *
+ * RESULTS
+ *              0               all threads have completed
+ *              EINVAL          'n' is not positive, or a thread is
+ *                              not a joinable thread,
+ *              ESRCH           a NULL thread was given,
+ *              ENOENT          thread couldn't find it's own valid handle,
+ *              EDEADLK         attempt to join thread with self,
+ *              EINTR           the wait was interrupted
+ *
+ * ------------------------------------------------------
+ */
+{
+  pte_thread_t * tp;
+  pthread_t self;
+  pte_osResult osResult;
+  int result = 0;
+  int i;
+  int j;
+
+  if (threads == NULL || n <= 0)
+    {
+      return EINVAL;
+    }
+
+  self = pthread_self ();
+
+  if (0 == self)
+    {
+      return ENOENT;
+    }
+
+  for (i = 0; i < n && result == 0; i++)
+    {
+      tp = (pte_thread_t *) threads[i];
+
+      if (NULL == tp)
+        {
+          result = ESRCH;
+        }
+      else if (PTHREAD_CREATE_DETACHED == PTE_ATOMIC_LOAD_ACQUIRE (&tp->detachState)
+               || !tp->exitSemValid)
+        {
+          result = EINVAL;
+        }
+      else if (pthread_equal (self, threads[i]))
+        {
+          result = EDEADLK;
+        }
+    }
+
+  if (result != 0)
+    {
+      return result;
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      tp = (pte_thread_t *) threads[i];
+
+      osResult = pte_osSemaphoreCancellablePend (tp->exitSem, NULL);
+
+      if (PTE_OS_OK != osResult)
+        {
+          /*
+           * Give back the exit events already taken, so that the
+           * threads can still be joined.
+           */
+          for (j = 0; j < i; j++)
+            {
+              tp = (pte_thread_t *) threads[j];
+              (void) pte_osSemaphorePost (tp->exitSem, 1);
+            }
+
+          if (PTE_OS_INTERRUPTED == osResult)
+            {
+              pthread_testcancel ();
+
+              return EINTR;
+            }
+
+          return ESRCH;
+        }
+    }
+
+  /*
+   * Every thread has finished. Read the exit values in place and
+   * mark the threads detached, so nothing else can reap them.
+   */
+  for (i = 0; i < n; i++)
+    {
+      tp = (pte_thread_t *) threads[i];
+
+      (void) pthread_mutex_lock (&tp->cancelLock);
+
+      if (value_ptrs != NULL)
+        {
+          value_ptrs[i] = tp->exitStatus;
+        }
+
+      tp->detachState = PTHREAD_CREATE_DETACHED;
+
+      (void) pthread_mutex_unlock (&tp->cancelLock);
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      tp = (pte_thread_t *) threads[i];
+
+      /*
+       * The thread may still be on its way out.
+       */
+      pte_osThreadWaitForEnd (tp->threadId);
+
+      pte_threadDestroy (threads[i]);
+    }
+
+  return 0;
+
+}				/* pthread_join_batch_np */
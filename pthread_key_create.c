@@ -83,7 +83,7 @@ pthread_key_create (pthread_key_t * key, void (*destructor) (void *))
   int result = 0;
   pthread_key_t newkey;
 
-  if ((newkey = (pthread_key_t) calloc (1, sizeof (*newkey))) == NULL)
+  if ((newkey = (pthread_key_t) pte_alloc (PTE_ALLOC_KEY, sizeof (*newkey))) == NULL)
     {
       result = ENOMEM;
     }
@@ -95,7 +95,7 @@ pthread_key_create (pthread_key_t * key, void (*destructor) (void *))
         {
           result = EAGAIN;
 
-          free (newkey);
+          pte_free (PTE_ALLOC_KEY, newkey, sizeof (*newkey));
           newkey = NULL;
         }
       else if (destructor != NULL)
@@ -133,7 +133,7 @@ pthread_key_delete (pthread_key_t key)
             }
         }
 
-      free (key);
+      pte_free (PTE_ALLOC_KEY, key, sizeof (*key));
     }
 
   return (result);
@@ -78,21 +78,18 @@ pthread_kill (pthread_t thread, int sig)
  */
 {
   int result = 0;
-  pte_thread_t * tp;
-
-
-  pte_osMutexLock (pte_thread_reuse_lock);
-
-  tp = (pte_thread_t *) thread;
+  pte_thread_t * tp = (pte_thread_t *) thread;
 
+  /*
+   * Thread structs are not recycled, so checking the handle needs no
+   * lock: the OS handle is stored once by pthread_create().
+   */
   if (0 == tp
       || 0 == tp->threadId)
     {
       result = ESRCH;
     }
 
-  pte_osMutexUnlock(pte_thread_reuse_lock);
-
   if (0 == result && 0 != sig)
     {
       /*
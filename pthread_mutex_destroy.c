@@ -58,13 +58,17 @@ pthread_mutex_destroy (pthread_mutex_t * mutex)
    * Let the system deal with invalid pointers.
    */
 
+  /*
+   * Read the mutex once: another thread may be replacing a static
+   * initializer with a real mutex at the same time.
+   */
+  mx = *mutex;
+
   /*
    * Check to see if we have something to delete.
    */
-  if (*mutex < PTHREAD_ERRORCHECK_MUTEX_INITIALIZER)
+  if (mx < PTHREAD_ERRORCHECK_MUTEX_INITIALIZER)
     {
-      mx = *mutex;
-
       result = pthread_mutex_trylock (&mx);
 
       /*
@@ -92,9 +96,17 @@ pthread_mutex_destroy (pthread_mutex_t * mutex)
 
               if (result == 0)
                 {
+#ifdef PTE_MUTEX_STATS
+                  pte_mutex_stats_unlink (mx);
+#endif
+
+#ifdef PTE_SYNC_REGISTRY
+                  pte_sync_unregister (mx->syncEntry);
+#endif
+
                   pte_osSemaphoreDelete(mx->handle);
 
-                  free(mx);
+                  pte_free (PTE_ALLOC_MUTEX, mx, sizeof (*mx));
 
                 }
               else
@@ -121,33 +133,22 @@ pthread_mutex_destroy (pthread_mutex_t * mutex)
        * See notes in pte_mutex_check_need_init() above also.
        */
 
-      pte_osMutexLock (pte_mutex_test_init_lock);
-
-
       /*
-       * Check again.
+       * This is all we need to do to destroy a statically
+       * initialised mutex that has not yet been used (initialised).
+       * A thread initialising it meanwhile will fail to install its
+       * mutex and get EINVAL. The exchange is made against the
+       * initializer read above, never against a real mutex.
        */
-      if (*mutex >= PTHREAD_ERRORCHECK_MUTEX_INITIALIZER)
+      if (PTE_ATOMIC_COMPARE_EXCHANGE_PTR ((void * volatile *) mutex, NULL,
+                                           (void *) mx) != (void *) mx)
         {
           /*
-           * This is all we need to do to destroy a statically
-           * initialised mutex that has not yet been used (initialised).
-           * If we get to here, another thread
-           * waiting to initialise this mutex will get an EINVAL.
-           */
-          *mutex = NULL;
-        }
-      else
-        {
-          /*
-           * The mutex has been initialised while we were waiting
+           * The mutex has been initialised meanwhile
            * so assume it's in use.
            */
           result = EBUSY;
         }
-
-      pte_osMutexUnlock(pte_mutex_test_init_lock);
-
     }
 
   return (result);
@@ -0,0 +1,105 @@
+/*
+ * pthread_mutex_getstats_np.c
+ *
+ * Description:
+ * This translation unit implements reading mutex contention statistics.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <string.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pthread_mutex_getstats_np (pthread_mutex_t * mutex, pte_mutex_stats_t * stats)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function returns the contention statistics
+ *      gathered for a mutex.
+ *
+ * PARAMETERS
+ *      mutex
+ *              pointer to an instance of pthread_mutex_t
+ *
+ *      stats
+ *              receives the statistics; see pthread_np.h
+ *
+ *
+ * DESCRIPTION
+ *      Returns the statistics gathered while
+ *      pte_mutex_stats_enable_np() was on. A statically
+ *      initialised mutex that has not been used yet has no
+ *      statistics, and all of its counters read as zero.
+ *
+ *      The mutex is not locked while the statistics are read,
+ *      so while it is in use the fields may describe slightly
+ *      different moments.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully read statistics,
+ *              EINVAL          'mutex' or 'stats' is invalid,
+ *              ENOTSUP         library built without PTE_MUTEX_STATS.
+ *
+ * ------------------------------------------------------
+ */
+{
+#ifdef PTE_MUTEX_STATS
+  if (mutex == NULL || *mutex == NULL || stats == NULL)
+    {
+      return EINVAL;
+    }
+
+  if (*mutex >= PTHREAD_ERRORCHECK_MUTEX_INITIALIZER)
+    {
+      memset (stats, 0, sizeof (*stats));
+    }
+  else
+    {
+      pte_mutex_stats_get (*mutex, stats);
+    }
+
+  return 0;
+#else
+  return ENOTSUP;
+#endif
+}
@@ -59,7 +59,7 @@ pthread_mutex_init (pthread_mutex_t * mutex, const pthread_mutexattr_t * attr)
       return EINVAL;
     }
 
-  mx = (pthread_mutex_t) calloc (1, sizeof (*mx));
+  mx = (pthread_mutex_t) pte_alloc (PTE_ALLOC_MUTEX, sizeof (*mx));
 
   if (mx == NULL)
     {
@@ -73,8 +73,25 @@ pthread_mutex_init (pthread_mutex_t * mutex, const pthread_mutexattr_t * attr)
                   ? PTHREAD_MUTEX_DEFAULT : (*attr)->kind);
       mx->ownerThread = 0;
 
+      if (attr != NULL && *attr != NULL)
+        {
+          mx->protocol = (*attr)->protocol;
+          mx->prioceiling = (*attr)->prioceiling;
+        }
+
+      mx->prioBoost = (mx->protocol == PTHREAD_PRIO_PROTECT
+                       ? mx->prioceiling : pte_prio_lowest ());
+
       pte_osSemaphoreCreate(0,&mx->handle);
 
+#ifdef PTE_MUTEX_STATS
+      pte_mutex_stats_link (mx);
+#endif
+
+#ifdef PTE_SYNC_REGISTRY
+      mx->syncEntry = pte_sync_register (PTE_SYNC_MUTEX, mx);
+#endif
+
     }
 
   *mutex = mx;
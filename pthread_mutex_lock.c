@@ -52,6 +52,12 @@ pthread_mutex_lock (pthread_mutex_t * mutex)
 {
   int result = 0;
   pthread_mutex_t mx;
+#ifdef PTE_MUTEX_STATS
+  unsigned long long waitStart = 0;
+#endif
+#ifdef PTE_SYNC_REGISTRY
+  unsigned long long syncStart;
+#endif
 
   /*
    * Let the system deal with invalid pointers.
@@ -77,30 +83,86 @@ pthread_mutex_lock (pthread_mutex_t * mutex)
 
   mx = *mutex;
 
+  if (mx->protocol != PTHREAD_PRIO_NONE)
+    {
+      if ((result = pte_mutex_prio_check (mx)) != 0)
+        {
+          return (result);
+        }
+    }
+
   if (mx->kind == PTHREAD_MUTEX_NORMAL)
     {
-      if (PTE_ATOMIC_EXCHANGE(
+      if (PTE_ATOMIC_EXCHANGE_ACQUIRE(
             &mx->lock_idx,
             1) != 0)
         {
-          while (PTE_ATOMIC_EXCHANGE(&mx->lock_idx,-1) != 0)
+#ifdef PTE_MUTEX_STATS
+          waitStart = pte_mutex_stats_wait_start ();
+#endif
+#ifdef PTE_SYNC_REGISTRY
+          syncStart = pte_osClockGetMicros ();
+#endif
+          PTE_TRACE (PTE_TRACE_BLOCK, mx);
+          while (PTE_ATOMIC_EXCHANGE_ACQUIRE(&mx->lock_idx,-1) != 0)
             {
+              if (mx->protocol == PTHREAD_PRIO_INHERIT)
+                {
+                  pte_mutex_prio_wait (mx);
+                }
+
               if (pte_osSemaphorePend(mx->handle,NULL) != PTE_OS_OK)
                 {
                   result = EINVAL;
                   break;
                 }
             }
+          PTE_TRACE (PTE_TRACE_WAKE, mx);
+
+#ifdef PTE_SYNC_REGISTRY
+          pte_sync_waited (mx->syncEntry, syncStart);
+#endif
+        }
+
+#ifdef PTE_MUTEX_STATS
+      if (0 == result && pte_mutex_stats_enabled)
+        {
+          pte_mutex_stats_acquired (mx, waitStart);
+        }
+#endif
+
+      if (mx->protocol != PTHREAD_PRIO_NONE)
+        {
+          if (0 == result)
+            {
+              pte_mutex_prio_acquired (mx);
+            }
+          else
+            {
+              pte_mutex_prio_abandon (mx);
+            }
         }
     }
   else
     {
       pthread_t self = pthread_self();
 
-      if (PTE_ATOMIC_COMPARE_EXCHANGE(&mx->lock_idx,1,0) == 0)
+      if (PTE_ATOMIC_COMPARE_EXCHANGE_ACQUIRE(&mx->lock_idx,1,0) == 0)
         {
           mx->recursive_count = 1;
           mx->ownerThread = self;
+
+#ifdef PTE_MUTEX_STATS
+          if (pte_mutex_stats_enabled)
+            {
+              pte_mutex_stats_acquired (mx, 0);
+            }
+#endif
+
+          if (mx->protocol != PTHREAD_PRIO_NONE)
+            {
+              pte_mutex_prio_acquired (mx);
+            }
         }
       else
         {
@@ -117,19 +179,52 @@ pthread_mutex_lock (pthread_mutex_t * mutex)
             }
           else
             {
-              while (PTE_ATOMIC_EXCHANGE(&mx->lock_idx,-1) != 0)
+#ifdef PTE_MUTEX_STATS
+              waitStart = pte_mutex_stats_wait_start ();
+#endif
+#ifdef PTE_SYNC_REGISTRY
+              syncStart = pte_osClockGetMicros ();
+#endif
+              PTE_TRACE (PTE_TRACE_BLOCK, mx);
+              while (PTE_ATOMIC_EXCHANGE_ACQUIRE(&mx->lock_idx,-1) != 0)
                 {
+                  if (mx->protocol == PTHREAD_PRIO_INHERIT)
+                    {
+                      pte_mutex_prio_wait (mx);
+                    }
+
                   if (pte_osSemaphorePend(mx->handle,NULL) != PTE_OS_OK)
                     {
                       result = EINVAL;
                       break;
                     }
                 }
+              PTE_TRACE (PTE_TRACE_WAKE, mx);
+
+#ifdef PTE_SYNC_REGISTRY
+              pte_sync_waited (mx->syncEntry, syncStart);
+#endif
 
               if (0 == result)
                 {
                   mx->recursive_count = 1;
                   mx->ownerThread = self;
+
+#ifdef PTE_MUTEX_STATS
+                  if (pte_mutex_stats_enabled)
+                    {
+                      pte_mutex_stats_acquired (mx, waitStart);
+                    }
+#endif
+
+                  if (mx->protocol != PTHREAD_PRIO_NONE)
+                    {
+                      pte_mutex_prio_acquired (mx);
+                    }
+                }
+              else if (mx->protocol != PTHREAD_PRIO_NONE)
+                {
+                  pte_mutex_prio_abandon (mx);
                 }
             }
         }
@@ -0,0 +1,118 @@
+/*
+ * pthread_mutex_resetstats_np.c
+ *
+ * Description:
+ * This translation unit implements clearing mutex contention statistics.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <string.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pthread_mutex_resetstats_np (pthread_mutex_t * mutex)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function clears the contention statistics
+ *      gathered for a mutex.
+ *
+ * PARAMETERS
+ *      mutex
+ *              pointer to an instance of pthread_mutex_t
+ *
+ *
+ * DESCRIPTION
+ *      The statistics are only updated by the mutex owner,
+ *      so this function briefly locks the mutex to clear
+ *      them. The calling thread must not already hold it.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully cleared statistics,
+ *              EINVAL          'mutex' is invalid,
+ *              EDEADLK         the calling thread holds the
+ *                              (error checking) mutex,
+ *              ENOTSUP         library built without PTE_MUTEX_STATS.
+ *
+ * ------------------------------------------------------
+ */
+{
+#ifdef PTE_MUTEX_STATS
+  pthread_mutex_t mx;
+  int result;
+
+  if (mutex == NULL || *mutex == NULL)
+    {
+      return EINVAL;
+    }
+
+  if (*mutex >= PTHREAD_ERRORCHECK_MUTEX_INITIALIZER)
+    {
+      /* Never used, so there is nothing to clear */
+      return 0;
+    }
+
+  mx = *mutex;
+
+  if (mx->kind == PTHREAD_MUTEX_RECURSIVE &&
+      pthread_equal (mx->ownerThread, pthread_self ()))
+    {
+      return EDEADLK;
+    }
+
+  if ((result = pthread_mutex_lock (mutex)) != 0)
+    {
+      return result;
+    }
+
+  memset (&mx->stats, 0, sizeof (mx->stats));
+  (void) PTE_ATOMIC_EXCHANGE (&mx->statsFailures, 0);
+
+  /* Don't count this hold either */
+  mx->holdStart = 0;
+
+  return pthread_mutex_unlock (mutex);
+#else
+  return ENOTSUP;
+#endif
+}
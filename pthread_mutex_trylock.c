@@ -70,13 +70,33 @@ pthread_mutex_trylock (pthread_mutex_t * mutex)
 
   mx = *mutex;
 
-  if (0 == PTE_ATOMIC_COMPARE_EXCHANGE (&mx->lock_idx,1,0))
+  if (mx->protocol != PTHREAD_PRIO_NONE)
+    {
+      if ((result = pte_mutex_prio_check (mx)) != 0)
+        {
+          return (result);
+        }
+    }
+
+  if (0 == PTE_ATOMIC_COMPARE_EXCHANGE_ACQUIRE (&mx->lock_idx,1,0))
     {
       if (mx->kind != PTHREAD_MUTEX_NORMAL)
         {
           mx->recursive_count = 1;
           mx->ownerThread = pthread_self ();
         }
+
+#ifdef PTE_MUTEX_STATS
+      if (pte_mutex_stats_enabled)
+        {
+          pte_mutex_stats_acquired (mx, 0);
+        }
+#endif
+
+      if (mx->protocol != PTHREAD_PRIO_NONE)
+        {
+          pte_mutex_prio_acquired (mx);
+        }
     }
   else
     {
@@ -88,6 +108,13 @@ pthread_mutex_trylock (pthread_mutex_t * mutex)
       else
         {
           result = EBUSY;
+
+#ifdef PTE_MUTEX_STATS
+          if (pte_mutex_stats_enabled)
+            {
+              pte_mutex_stats_failed (mx);
+            }
+#endif
         }
     }
 
@@ -70,11 +70,25 @@ pthread_mutex_unlock (pthread_mutex_t * mutex)
    */
   if (mx < PTHREAD_ERRORCHECK_MUTEX_INITIALIZER)
     {
+      int protocol = mx->protocol;
+
       if (mx->kind == PTHREAD_MUTEX_NORMAL)
         {
           int idx;
 
-          idx = PTE_ATOMIC_EXCHANGE (&mx->lock_idx,0);
+          if (protocol != PTHREAD_PRIO_NONE)
+            {
+              pte_mutex_prio_release (mx);
+            }
+
+#ifdef PTE_MUTEX_STATS
+          if (mx->holdStart != 0)
+            {
+              pte_mutex_stats_released (mx);
+            }
+#endif
+
+          idx = PTE_ATOMIC_EXCHANGE_RELEASE (&mx->lock_idx,0);
           if (idx != 0)
             {
               if (idx < 0)
@@ -82,6 +96,7 @@ pthread_mutex_unlock (pthread_mutex_t * mutex)
                   /*
                    * Someone may be waiting on that mutex.
                    */
+                  PTE_TRACE (PTE_TRACE_HANDOFF, mx);
                   if (pte_osSemaphorePost(mx->handle,1) != PTE_OS_OK)
                     {
                       result = EINVAL;
@@ -103,10 +118,23 @@ pthread_mutex_unlock (pthread_mutex_t * mutex)
               if (mx->kind != PTHREAD_MUTEX_RECURSIVE
                   || 0 == --mx->recursive_count)
                 {
+                  if (protocol != PTHREAD_PRIO_NONE)
+                    {
+                      pte_mutex_prio_release (mx);
+                    }
+
                   mx->ownerThread = 0;
 
-                  if (PTE_ATOMIC_EXCHANGE (&mx->lock_idx,0) < 0)
+#ifdef PTE_MUTEX_STATS
+                  if (mx->holdStart != 0)
+                    {
+                      pte_mutex_stats_released (mx);
+                    }
+#endif
+
+                  if (PTE_ATOMIC_EXCHANGE_RELEASE (&mx->lock_idx,0) < 0)
                     {
+                      PTE_TRACE (PTE_TRACE_HANDOFF, mx);
                       if (pte_osSemaphorePost(mx->handle,1) != PTE_OS_OK)
                         {
                           result = EINVAL;
@@ -120,6 +148,15 @@ pthread_mutex_unlock (pthread_mutex_t * mutex)
               result = EPERM;
             }
         }
+
+      /*
+       * Drop any priority boost only now that the mutex has been
+       * handed on; mx must not be touched from here on.
+       */
+      if (protocol != PTHREAD_PRIO_NONE)
+        {
+          pte_thread_prio_update ((pte_thread_t *) pthread_self ());
+        }
     }
   else
     {
@@ -84,7 +84,7 @@ pthread_mutexattr_destroy (pthread_mutexattr_t * attr)
       pthread_mutexattr_t ma = *attr;
 
       *attr = NULL;
-      free (ma);
+      pte_free (PTE_ALLOC_ATTR, ma, sizeof (*ma));
     }
 
   return (result);
@@ -76,7 +76,7 @@ pthread_mutexattr_init (pthread_mutexattr_t * attr)
   int result = 0;
   pthread_mutexattr_t ma;
 
-  ma = (pthread_mutexattr_t) calloc (1, sizeof (*ma));
+  ma = (pthread_mutexattr_t) pte_alloc (PTE_ALLOC_ATTR, sizeof (*ma));
 
   if (ma == NULL)
     {
@@ -86,6 +86,8 @@ pthread_mutexattr_init (pthread_mutexattr_t * attr)
     {
       ma->pshared = PTHREAD_PROCESS_PRIVATE;
       ma->kind = PTHREAD_MUTEX_DEFAULT;
+      ma->protocol = PTHREAD_PRIO_NONE;
+      ma->prioceiling = pte_prio_highest ();
     }
 
   *attr = ma;
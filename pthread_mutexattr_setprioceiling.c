@@ -0,0 +1,91 @@
+/*
+ * pthread_mutexattr_setprioceiling.c
+ *
+ * Description:
+ * This translation unit implements mutual exclusion (mutex) primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pthread_mutexattr_setprioceiling (pthread_mutexattr_t * attr,
+                                  int prioceiling)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function sets the priority ceiling of mutexes
+ *      created with 'attr'.
+ *
+ * PARAMETERS
+ *      attr
+ *              pointer to an instance of pthread_mutexattr_t
+ *
+ *      prioceiling
+ *              a priority between sched_get_priority_min()
+ *              and sched_get_priority_max().
+ *
+ *
+ * DESCRIPTION
+ *      The ceiling only has an effect on mutexes whose
+ *      protocol is PTHREAD_PRIO_PROTECT. The default
+ *      ceiling is the highest priority.
+ *
+ * RESULTS
+ *              0               successfully set attribute,
+ *              EINVAL          'attr' or 'prioceiling' is invalid.
+ *
+ * ------------------------------------------------------
+ */
+{
+  if (attr == NULL || *attr == NULL)
+    {
+      return EINVAL;
+    }
+
+  if (prioceiling < pte_osThreadGetMinPriority () ||
+      prioceiling > pte_osThreadGetMaxPriority ())
+    {
+      return EINVAL;
+    }
+
+  (*attr)->prioceiling = prioceiling;
+
+  return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * pthread_mutexattr_setprotocol.c
+ *
+ * Description:
+ * This translation unit implements mutual exclusion (mutex) primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pthread_mutexattr_setprotocol (pthread_mutexattr_t * attr, int protocol)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function sets the protocol that mutexes created
+ *      with 'attr' follow when a higher priority thread
+ *      blocks on them.
+ *
+ * PARAMETERS
+ *      attr
+ *              pointer to an instance of pthread_mutexattr_t
+ *
+ *      protocol
+ *              must be one of:
+ *
+ *                      PTHREAD_PRIO_NONE
+ *
+ *                      PTHREAD_PRIO_INHERIT
+ *
+ *                      PTHREAD_PRIO_PROTECT
+ *
+ *
+ * DESCRIPTION
+ *      PTHREAD_PRIO_NONE
+ *              Owning the mutex does not affect the owner's
+ *              priority. This is the default.
+ *
+ *      PTHREAD_PRIO_INHERIT
+ *              While a thread owns the mutex and higher priority
+ *              threads are blocked on it, the owner runs at the
+ *              priority of the highest of those threads. The
+ *              boost follows chains of such mutexes.
+ *
+ *      PTHREAD_PRIO_PROTECT
+ *              While a thread owns the mutex it runs at no lower
+ *              than the mutex's priority ceiling (see
+ *              pthread_mutexattr_setprioceiling). Threads whose
+ *              priority is above the ceiling may not lock it.
+ *
+ *      Priorities are changed through pte_osThreadSetPriority().
+ *      Mutexes using PTHREAD_PRIO_NONE take no extra steps.
+ *
+ * RESULTS
+ *              0               successfully set attribute,
+ *              EINVAL          'attr' or 'protocol' is invalid.
+ *
+ * ------------------------------------------------------
+ */
+{
+  int result = 0;
+
+  if ((attr != NULL && *attr != NULL))
+    {
+      switch (protocol)
+        {
+        case PTHREAD_PRIO_NONE:
+        case PTHREAD_PRIO_INHERIT:
+        case PTHREAD_PRIO_PROTECT:
+          (*attr)->protocol = protocol;
+          break;
+        default:
+          result = EINVAL;
+          break;
+        }
+    }
+  else
+    {
+      result = EINVAL;
+    }
+
+  return (result);
+}				/* pthread_mutexattr_setprotocol */
@@ -0,0 +1,371 @@
+/*
+ * pthread_np.h
+ *
+ * Description:
+ * Non-portable extensions to the POSIX threads API provided by
+ * Pthreads-embedded. Functions declared here carry the _np suffix.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#ifndef _PTHREAD_NP_H
+#define _PTHREAD_NP_H
+
+#include <stdio.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+/*
+ * Mutex protocols for pthread_mutexattr_setprotocol()
+ */
+#ifndef PTHREAD_PRIO_NONE
+#define PTHREAD_PRIO_NONE       0
+#define PTHREAD_PRIO_INHERIT    1
+#define PTHREAD_PRIO_PROTECT    2
+#endif
+
+/*
+ * Default queue size for pte_pool_create_np()
+ */
+#ifndef PTE_POOL_DEFAULT_QUEUE
+#define PTE_POOL_DEFAULT_QUEUE  256
+#endif
+
+/*
+ * A "file:line" string naming the current source line, for use as a
+ * tag with pte_sync_settag_np()
+ */
+#define PTE_SYNC_STR_(x)        #x
+#define PTE_SYNC_STR(x)         PTE_SYNC_STR_(x)
+#define PTE_SYNC_SITE           __FILE__ ":" PTE_SYNC_STR(__LINE__)
+
+/*
+ * Scheduling trace events (see pte_set_trace_hooks_np)
+ */
+#define PTE_TRACE_BLOCK         0
+#define PTE_TRACE_WAKE          1
+#define PTE_TRACE_HANDOFF       2
+#define PTE_TRACE_CREATE        3
+#define PTE_TRACE_EXIT          4
+#define PTE_TRACE_CANCEL        5
+
+/*
+ * Allocation types (see pte_set_allocator_np)
+ */
+#define PTE_ALLOC_THREAD        0
+#define PTE_ALLOC_THREADPARMS   1
+#define PTE_ALLOC_KEY           2
+#define PTE_ALLOC_KEYASSOC      3
+#define PTE_ALLOC_MUTEX         4
+#define PTE_ALLOC_COND          5
+#define PTE_ALLOC_SEM           6
+#define PTE_ALLOC_RWLOCK        7
+#define PTE_ALLOC_BARRIER       8
+#define PTE_ALLOC_SPIN          9
+#define PTE_ALLOC_ATTR          10
+#define PTE_ALLOC_TLS           11
+#define PTE_ALLOC_POOL          12
+#define PTE_ALLOC_MISC          13
+#define PTE_ALLOC_SLAB          14
+#define PTE_ALLOC_TYPES         15
+
+/*
+ * Static initializer for pte_lock_t
+ */
+#define PTE_LOCK_INITIALIZER    {0}
+
+/*
+ * Spinlock kinds (see pthread_spin_init_np)
+ */
+#define PTHREAD_SPIN_TTAS_NP    0	/* Default */
+#define PTHREAD_SPIN_TICKET_NP  1	/* FIFO */
+
+#ifdef __cplusplus
+extern "C"
+  {
+#endif				/* __cplusplus */
+
+  /*
+   * CPU affinity
+   *
+   * A CPU mask is a bit set in which bit n selects processor n.
+   * A mask of zero in a thread attributes object means "no
+   * affinity requested", i.e. the OS default placement.
+   */
+  int pthread_attr_setaffinity_np (pthread_attr_t * attr,
+                                   unsigned int cpumask);
+
+  int pthread_attr_getaffinity_np (const pthread_attr_t * attr,
+                                   unsigned int *cpumask);
+
+  int pthread_setaffinity_np (pthread_t thread,
+                              unsigned int cpumask);
+
+  int pthread_getaffinity_np (pthread_t thread,
+                              unsigned int *cpumask);
+
+  /*
+   * Thread stacks
+   *
+   * pthread_attr_setstack() is POSIX; it is declared here for SDK
+   * headers that predate it. pthread_setstackpool_np() controls the
+   * library managed pool of thread stacks.
+   */
+  int pthread_attr_setstack (pthread_attr_t * attr,
+                             void *stackaddr,
+                             size_t stacksize);
+
+  int pthread_attr_getstack (const pthread_attr_t * attr,
+                             void **stackaddr,
+                             size_t * stacksize);
+
+  int pthread_setstackpool_np (int maxstacks, size_t guardsize);
+
+  /*
+   * Non-blocking, timed and multiple joins
+   *
+   * As pthread_join(), but give up with EBUSY, or with ETIMEDOUT at
+   * 'abstime', if the thread has not finished, or join whichever of
+   * several threads finishes first, or all of them.
+   */
+  int pthread_tryjoin_np (pthread_t thread, void **value_ptr);
+
+  int pthread_timedjoin_np (pthread_t thread, void **value_ptr,
+                            const struct timespec *abstime);
+
+  int pthread_join_any_np (pthread_t * threads, int n,
+                           int *which, void **value_ptr);
+
+  int pthread_join_batch_np (pthread_t * threads, int n,
+                             void **value_ptrs);
+
+  /*
+   * Mutex protocols
+   *
+   * Declared here for SDK headers that predate them.
+   */
+  int pthread_mutexattr_setprotocol (pthread_mutexattr_t * attr,
+                                     int protocol);
+
+  int pthread_mutexattr_getprotocol (const pthread_mutexattr_t * attr,
+                                     int *protocol);
+
+  int pthread_mutexattr_setprioceiling (pthread_mutexattr_t * attr,
+                                        int prioceiling);
+
+  int pthread_mutexattr_getprioceiling (const pthread_mutexattr_t * attr,
+                                        int *prioceiling);
+
+  /*
+   * Thread pool
+   *
+   * A fixed set of worker threads that run submitted tasks.
+   */
+  typedef struct pte_pool_t_ * pte_pool_t;
+
+  int pte_pool_create_np (pte_pool_t * pool,
+                          int nthreads,
+                          int queuesize,
+                          const pthread_attr_t * attr);
+
+  int pte_pool_submit_np (pte_pool_t pool,
+                          void (*routine) (void *),
+                          void *arg);
+
+  int pte_pool_wait_np (pte_pool_t pool);
+
+  int pte_pool_destroy_np (pte_pool_t pool);
+
+  /*
+   * Work-stealing task scheduler
+   *
+   * Fork/join parallelism: every spawned task must be synced exactly
+   * once.
+   */
+  typedef struct pte_task_t_ * pte_task_t;
+
+  int pte_task_init_np (int nworkers);
+
+  int pte_task_shutdown_np (void);
+
+  int pte_task_spawn_np (pte_task_t * task,
+                         void (*routine) (void *),
+                         void *arg);
+
+  int pte_task_sync_np (pte_task_t task);
+
+  /*
+   * Waiting on several semaphores
+   *
+   * Blocks until one of 'n' semaphores can be decremented, and
+   * decrements exactly that one.
+   */
+  int sem_wait_any_np (sem_t ** sems, int n, int *which,
+                       const struct timespec *abstime);
+
+  /*
+   * Mutex contention statistics
+   *
+   * Only gathered when the library is built with PTE_MUTEX_STATS
+   * defined, and then only while enabled with
+   * pte_mutex_stats_enable_np(). Times are in microseconds.
+   */
+  typedef struct
+    {
+      unsigned long acquisitions;	/* Times the mutex was acquired */
+      unsigned long contended;	/* Acquisitions that had to wait */
+      unsigned long failures;	/* Trylock EBUSY and timedlock ETIMEDOUT */
+      unsigned long long waitTotal;	/* Time spent waiting to acquire */
+      unsigned long long waitMax;
+      unsigned long long holdTotal;	/* Time spent holding */
+      unsigned long long holdMax;
+    } pte_mutex_stats_t;
+
+  int pte_mutex_stats_enable_np (int enable);
+
+  int pthread_mutex_getstats_np (pthread_mutex_t * mutex,
+                                 pte_mutex_stats_t * stats);
+
+  int pthread_mutex_resetstats_np (pthread_mutex_t * mutex);
+
+  int pte_mutex_stats_top_np (int count,
+                              void (*callback) (pthread_mutex_t mutex,
+                                                const pte_mutex_stats_t * stats,
+                                                void *arg),
+                              void *arg);
+
+  /*
+   * Sync object registry
+   *
+   * Only available when the library is built with PTE_SYNC_REGISTRY
+   * defined. Every mutex, rwlock, condition variable, semaphore, spin
+   * lock and barrier is then registered when it is created, and the
+   * time threads spend blocked on it is recorded.
+   */
+  int pte_sync_settag_np (const void *object, const char *tag);
+
+  int pte_dump_sync_stats_np (FILE * stream);
+
+  int pte_sync_reporter_np (FILE * stream, unsigned int intervalMsecs);
+
+  /*
+   * Scheduling tracepoints
+   *
+   * Each hook is called in the thread the event happens in: block
+   * just before a thread waits on the object, wake just after the
+   * wait ends, handoff when a thread wakes others waiting on the
+   * object, create, exit and cancel with the pthread_t concerned as
+   * the object. Hooks may be NULL and must not block.
+   */
+  typedef struct
+    {
+      void (*block) (const void *object, void *arg);
+      void (*wake) (const void *object, void *arg);
+      void (*handoff) (const void *object, void *arg);
+      void (*create) (const void *object, void *arg);
+      void (*exit) (const void *object, void *arg);
+      void (*cancel) (const void *object, void *arg);
+      void *arg;
+    } pte_trace_hooks_t;
+
+  int pte_set_trace_hooks_np (const pte_trace_hooks_t * hooks);
+
+  int pte_trace_start_np (int eventsPerThread);
+
+  int pte_trace_stop_np (void);
+
+  int pte_trace_dump_np (FILE * stream);
+
+  /*
+   * Allocator hooks
+   *
+   * Every allocation the library makes goes through alloc, and is
+   * given back through free with the same size and type (one of the
+   * PTE_ALLOC_* types above), even if another allocator has been
+   * installed meanwhile.
+   */
+  typedef struct
+    {
+      void *(*alloc) (size_t size, int type, void *arg);
+      void (*free) (void *ptr, size_t size, int type, void *arg);
+      void *arg;
+    } pte_allocator_t;
+
+  typedef struct
+    {
+      unsigned long objects;	/* Outstanding allocations */
+      unsigned long bytes;	/* Outstanding bytes */
+      unsigned long allocs;	/* Allocations made in total */
+      unsigned long failures;	/* Allocations that failed */
+    } pte_alloc_stats_t;
+
+  int pte_set_allocator_np (const pte_allocator_t * allocator);
+
+  int pte_get_alloc_stats_np (int type, pte_alloc_stats_t * stats);
+
+  /*
+   * Inline locks
+   *
+   * A pte_lock_t is a non-recursive mutex held entirely in the
+   * caller's storage: it needs no allocation, no destroy and no
+   * first-use initialisation, so it can be embedded in other
+   * structures or initialised with PTE_LOCK_INITIALIZER.
+   */
+  typedef struct
+    {
+      int state;
+    } pte_lock_t;
+
+  int pte_lock_init_np (pte_lock_t * lock);
+
+  int pte_lock_np (pte_lock_t * lock);
+
+  int pte_trylock_np (pte_lock_t * lock);
+
+  int pte_unlock_np (pte_lock_t * lock);
+
+  /*
+   * Spinlock kinds
+   */
+  int pthread_spin_init_np (pthread_spinlock_t * lock,
+                            int pshared,
+                            int kind);
+
+#ifdef __cplusplus
+  }
+#endif				/* __cplusplus */
+
+#endif				/* _PTHREAD_NP_H */
@@ -48,6 +48,13 @@
 #define PTE_ONCE_INIT 0
 #define PTE_ONCE_DONE 2
 
+/*
+ * once_control->semaphore is a void * holding an OS semaphore handle,
+ * which may be an int or a pointer depending on the OS.
+ */
+#define PTE_ONCE_SEMAPHORE(p) ((pte_osSemaphoreHandle) (size_t) (p))
+#define PTE_ONCE_POINTER(h) ((void *) (size_t) (h))
+
 static void
 pte_once_init_routine_cleanup(void * arg)
 {
@@ -55,9 +62,9 @@ pte_once_init_routine_cleanup(void * arg)
 
   (void) PTE_ATOMIC_EXCHANGE(&once_control->state,PTE_ONCE_INIT);
 
-  if (PTE_ATOMIC_EXCHANGE_ADD((int*)&once_control->semaphore, 0L)) /* MBR fence */
+  if (PTE_ATOMIC_LOAD_PTR(&once_control->semaphore)) /* MBR fence */
     {
-      pte_osSemaphorePost((pte_osSemaphoreHandle) once_control->semaphore, 1);
+      pte_osSemaphorePost(PTE_ONCE_SEMAPHORE(once_control->semaphore), 1);
     }
 }
 
@@ -114,6 +121,15 @@ pthread_once (pthread_once_t * once_control, void (*init_routine) (void))
       result = 0;
     }
 
+  /*
+   * Once the routine has run every call ends here, so this only
+   * needs to acquire what the initialising thread published.
+   */
+  if (PTE_ATOMIC_LOAD_ACQUIRE (&once_control->state) == PTE_ONCE_DONE)
+    {
+      return 0;
+    }
+
   while ((state =
             PTE_ATOMIC_COMPARE_EXCHANGE(&once_control->state,
                                         PTE_ONCE_STARTED,
@@ -134,22 +150,22 @@ pthread_once (pthread_once_t * once_control, void (*init_routine) (void))
            * we didn't create the semaphore.
            * it is only there if there is someone waiting.
            */
-          if (PTE_ATOMIC_EXCHANGE_ADD((int*)&once_control->semaphore, 0L)) /* MBR fence */
+          if (PTE_ATOMIC_LOAD_PTR(&once_control->semaphore)) /* MBR fence */
             {
-              pte_osSemaphorePost((pte_osSemaphoreHandle) once_control->semaphore,once_control->numSemaphoreUsers);
+              pte_osSemaphorePost(PTE_ONCE_SEMAPHORE(once_control->semaphore),once_control->numSemaphoreUsers);
             }
         }
       else
         {
           PTE_ATOMIC_INCREMENT(&once_control->numSemaphoreUsers);
 
-          if (!PTE_ATOMIC_EXCHANGE_ADD((int*)&once_control->semaphore, 0L)) /* MBR fence */
+          if (!PTE_ATOMIC_LOAD_PTR(&once_control->semaphore)) /* MBR fence */
             {
-              pte_osSemaphoreCreate(0, (pte_osSemaphoreHandle*) &sema);
+              pte_osSemaphoreCreate(0, &sema);
 
-              if (PTE_ATOMIC_COMPARE_EXCHANGE((int *) &once_control->semaphore,
-                                              (int) sema,
-                                              0))
+              if (PTE_ATOMIC_COMPARE_EXCHANGE_PTR(&once_control->semaphore,
+                                                  PTE_ONCE_POINTER(sema),
+                                                  NULL))
                 {
                   pte_osSemaphoreDelete((pte_osSemaphoreHandle)sema);
                 }
@@ -161,16 +177,19 @@ pthread_once (pthread_once_t * once_control, void (*init_routine) (void))
            */
           if (PTE_ATOMIC_EXCHANGE_ADD(&once_control->state, 0L) == PTE_ONCE_STARTED)
             {
-              pte_osSemaphorePend((pte_osSemaphoreHandle) once_control->semaphore,NULL);
+              pte_osSemaphorePend(PTE_ONCE_SEMAPHORE(once_control->semaphore),NULL);
             }
 
           if (0 == PTE_ATOMIC_DECREMENT(&once_control->numSemaphoreUsers))
             {
               /* we were last */
-              if ((sema =
-                     (pte_osSemaphoreHandle) PTE_ATOMIC_EXCHANGE((int *) &once_control->semaphore,0)))
+              void *p = PTE_ATOMIC_LOAD_PTR(&once_control->semaphore);
+
+              if (p != NULL &&
+                  PTE_ATOMIC_COMPARE_EXCHANGE_PTR(&once_control->semaphore,
+                                                  NULL, p) == p)
                 {
-                  pte_osSemaphoreDelete(sema);
+                  pte_osSemaphoreDelete(PTE_ONCE_SEMAPHORE(p));
                 }
             }
         }
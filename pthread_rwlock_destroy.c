@@ -111,7 +111,10 @@ pthread_rwlock_destroy (pthread_rwlock_t * rwlock)
           result = pthread_cond_destroy (&(rwl->cndSharedAccessCompleted));
           result1 = pthread_mutex_destroy (&(rwl->mtxSharedAccessCompleted));
           result2 = pthread_mutex_destroy (&(rwl->mtxExclusiveAccess));
-          (void) free (rwl);
+#ifdef PTE_SYNC_REGISTRY
+          pte_sync_unregister (rwl->syncEntry);
+#endif
+          pte_free (PTE_ALLOC_RWLOCK, rwl, sizeof (*rwl));
         }
     }
   else
@@ -120,32 +123,23 @@ pthread_rwlock_destroy (pthread_rwlock_t * rwlock)
        * See notes in pte_rwlock_check_need_init() above also.
        */
 
-      pte_osMutexLock (pte_rwlock_test_init_lock);
-
       /*
-       * Check again.
+       * This is all we need to do to destroy a statically
+       * initialised rwlock that has not yet been used (initialised).
+       * A thread initialising it meanwhile will fail to install its
+       * rwlock and get EINVAL.
        */
-      if (*rwlock == PTHREAD_RWLOCK_INITIALIZER)
+      if (PTE_ATOMIC_COMPARE_EXCHANGE_PTR ((void * volatile *) rwlock, NULL,
+                                           (void *) PTHREAD_RWLOCK_INITIALIZER)
+          != (void *) PTHREAD_RWLOCK_INITIALIZER)
         {
           /*
-           * This is all we need to do to destroy a statically
-           * initialised rwlock that has not yet been used (initialised).
-           * If we get to here, another thread
-           * waiting to initialise this rwlock will get an EINVAL.
-           */
-          *rwlock = NULL;
-        }
-      else
-        {
-          /*
-           * The rwlock has been initialised while we were waiting
+           * The rwlock has been initialised meanwhile
            * so assume it's in use.
            */
           result = EBUSY;
         }
 
-      pte_osMutexUnlock(pte_rwlock_test_init_lock);
-
     }
 
   return ((result != 0) ? result : ((result1 != 0) ? result1 : result2));
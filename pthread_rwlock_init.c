@@ -65,7 +65,7 @@ pthread_rwlock_init (pthread_rwlock_t * rwlock,
       goto DONE;
     }
 
-  rwl = (pthread_rwlock_t) calloc (1, sizeof (*rwl));
+  rwl = (pthread_rwlock_t) pte_alloc (PTE_ALLOC_RWLOCK, sizeof (*rwl));
 
   if (rwl == NULL)
     {
@@ -97,6 +97,13 @@ pthread_rwlock_init (pthread_rwlock_t * rwlock,
 
   rwl->nMagic = PTE_RWLOCK_MAGIC;
 
+#ifdef PTE_SYNC_REGISTRY
+  rwl->syncEntry = pte_sync_register (PTE_SYNC_RWLOCK, rwl);
+  pte_sync_adopt (rwl->mtxExclusiveAccess->syncEntry, rwl->syncEntry);
+  pte_sync_adopt (rwl->mtxSharedAccessCompleted->syncEntry, rwl->syncEntry);
+  pte_sync_adopt (rwl->cndSharedAccessCompleted->syncEntry, rwl->syncEntry);
+#endif
+
   result = 0;
   goto DONE;
 
@@ -107,7 +114,7 @@ FAIL1:
   (void) pthread_mutex_destroy (&(rwl->mtxExclusiveAccess));
 
 FAIL0:
-  (void) free (rwl);
+  pte_free (PTE_ALLOC_RWLOCK, rwl, sizeof (*rwl));
   rwl = NULL;
 
 DONE:
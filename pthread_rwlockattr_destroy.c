@@ -85,7 +85,7 @@ pthread_rwlockattr_destroy (pthread_rwlockattr_t * attr)
       pthread_rwlockattr_t rwa = *attr;
 
       *attr = NULL;
-      free (rwa);
+      pte_free (PTE_ALLOC_ATTR, rwa, sizeof (*rwa));
     }
 
   return (result);
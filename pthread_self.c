@@ -104,9 +104,12 @@ pthread_self (void)
           sp->threadId = pte_osThreadGetHandle();
           /*
            * No need to explicitly serialise access to sched_priority
-           * because the new handle is not yet public.
+           * because the new handle is not yet public. The OS thread's
+           * current priority is taken as its base priority so that
+           * mutex priority boosts can be undone.
            */
-          sp->sched_priority = 0;
+          sp->sched_priority = pte_osThreadGetPriority(sp->threadId);
+          sp->prioEffective = sp->sched_priority;
 
           pthread_setspecific (pte_selfThreadKey, (void *) sp);
         }
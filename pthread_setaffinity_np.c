@@ -0,0 +1,121 @@
+/*
+ * pthread_setaffinity_np.c
+ *
+ * Description:
+ * POSIX thread functions that deal with thread CPU affinity.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pthread_setaffinity_np (pthread_t thread, unsigned int cpumask)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function restricts a running thread to the
+ *      processors selected by 'cpumask'.
+ *
+ * PARAMETERS
+ *      thread
+ *              target thread
+ *
+ *      cpumask
+ *              CPU mask; bit n set allows processor n.
+ *
+ *
+ * DESCRIPTION
+ *      This function restricts a running thread to the
+ *      processors selected by 'cpumask'. On targets with a
+ *      single processor the only valid mask is 1.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully set affinity,
+ *              ESRCH           'thread' is not a valid thread,
+ *              EINVAL          'cpumask' selects no available
+ *                              processor,
+ *              ENOTSUP         the OS cannot pin threads.
+ *
+ * ------------------------------------------------------
+ */
+{
+  int result;
+  pte_osResult osResult;
+  pte_thread_t * tp = (pte_thread_t *) thread;
+
+  /* Validate the thread id. */
+  result = pthread_kill (thread, 0);
+  if (0 != result)
+    {
+      return result;
+    }
+
+  if (pte_is_cpumask (cpumask) != 0)
+    {
+      return EINVAL;
+    }
+
+  result = pthread_mutex_lock (&tp->threadLock);
+
+  if (0 == result)
+    {
+      /* If this fails, the current affinity is unchanged. */
+      osResult = pte_osThreadSetAffinity (tp->threadId, cpumask);
+
+      if (osResult == PTE_OS_OK)
+        {
+          tp->cpuAffinity = cpumask;
+        }
+      else if (osResult == PTE_OS_GENERAL_FAILURE)
+        {
+          result = ENOTSUP;
+        }
+      else
+        {
+          result = EINVAL;
+        }
+
+      (void) pthread_mutex_unlock (&tp->threadLock);
+    }
+
+  return result;
+}
@@ -106,6 +106,7 @@ pthread_setcancelstate (int state, int *oldstate)
     }
 
   sp->cancelState = state;
+  PTE_CANCEL_PUBLISH (sp);
 
   /*
    * Check if there is a pending asynchronous cancel
@@ -116,6 +117,7 @@ pthread_setcancelstate (int state, int *oldstate)
     {
       sp->state = PThreadStateCanceling;
       sp->cancelState = PTHREAD_CANCEL_DISABLE;
+      PTE_CANCEL_PUBLISH (sp);
       (void) pthread_mutex_unlock (&sp->cancelLock);
       pte_throw (PTE_EPS_CANCEL);
 
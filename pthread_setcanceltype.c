@@ -129,6 +129,7 @@ pthread_setcanceltype (int type, int *oldtype)
     {
       sp->state = PThreadStateCanceling;
       sp->cancelState = PTHREAD_CANCEL_DISABLE;
+      PTE_CANCEL_PUBLISH (sp);
       (void) pthread_mutex_unlock (&sp->cancelLock);
       pte_throw (PTE_EPS_CANCEL);
 
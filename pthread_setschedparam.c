@@ -63,12 +63,6 @@ pthread_setschedparam (pthread_t thread, int policy,
       return EINVAL;
     }
 
-  /* Ensure the policy is SCHED_OTHER. */
-  if (policy != SCHED_OTHER)
-    {
-      return ENOTSUP;
-    }
-
   return (pte_setthreadpriority (thread, policy, param->sched_priority));
 }
 
@@ -95,20 +89,55 @@ pte_setthreadpriority (pthread_t thread, int policy, int priority)
     {
       /* If this fails, the current priority is unchanged. */
 
-      if (0 != pte_osThreadSetPriority(tp->threadId, prio))
+      if (policy != tp->sched_policy)
         {
-          result = EINVAL;
+          pte_osResult osResult = pte_osThreadSetSchedPolicy(tp->threadId, policy);
+
+          if (osResult == PTE_OS_OK)
+            {
+              tp->sched_policy = policy;
+            }
+          else
+            {
+              result = (osResult == PTE_OS_GENERAL_FAILURE) ? ENOTSUP : EINVAL;
+            }
         }
-      else
+
+      if (0 == result)
         {
           /*
-           * Must record the thread's sched_priority as given,
-           * not as finally adjusted.
+           * prioEffective is shared with the mutex priority
+           * protocols, which update it under pte_mutex_prio_lock.
            */
-          tp->sched_priority = priority;
+          pte_osMutexLock (pte_mutex_prio_lock);
+
+          if (0 != pte_osThreadSetPriority(tp->threadId, prio))
+            {
+              result = EINVAL;
+            }
+          else
+            {
+              /*
+               * Must record the thread's sched_priority as given,
+               * not as finally adjusted.
+               */
+              tp->sched_priority = priority;
+              tp->prioEffective = priority;
+            }
+
+          pte_osMutexUnlock (pte_mutex_prio_lock);
         }
 
       (void) pthread_mutex_unlock (&tp->threadLock);
+
+      /*
+       * Reapply any boost owed by PTHREAD_PRIO_INHERIT or
+       * PTHREAD_PRIO_PROTECT mutexes the thread owns.
+       */
+      if (0 == result)
+        {
+          pte_thread_prio_update (tp);
+        }
     }
 
   return result;
@@ -0,0 +1,126 @@
+/*
+ * pthread_setstackpool_np.c
+ *
+ * Description:
+ * This translation unit implements the thread stack pool controls.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pthread_setstackpool_np (int maxstacks, size_t guardsize)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function enables, resizes or disables the pool
+ *      of thread stacks managed by the library.
+ *
+ * PARAMETERS
+ *      maxstacks
+ *              number of free stacks to keep for reuse;
+ *              zero disables the pool (the default).
+ *
+ *      guardsize
+ *              size of the inaccessible guard region placed
+ *              below each pooled stack, in bytes. Ignored
+ *              where the OS cannot protect memory, and
+ *              when disabling the pool.
+ *
+ *
+ * DESCRIPTION
+ *      While the pool is enabled, threads created without a
+ *      caller supplied stack (see pthread_attr_setstack) run
+ *      on stacks allocated by the library through
+ *      pte_osStackAlloc(). When a thread is joined, or a
+ *      detached thread exits, its stack is kept for the next
+ *      pthread_create() asking for the same size, rounded up
+ *      to a multiple of 4096 bytes. Up to 'maxstacks' free
+ *      stacks are kept.
+ *
+ *      Cached stacks are freed when the pool is disabled, when
+ *      'guardsize' changes, and by pthread_terminate(). The
+ *      guard size can only change while no thread is using a
+ *      pooled stack.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ *              2)      If the OS cannot run threads on caller
+ *                      supplied stacks then threads are created
+ *                      normally.
+ *
+ * RESULTS
+ *              0               successfully configured pool,
+ *              EINVAL          'maxstacks' is negative,
+ *              EBUSY           'guardsize' differs and pooled
+ *                              stacks are in use.
+ *
+ * ------------------------------------------------------
+ */
+{
+  if (maxstacks < 0)
+    {
+      return EINVAL;
+    }
+
+  if (maxstacks == 0)
+    {
+      pte_stack_pool_max = 0;
+      pte_stack_pool_flush ();
+      return 0;
+    }
+
+  if (guardsize != pte_stack_pool_guard)
+    {
+      /* Stacks in use must be freed with the guard they were allocated with */
+      if (pte_stack_pool_busy ())
+        {
+          return EBUSY;
+        }
+
+      pte_stack_pool_max = 0;
+      pte_stack_pool_flush ();
+      pte_stack_pool_guard = (unsigned int) guardsize;
+    }
+
+  pte_stack_pool_max = maxstacks;
+
+  return 0;
+}
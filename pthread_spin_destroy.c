@@ -63,6 +63,21 @@ pthread_spin_destroy (pthread_spinlock_t * lock)
         {
           result = pthread_mutex_destroy (&(s->u.mutex));
         }
+      else if (s->interlock == PTE_SPIN_USE_TICKET)
+        {
+          /*
+           * Fails if the lock is held, otherwise takes it so that
+           * nobody else can while it is freed.
+           */
+          int serving = s->ticketServing;
+
+          if (serving != PTE_ATOMIC_COMPARE_EXCHANGE (&(s->ticketNext),
+                                                      serving + 1,
+                                                      serving))
+            {
+              result = EINVAL;
+            }
+        }
       else if (PTE_SPIN_UNLOCKED !=
                PTE_ATOMIC_COMPARE_EXCHANGE (
                  & (s->interlock),
@@ -79,7 +94,10 @@ pthread_spin_destroy (pthread_spinlock_t * lock)
            * have finished with the spinlock before destroying it.
            */
           *lock = NULL;
-          (void) free (s);
+#ifdef PTE_SYNC_REGISTRY
+          pte_sync_unregister (s->syncEntry);
+#endif
+          pte_free (PTE_ALLOC_SPIN, s, sizeof (*s));
         }
     }
   else
@@ -88,32 +106,23 @@ pthread_spin_destroy (pthread_spinlock_t * lock)
        * See notes in pte_spinlock_check_need_init() above also.
        */
 
-      pte_osMutexLock (pte_spinlock_test_init_lock);
-
       /*
-       * Check again.
+       * This is all we need to do to destroy a statically
+       * initialised spinlock that has not yet been used (initialised).
+       * A thread initialising it meanwhile will fail to install its
+       * spinlock and get EINVAL.
        */
-      if (*lock == PTHREAD_SPINLOCK_INITIALIZER)
+      if (PTE_ATOMIC_COMPARE_EXCHANGE_PTR ((void * volatile *) lock, NULL,
+                                           (void *) PTHREAD_SPINLOCK_INITIALIZER)
+          != (void *) PTHREAD_SPINLOCK_INITIALIZER)
         {
           /*
-           * This is all we need to do to destroy a statically
-           * initialised spinlock that has not yet been used (initialised).
-           * If we get to here, another thread
-           * waiting to initialise this mutex will get an EINVAL.
-           */
-          *lock = NULL;
-        }
-      else
-        {
-          /*
-           * The spinlock has been initialised while we were waiting
+           * The spinlock has been initialised meanwhile
            * so assume it's in use.
            */
           result = EBUSY;
         }
 
-      pte_osMutexUnlock(pte_spinlock_test_init_lock);
-
     }
 
   return (result);
@@ -0,0 +1,183 @@
+/*
+ * pthread_spin_init_np.c
+ *
+ * Description:
+ * This translation unit implements initialising spinlocks of a given
+ * kind.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdlib.h>
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pthread_spin_init_np (pthread_spinlock_t * lock, int pshared, int kind)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function initialises a spinlock of the given
+ *      kind, as pthread_spin_init() does.
+ *
+ * PARAMETERS
+ *      lock
+ *              pointer to an instance of pthread_spinlock_t
+ *
+ *      pshared
+ *              PTHREAD_PROCESS_PRIVATE or PTHREAD_PROCESS_SHARED
+ *
+ *      kind
+ *              PTHREAD_SPIN_TTAS_NP or PTHREAD_SPIN_TICKET_NP
+ *
+ *
+ * DESCRIPTION
+ *      A PTHREAD_SPIN_TTAS_NP lock, the default, waits by
+ *      reading the lock word and backing off exponentially,
+ *      only attempting an atomic exchange when it looks free.
+ *      Waiters are served in no particular order.
+ *
+ *      A PTHREAD_SPIN_TICKET_NP lock serves waiters in the
+ *      order they arrived: each takes a ticket and waits for
+ *      it to be called. Under heavy contention this stops
+ *      any one thread being starved, at the cost of handing
+ *      the lock only to the next in line even if it is not
+ *      running.
+ *
+ *      On a single cpu either kind is a mutex.
+ *
+ *      NOTES:
+ *              1)      This function is a non-portable extension.
+ *
+ * RESULTS
+ *              0               successfully initialised,
+ *              EINVAL          'lock' is NULL or 'kind' is invalid,
+ *              ENOMEM          insufficient memory.
+ *
+ * ------------------------------------------------------
+ */
+{
+  pthread_spinlock_t s;
+  int cpus = 0;
+  int result = 0;
+
+  if (lock == NULL
+      || (kind != PTHREAD_SPIN_TTAS_NP && kind != PTHREAD_SPIN_TICKET_NP))
+    {
+      return EINVAL;
+    }
+
+  if (0 != pte_getprocessors (&cpus))
+    {
+      cpus = 1;
+    }
+
+  if (cpus > 1)
+    {
+      if (pshared == PTHREAD_PROCESS_SHARED)
+        {
+          /*
+           * Creating spinlock that can be shared between
+           * processes.
+           */
+#if _POSIX_THREAD_PROCESS_SHARED >= 0
+
+          /*
+           * Not implemented yet.
+           */
+
+#error ERROR [__FILE__, line __LINE__]: Process shared spin locks are not supported yet.
+
+#else
+
+          return ENOSYS;
+
+#endif /* _POSIX_THREAD_PROCESS_SHARED */
+
+        }
+    }
+
+  s = (pthread_spinlock_t) pte_alloc (PTE_ALLOC_SPIN, sizeof (*s));
+
+  if (s == NULL)
+    {
+      return ENOMEM;
+    }
+
+  if (cpus > 1)
+    {
+      s->u.cpus = cpus;
+      s->interlock = (kind == PTHREAD_SPIN_TICKET_NP
+                      ? PTE_SPIN_USE_TICKET : PTE_SPIN_UNLOCKED);
+    }
+  else
+    {
+      pthread_mutexattr_t ma;
+      result = pthread_mutexattr_init (&ma);
+
+      if (0 == result)
+        {
+          ma->pshared = pshared;
+          result = pthread_mutex_init (&(s->u.mutex), &ma);
+          if (0 == result)
+            {
+              s->interlock = PTE_SPIN_USE_MUTEX;
+            }
+        }
+      (void) pthread_mutexattr_destroy (&ma);
+    }
+
+  if (0 == result)
+    {
+#ifdef PTE_SYNC_REGISTRY
+      s->syncEntry = pte_sync_register (PTE_SYNC_SPIN, s);
+      if (s->interlock == PTE_SPIN_USE_MUTEX)
+        {
+          pte_sync_adopt (s->u.mutex->syncEntry, s->syncEntry);
+        }
+#endif
+      *lock = s;
+    }
+  else
+    {
+      pte_free (PTE_ALLOC_SPIN, s, sizeof (*s));
+      *lock = NULL;
+    }
+
+  return (result);
+}
@@ -48,6 +48,12 @@ int
 pthread_spin_lock (pthread_spinlock_t * lock)
 {
   register pthread_spinlock_t s;
+  int backoff = PTE_SPIN_BACKOFF_MIN;
+  int rounds = 0;
+  int i;
+#ifdef PTE_SYNC_REGISTRY
+  unsigned long long syncStart = 0;
+#endif
 
   if (NULL == lock || NULL == *lock)
     {
@@ -66,12 +72,88 @@ pthread_spin_lock (pthread_spinlock_t * lock)
 
   s = *lock;
 
+  if (s->interlock == PTE_SPIN_USE_TICKET)
+    {
+      int ticket = PTE_ATOMIC_EXCHANGE_ADD_RELAXED (&(s->ticketNext), 1);
+      int ahead;
+
+      /*
+       * Back off in proportion to the number of threads ahead of us.
+       * Taking a ticket needn't order anything: the acquire is on
+       * reading our number in ticketServing, which the previous
+       * holder published with a release.
+       */
+      while ((ahead = ticket - PTE_ATOMIC_LOAD_ACQUIRE (&(s->ticketServing))) != 0)
+        {
+#ifdef PTE_SYNC_REGISTRY
+          if (syncStart == 0)
+            {
+              syncStart = pte_osClockGetMicros ();
+            }
+#endif
+          for (i = ahead * PTE_SPIN_BACKOFF_MIN; i > 0; i--)
+            {
+              PTE_CPU_RELAX ();
+            }
+
+          if (++rounds > PTE_SPIN_YIELD_ROUNDS)
+            {
+              pte_osThreadSleep (0);
+            }
+        }
+
+#ifdef PTE_SYNC_REGISTRY
+      if (syncStart != 0)
+        {
+          pte_sync_waited (s->syncEntry, syncStart);
+        }
+#endif
+
+      return 0;
+    }
+
+  /*
+   * Test-and-test-and-set: after a failed attempt, wait by reading
+   * the lock word, backing off exponentially, so that waiters don't
+   * keep stealing the lock's cache line from the holder.
+   */
   while ( PTE_SPIN_LOCKED ==
-          PTE_ATOMIC_COMPARE_EXCHANGE (&(s->interlock),
-                                       PTE_SPIN_LOCKED,
-                                       PTE_SPIN_UNLOCKED))
+          PTE_ATOMIC_COMPARE_EXCHANGE_ACQUIRE (&(s->interlock),
+                                               PTE_SPIN_LOCKED,
+                                               PTE_SPIN_UNLOCKED))
+    {
+#ifdef PTE_SYNC_REGISTRY
+      if (syncStart == 0)
+        {
+          syncStart = pte_osClockGetMicros ();
+        }
+#endif
+      do
+        {
+          for (i = 0; i < backoff; i++)
+            {
+              PTE_CPU_RELAX ();
+            }
+
+          if (backoff < PTE_SPIN_BACKOFF_MAX)
+            {
+              backoff <<= 1;
+            }
+
+          if (++rounds > PTE_SPIN_YIELD_ROUNDS)
+            {
+              pte_osThreadSleep (0);
+            }
+        }
+      while (PTE_ATOMIC_LOAD_RELAXED (&(s->interlock)) == PTE_SPIN_LOCKED);
+    }
+
+#ifdef PTE_SYNC_REGISTRY
+  if (syncStart != 0)
     {
+      pte_sync_waited (s->syncEntry, syncStart);
     }
+#endif
 
   if (s->interlock == PTE_SPIN_LOCKED)
     {
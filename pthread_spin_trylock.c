@@ -68,9 +68,9 @@ pthread_spin_trylock (pthread_spinlock_t * lock)
   s = *lock;
 
   switch ((long)
-          PTE_ATOMIC_COMPARE_EXCHANGE (&(s->interlock),
-                                       PTE_SPIN_LOCKED,
-                                       PTE_SPIN_UNLOCKED))
+          PTE_ATOMIC_COMPARE_EXCHANGE_ACQUIRE (&(s->interlock),
+                                               PTE_SPIN_LOCKED,
+                                               PTE_SPIN_UNLOCKED))
     {
     case PTE_SPIN_UNLOCKED:
       return 0;
@@ -78,6 +78,18 @@ pthread_spin_trylock (pthread_spinlock_t * lock)
       return EBUSY;
     case PTE_SPIN_USE_MUTEX:
       return pthread_mutex_trylock (&(s->u.mutex));
+    case PTE_SPIN_USE_TICKET:
+      {
+        int serving = PTE_ATOMIC_LOAD_ACQUIRE (&(s->ticketServing));
+
+        /*
+         * Take the next ticket only if it would be served at once.
+         */
+        return (PTE_ATOMIC_COMPARE_EXCHANGE_ACQUIRE (&(s->ticketNext),
+                                                     serving + 1,
+                                                     serving) == serving
+                ? 0 : EBUSY);
+      }
     }
 
   return EINVAL;
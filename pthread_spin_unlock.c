@@ -62,9 +62,9 @@ pthread_spin_unlock (pthread_spinlock_t * lock)
     }
 
   switch ((long)
-          PTE_ATOMIC_COMPARE_EXCHANGE (&(s->interlock),
-                                       PTE_SPIN_UNLOCKED,
-                                       PTE_SPIN_LOCKED))
+          PTE_ATOMIC_COMPARE_EXCHANGE_RELEASE (&(s->interlock),
+                                               PTE_SPIN_UNLOCKED,
+                                               PTE_SPIN_LOCKED))
     {
     case PTE_SPIN_LOCKED:
       return 0;
@@ -72,6 +72,17 @@ pthread_spin_unlock (pthread_spinlock_t * lock)
       return EPERM;
     case PTE_SPIN_USE_MUTEX:
       return pthread_mutex_unlock (&(s->u.mutex));
+    case PTE_SPIN_USE_TICKET:
+      if (s->ticketServing == PTE_ATOMIC_LOAD_RELAXED (&(s->ticketNext)))
+        {
+          return EPERM;
+        }
+      /*
+       * Only the holder writes ticketServing, so a plain release
+       * store hands the lock on; no read-modify-write is needed.
+       */
+      PTE_ATOMIC_STORE_RELEASE (&(s->ticketServing), s->ticketServing + 1);
+      return 0;
     }
 
   return EINVAL;
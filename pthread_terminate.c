@@ -53,6 +53,18 @@ void pthread_terminate(void)
     {
       pte_thread_t * tp, * tpNext;
 
+      /*
+       * Stop the task scheduler's workers, if it was started
+       */
+      (void) pte_task_shutdown_np ();
+
+#ifdef PTE_SYNC_REGISTRY
+      /*
+       * Stop the sync statistics reporter, if it was started
+       */
+      (void) pte_sync_reporter_np (NULL, 0);
+#endif
+
       if (pte_selfThreadKey != NULL)
         {
           /*
@@ -73,6 +85,17 @@ void pthread_terminate(void)
           pte_cleanupKey = NULL;
         }
 
+      /*
+       * Free cached thread stacks
+       */
+      pte_stack_pool_flush ();
+
+      /*
+       * Stop tracing and free the recorder's event rings
+       */
+      (void) pte_set_trace_hooks_np (NULL);
+      pte_trace_free_rings ();
+
       pte_osMutexLock (pte_thread_reuse_lock);
 
 
@@ -80,12 +103,17 @@ void pthread_terminate(void)
       while (tp != PTE_THREAD_REUSE_EMPTY)
         {
           tpNext = tp->prevReuse;
-          free (tp);
+          pte_free (PTE_ALLOC_THREAD, tp, sizeof (*tp));
           tp = tpNext;
         }
 
       pte_osMutexUnlock(pte_thread_reuse_lock);
 
+      /*
+       * Free the sync object slab caches, if nothing still uses them
+       */
+      pte_slab_flush ();
+
       pte_processInitialized = PTE_FALSE;
     }
 
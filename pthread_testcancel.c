@@ -83,25 +83,29 @@ pthread_testcancel (void)
     }
 
   /*
-   * Pthread_cancel() will have set sp->state to PThreadStateCancelPending
-   * and set an event, so no need to enter kernel space if
-   * sp->state != PThreadStateCancelPending - that only slows us down.
+   * Pthread_cancel() will have published sp->cancelPending, so there
+   * is no need to take the lock or ask the OS unless it is set -
+   * that only slows us down.
    */
-  if (sp->state != PThreadStateCancelPending)
+  if (PTE_ATOMIC_LOAD_RELAXED (&sp->cancelPending) == 0)
     {
       return;
     }
 
   (void) pthread_mutex_lock (&sp->cancelLock);
 
-  if (sp->cancelState != PTHREAD_CANCEL_DISABLE)
+  if (sp->state == PThreadStateCancelPending
+      && sp->cancelState != PTHREAD_CANCEL_DISABLE)
     {
       sp->state = PThreadStateCanceling;
       sp->cancelState = PTHREAD_CANCEL_DISABLE;
+      PTE_CANCEL_PUBLISH (sp);
 
       (void) pthread_mutex_unlock (&sp->cancelLock);
       pte_throw (PTE_EPS_CANCEL);
     }
 
+  PTE_CANCEL_PUBLISH (sp);
+
   (void) pthread_mutex_unlock (&sp->cancelLock);
 }				/* pthread_testcancel */
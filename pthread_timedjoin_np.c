@@ -0,0 +1,100 @@
+/*
+ * pthread_timedjoin_np.c
+ *
+ * Description:
+ * This translation unit implements thread joins with a timeout.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pthread_timedjoin_np (pthread_t thread, void **value_ptr,
+                      const struct timespec *abstime)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function waits for 'thread' to terminate, but
+ *      no later than 'abstime'.
+ *
+ * PARAMETERS
+ *      thread
+ *              an instance of pthread_t
+ *
+ *      value_ptr
+ *              pointer to an instance of pointer to void
+ *
+ *      abstime
+ *              pointer to an instance of struct timespec giving
+ *              the absolute time at which to stop waiting
+ *
+ *
+ * DESCRIPTION
+ *      This function behaves as pthread_join(), except that
+ *      it returns ETIMEDOUT if 'thread' has not terminated by
+ *      'abstime'. The thread is then left joinable. Like
+ *      pthread_join() this function is a cancellation point.
+ *
+ * RESULTS
+ *              0               'thread' has completed
+ *              ETIMEDOUT       'abstime' passed before 'thread' terminated,
+ *              EINVAL          thread is not a joinable thread, or
+ *                              'abstime' is NULL,
+ *              ESRCH           no thread could be found with ID 'thread',
+ *              ENOENT          thread couldn't find it's own valid handle,
+ *              EDEADLK         attempt to join thread with self
+ *
+ * ------------------------------------------------------
+ */
+{
+  unsigned int timeout;
+
+  if (abstime == NULL)
+    {
+      return EINVAL;
+    }
+
+  timeout = pte_relmillisecs (abstime);
+
+  /*
+   * A deadline that has already passed still gets a final poll.
+   */
+  return pte_join (thread, value_ptr, &timeout);
+
+}				/* pthread_timedjoin_np */
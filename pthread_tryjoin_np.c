@@ -0,0 +1,88 @@
+/*
+ * pthread_tryjoin_np.c
+ *
+ * Description:
+ * This translation unit implements non-blocking thread joins.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <pthread.h>
+#include "implement.h"
+
+
+int
+pthread_tryjoin_np (pthread_t thread, void **value_ptr)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function joins 'thread' if it has already
+ *      terminated, and otherwise returns EBUSY at once.
+ *
+ * PARAMETERS
+ *      thread
+ *              an instance of pthread_t
+ *
+ *      value_ptr
+ *              pointer to an instance of pointer to void
+ *
+ *
+ * DESCRIPTION
+ *      If 'thread' has terminated this function behaves as
+ *      pthread_join(): it returns the thread's exit value if
+ *      'value_ptr' is not NULL and detaches the thread.
+ *      Otherwise it returns EBUSY without waiting. This
+ *      function is not a cancellation point.
+ *
+ * RESULTS
+ *              0               'thread' has completed
+ *              EBUSY           'thread' has not yet terminated,
+ *              EINVAL          thread is not a joinable thread,
+ *              ESRCH           no thread could be found with ID 'thread',
+ *              ENOENT          thread couldn't find it's own valid handle,
+ *              EDEADLK         attempt to join thread with self
+ *
+ * ------------------------------------------------------
+ */
+{
+  unsigned int timeout = 0;
+  int result;
+
+  result = pte_join (thread, value_ptr, &timeout);
+
+  return (result == ETIMEDOUT) ? EBUSY : result;
+
+}				/* pthread_tryjoin_np */
@@ -96,7 +96,11 @@ sem_destroy (sem_t * sem)
 
       if ((result = pthread_mutex_lock (&s->lock)) == 0)
         {
-          if (s->value < 0)
+          /*
+           * sem_wait_any_np() callers leave the value alone, so also
+           * check for any of them still on the semaphore.
+           */
+          if (s->value < 0 || s->anyWaiters != NULL)
             {
               (void) pthread_mutex_unlock (&s->lock);
               result = EBUSY;
@@ -149,7 +153,11 @@ sem_destroy (sem_t * sem)
       return -1;
     }
 
-  free (s);
+#ifdef PTE_SYNC_REGISTRY
+  pte_sync_unregister (s->syncEntry);
+#endif
+
+  pte_free (PTE_ALLOC_SEM, s, sizeof (*s));
 
   return 0;
 
@@ -104,7 +104,7 @@ sem_init (sem_t * sem, int pshared, unsigned int value)
     }
   else
     {
-      s = (sem_t) calloc (1, sizeof (*s));
+      s = (sem_t) pte_alloc (PTE_ALLOC_SEM, sizeof (*s));
 
       if (NULL == s)
         {
@@ -135,7 +135,7 @@ sem_init (sem_t * sem, int pshared, unsigned int value)
 
           if (result != 0)
             {
-              free(s);
+              pte_free (PTE_ALLOC_SEM, s, sizeof (*s));
             }
         }
     }
@@ -146,6 +146,11 @@ sem_init (sem_t * sem, int pshared, unsigned int value)
       return -1;
     }
 
+#ifdef PTE_SYNC_REGISTRY
+  s->syncEntry = pte_sync_register (PTE_SYNC_SEM, s);
+  pte_sync_adopt (s->lock->syncEntry, s->syncEntry);
+#endif
+
   *sem = s;
 
   return 0;
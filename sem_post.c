@@ -102,14 +102,25 @@ sem_post (sem_t * sem)
 
       if (s->value < SEM_VALUE_MAX)
         {
-          pte_osResult osResult = pte_osSemaphorePost(s->sem, 1);
-
+          /*
+           * Only wake the OS semaphore if a thread is waiting on it;
+           * otherwise the token would let a later sem_wait() through
+           * without a matching post.
+           */
           if (++s->value <= 0
-              && (osResult != PTE_OS_OK))
+              && pte_osSemaphorePost(s->sem, 1) != PTE_OS_OK)
             {
               s->value--;
               result = EINVAL;
             }
+          else if (s->value > 0 && s->anyWaiters != NULL)
+            {
+              /*
+               * No sem_wait() caller takes this unit, so let the
+               * sem_wait_any_np() callers race for it.
+               */
+              pte_sem_wake_any (s);
+            }
 
         }
       else
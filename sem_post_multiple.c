@@ -114,6 +114,11 @@ sem_post_multiple (sem_t * sem, int count)
               pte_osSemaphorePost(s->sem, (waiters<=count)?waiters:count);
               result = 0;
             }
+
+          if (s->value > 0 && s->anyWaiters != NULL)
+            {
+              pte_sem_wake_any (s);
+            }
           /*
                     else
           		        {
@@ -187,6 +187,9 @@ sem_timedwait (sem_t * sem, const struct timespec *abstime)
 
               {
                 sem_timedwait_cleanup_args_t cleanup_args;
+#ifdef PTE_SYNC_REGISTRY
+                unsigned long long syncStart = pte_osClockGetMicros ();
+#endif
 
                 cleanup_args.sem = s;
                 cleanup_args.resultPtr = &result;
@@ -194,9 +197,13 @@ sem_timedwait (sem_t * sem, const struct timespec *abstime)
                 /* Must wait */
                 pthread_cleanup_push(pte_sem_timedwait_cleanup, (void *) &cleanup_args);
 
-                result = pte_cancellable_wait(s->sem,pTimeout);
+                result = pte_cancellable_wait(s->sem,pTimeout,s);
 
                 pthread_cleanup_pop(result);
+
+#ifdef PTE_SYNC_REGISTRY
+                pte_sync_waited (s->syncEntry, syncStart);
+#endif
               }
             }
         }
@@ -146,12 +146,20 @@ sem_wait (sem_t * sem)
 
           if (v < 0)
             {
+#ifdef PTE_SYNC_REGISTRY
+              unsigned long long syncStart = pte_osClockGetMicros ();
+#endif
+
               /* Must wait */
               pthread_cleanup_push(pte_sem_wait_cleanup, (void *) s);
-              result = pte_cancellable_wait(s->sem,NULL);
+              result = pte_cancellable_wait(s->sem,NULL,s);
               /* Cleanup if we're canceled or on any other error */
               pthread_cleanup_pop(result);
 
+#ifdef PTE_SYNC_REGISTRY
+              pte_sync_waited (s->syncEntry, syncStart);
+#endif
+
               // Wait was cancelled, indicate that we're no longer waiting on this semaphore.
               /*
                       if (result == PTE_OS_INTERRUPTED)
@@ -196,6 +204,10 @@ sem_wait_nocancel (sem_t * sem)
  *      successfully decrease the value or until interrupted by
  *      a signal.
  *
+ *      It is not a cancellation point and never looks at the
+ *      cancellation state, so the library uses it for its own
+ *      bookkeeping waits, which must not unwind.
+ *
  * RESULTS
  *              0               successfully decreased semaphore,
  *              -1              failed, error in errno
@@ -211,8 +223,6 @@ sem_wait_nocancel (sem_t * sem)
   int result = 0;
   sem_t s = *sem;
 
-  pthread_testcancel();
-
   if (s == NULL)
     {
       result = EINVAL;
@@ -237,7 +247,17 @@ sem_wait_nocancel (sem_t * sem)
 
           if (v < 0)
             {
+#ifdef PTE_SYNC_REGISTRY
+              unsigned long long syncStart = pte_osClockGetMicros ();
+#endif
+
+              PTE_TRACE (PTE_TRACE_BLOCK, s);
               pte_osSemaphorePend(s->sem, NULL);
+              PTE_TRACE (PTE_TRACE_WAKE, s);
+
+#ifdef PTE_SYNC_REGISTRY
+              pte_sync_waited (s->syncEntry, syncStart);
+#endif
             }
         }
 
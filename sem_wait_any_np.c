@@ -0,0 +1,332 @@
+/*
+ * sem_wait_any_np.c
+ *
+ * Description:
+ * This translation unit implements waiting on any of several
+ * semaphores.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <pthread.h>
+#include <semaphore.h>
+#include "implement.h"
+
+typedef struct
+  {
+    int n;
+    int registered;
+    pte_sem_any_node_t * nodes;
+    pte_osSemaphoreHandle wake;
+    int signalled;
+  } sem_wait_any_cleanup_args_t;
+
+/*
+ * Decrements 's' if its value is positive. Returns 1 if it did.
+ */
+static int
+pte_sem_take_one (sem_t s)
+{
+  int taken = 0;
+
+  if (pthread_mutex_lock (&s->lock) == 0)
+    {
+      if (s->value > 0)
+        {
+          s->value--;
+          taken = 1;
+        }
+      (void) pthread_mutex_unlock (&s->lock);
+    }
+
+  return taken;
+}
+
+static void
+pte_sem_wait_any_cleanup (void * args)
+{
+  sem_wait_any_cleanup_args_t * a = (sem_wait_any_cleanup_args_t *)args;
+  int i;
+
+  /*
+   * Whether we took a unit, timed out or were cancelled, leave every
+   * semaphore's list. Wakeups never carry a unit with them, so there
+   * is nothing to give back.
+   */
+  for (i = 0; i < a->registered; i++)
+    {
+      sem_t s = a->nodes[i].sem;
+      pte_sem_any_node_t ** link;
+
+      if (pthread_mutex_lock (&s->lock) == 0)
+        {
+          for (link = &s->anyWaiters; *link != NULL; link = &(*link)->next)
+            {
+              if (*link == &a->nodes[i])
+                {
+                  *link = a->nodes[i].next;
+                  break;
+                }
+            }
+          (void) pthread_mutex_unlock (&s->lock);
+        }
+    }
+
+  (void) pte_osSemaphoreDelete (a->wake);
+  pte_free (PTE_ALLOC_MISC, a->nodes, a->n * sizeof (*a->nodes));
+}
+
+
+void
+pte_sem_wake_any (sem_t s)
+/*
+ * Wakes every sem_wait_any_np() caller waiting on 's'. Called with
+ * s->lock held after a post leaves the value positive. A caller that
+ * has been woken and not yet run is not posted again, so repeated
+ * posts, or posts to several of its semaphores, leave at most one
+ * wakeup pending on its semaphore.
+ */
+{
+  pte_sem_any_node_t * node;
+
+  for (node = s->anyWaiters; node != NULL; node = node->next)
+    {
+      if (PTE_ATOMIC_COMPARE_EXCHANGE (node->signalled, 1, 0) == 0)
+        {
+          (void) pte_osSemaphorePost (node->wake, 1);
+        }
+    }
+}
+
+
+int
+sem_wait_any_np (sem_t ** sems, int n, int *which,
+                 const struct timespec *abstime)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function waits until any one of several
+ *      semaphores can be decreased, possibly until 'abstime'.
+ *
+ * PARAMETERS
+ *      sems
+ *              array of 'n' pointers to instances of sem_t
+ *
+ *      n
+ *              number of semaphores in the array
+ *
+ *      which
+ *              pointer to an int that receives the array index
+ *              of the semaphore decreased, or NULL
+ *
+ *      abstime
+ *              pointer to an instance of struct timespec, or NULL
+ *
+ * DESCRIPTION
+ *      This function decreases by one the value of exactly
+ *      one of the semaphores, the first in 'sems' whose value
+ *      is greater than zero. If none is, the calling thread
+ *      is blocked until one is, or until 'abstime' if it is
+ *      not NULL.
+ *
+ *      A unit posted while a sem_wait() caller is waiting on
+ *      the same semaphore goes to that caller first.
+ *
+ *      This function is a cancellation point.
+ *
+ * RESULTS
+ *              0               successfully decreased a semaphore,
+ *              -1              failed, error in errno
+ * ERRNO
+ *              EINVAL          'sems' or one of the semaphores is not
+ *                              valid, or 'n' is not positive,
+ *              ENOMEM          out of memory,
+ *              ENOSPC          a required resource has been exhausted,
+ *              ETIMEDOUT       abstime elapsed before success.
+ *
+ * ------------------------------------------------------
+ */
+{
+  sem_wait_any_cleanup_args_t cleanup_args;
+  int result = 0;
+  int i;
+  int k;
+
+
+  pthread_testcancel();
+
+  if (sems == NULL || n <= 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      if (sems[i] == NULL || *sems[i] == NULL)
+        {
+          errno = EINVAL;
+          return -1;
+        }
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      if (pte_sem_take_one (*sems[i]))
+        {
+          break;
+        }
+    }
+
+  if (i == n)
+    {
+      i = -1;
+      cleanup_args.n = n;
+      cleanup_args.registered = 0;
+      cleanup_args.signalled = 0;
+      cleanup_args.nodes = (pte_sem_any_node_t *)
+        pte_alloc (PTE_ALLOC_MISC, n * sizeof (*cleanup_args.nodes));
+
+      if (cleanup_args.nodes == NULL)
+        {
+          errno = ENOMEM;
+          return -1;
+        }
+
+      if (pte_osSemaphoreCreate (0, &cleanup_args.wake) != PTE_OS_OK)
+        {
+          pte_free (PTE_ALLOC_MISC, cleanup_args.nodes,
+                    n * sizeof (*cleanup_args.nodes));
+          errno = ENOSPC;
+          return -1;
+        }
+
+      /*
+       * Join each semaphore's list, unless a unit turns up on the way,
+       * in which case take it instead.
+       */
+      while (i < 0 && cleanup_args.registered < n)
+        {
+          sem_t s;
+
+          k = cleanup_args.registered;
+          s = *sems[k];
+
+          /*
+           * From here on the semaphore is only reached through the
+           * node: sem_destroy() fails while the node is on its list.
+           */
+          cleanup_args.nodes[k].sem = s;
+
+          if (s != NULL && pthread_mutex_lock (&s->lock) == 0)
+            {
+              if (s->value > 0)
+                {
+                  s->value--;
+                  i = k;
+                }
+              else
+                {
+                  cleanup_args.nodes[k].wake = cleanup_args.wake;
+                  cleanup_args.nodes[k].signalled = &cleanup_args.signalled;
+                  cleanup_args.nodes[k].next = s->anyWaiters;
+                  s->anyWaiters = &cleanup_args.nodes[k];
+                  cleanup_args.registered++;
+                }
+              (void) pthread_mutex_unlock (&s->lock);
+            }
+          else
+            {
+              result = EINVAL;
+              break;
+            }
+        }
+
+      pthread_cleanup_push(pte_sem_wait_any_cleanup, (void *) &cleanup_args);
+
+      while (i < 0 && result == 0)
+        {
+          unsigned int milliseconds;
+          unsigned int *pTimeout = NULL;
+
+          if (abstime != NULL)
+            {
+              milliseconds = pte_relmillisecs (abstime);
+              pTimeout = &milliseconds;
+            }
+
+          result = pte_cancellable_wait (cleanup_args.wake, pTimeout,
+                                         cleanup_args.nodes[0].sem);
+
+          /*
+           * Let the next post wake us again before looking, so that
+           * none is missed. Another waiter may have taken the unit we
+           * were woken for, and one may have been posted just as we
+           * timed out.
+           */
+          (void) PTE_ATOMIC_EXCHANGE (&cleanup_args.signalled, 0);
+
+          for (k = 0; k < cleanup_args.registered; k++)
+            {
+              if (pte_sem_take_one (cleanup_args.nodes[k].sem))
+                {
+                  i = k;
+                  result = 0;
+                  break;
+                }
+            }
+        }
+
+      pthread_cleanup_pop(1);
+    }
+
+  if (result != 0)
+    {
+      errno = result;
+      return -1;
+    }
+
+  if (which != NULL)
+    {
+      *which = i;
+    }
+
+  return 0;
+
+}				/* sem_wait_any_np */
@@ -0,0 +1,132 @@
+/*
+ * File: affinity1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test CPU affinity attributes and pthread_setaffinity_np().
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+static void * func(void * arg)
+{
+  unsigned int mask = 0;
+
+  assert(pthread_getaffinity_np(pthread_self(), &mask) == 0);
+
+  return (void *) mask;
+}
+
+int pthread_test_affinity1()
+{
+  pthread_t t;
+  pthread_attr_t attr;
+  unsigned int mask;
+  void * result = NULL;
+  int cpus;
+
+  assert((cpus = pthread_num_processors_np()) > 0);
+
+  assert(pthread_attr_init(&attr) == 0);
+
+  /* No affinity is requested by default */
+  assert(pthread_attr_getaffinity_np(&attr, &mask) == 0);
+  assert(mask == 0);
+
+  /* Processors beyond those available are rejected */
+  if (cpus < 32)
+    {
+      assert(pthread_attr_setaffinity_np(&attr, 1u << cpus) == EINVAL);
+    }
+
+  assert(pthread_attr_setaffinity_np(&attr, 1) == 0);
+  assert(pthread_attr_getaffinity_np(&attr, &mask) == 0);
+  assert(mask == 1);
+
+  /* The attribute is applied before the thread runs */
+  assert(pthread_create(&t, &attr, func, NULL) == 0);
+  assert(pthread_join(t, &result) == 0);
+  assert((unsigned int) result == 1);
+
+  assert(pthread_attr_setaffinity_np(&attr, 0) == 0);
+  assert(pthread_attr_destroy(&attr) == 0);
+
+  /* Runtime pinning of the current thread */
+  assert(pthread_setaffinity_np(pthread_self(), 0) == EINVAL);
+  assert(pthread_setaffinity_np(pthread_self(), 1) == 0);
+  assert(pthread_getaffinity_np(pthread_self(), &mask) == 0);
+  assert(mask == 1);
+
+  return 0;
+}
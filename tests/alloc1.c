@@ -0,0 +1,281 @@
+/*
+ * File: alloc1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test the allocator hooks and allocation counters.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#include <string.h>
+
+#include "../implement.h"
+
+#define MAX_BLOCKS 64
+
+typedef struct
+{
+  void * ptr;
+  size_t size;
+  int type;
+} block;
+
+static block blocks[MAX_BLOCKS];
+static int allocs[PTE_ALLOC_TYPES];
+static int frees[PTE_ALLOC_TYPES];
+static int badFree;
+static pte_osMutexHandle blockLock;
+
+/*
+ * Hands out uncleared memory from malloc(), remembering each block so
+ * that free can check its size and type, and that it was allocated
+ * here.
+ */
+static void * testAlloc(size_t size, int type, void * arg)
+{
+  void * ptr = malloc(size);
+  int i;
+
+  assert(arg == (void *) blocks);
+  if (ptr == NULL)
+    {
+      return NULL;
+    }
+  memset(ptr, 0xAA, size);
+
+  pte_osMutexLock(blockLock);
+  for (i = 0; i < MAX_BLOCKS; i++)
+    {
+      if (blocks[i].ptr == NULL)
+        {
+          blocks[i].ptr = ptr;
+          blocks[i].size = size;
+          blocks[i].type = type;
+          break;
+        }
+    }
+  assert(i < MAX_BLOCKS);
+  allocs[type]++;
+  pte_osMutexUnlock(blockLock);
+
+  return ptr;
+}
+
+static void testFree(void * ptr, size_t size, int type, void * arg)
+{
+  int i;
+
+  pte_osMutexLock(blockLock);
+  for (i = 0; i < MAX_BLOCKS; i++)
+    {
+      if (blocks[i].ptr == ptr)
+        {
+          if (blocks[i].size != size || blocks[i].type != type)
+            {
+              badFree = 1;
+            }
+          blocks[i].ptr = NULL;
+          frees[type]++;
+          break;
+        }
+    }
+  if (i == MAX_BLOCKS)
+    {
+      badFree = 1;
+    }
+  pte_osMutexUnlock(blockLock);
+
+  free(ptr);
+}
+
+static pte_allocator_t allocator = {testAlloc, testFree, blocks};
+static pte_allocator_t noFree = {testAlloc, NULL, NULL};
+
+static void * func(void * arg)
+{
+  return arg;
+}
+
+int pthread_test_alloc1()
+{
+  pte_alloc_stats_t before, after;
+  pthread_mutex_t mx;
+  pthread_cond_t cv;
+  sem_t sem;
+  pthread_attr_t heapAttr, testAttr;
+  pthread_t t;
+  void * result;
+  int i;
+
+  assert(pte_get_alloc_stats_np(-1, &before) == EINVAL);
+  assert(pte_get_alloc_stats_np(PTE_ALLOC_TYPES, &before) == EINVAL);
+  assert(pte_get_alloc_stats_np(PTE_ALLOC_MUTEX, NULL) == EINVAL);
+
+  /*
+   * Counters with the default allocator
+   */
+  assert(pte_get_alloc_stats_np(PTE_ALLOC_MUTEX, &before) == 0);
+  assert(pthread_mutex_init(&mx, NULL) == 0);
+  assert(pte_get_alloc_stats_np(PTE_ALLOC_MUTEX, &after) == 0);
+  assert(after.objects == before.objects + 1);
+  assert(after.bytes == before.bytes + sizeof(*mx));
+  assert(after.allocs == before.allocs + 1);
+  assert(pthread_mutex_destroy(&mx) == 0);
+  assert(pte_get_alloc_stats_np(PTE_ALLOC_MUTEX, &after) == 0);
+  assert(after.objects == before.objects);
+  assert(after.bytes == before.bytes);
+
+  /*
+   * Thread parameters are freed once the thread has started
+   */
+  assert(pte_get_alloc_stats_np(PTE_ALLOC_THREADPARMS, &before) == 0);
+  assert(pthread_create(&t, NULL, func, NULL) == 0);
+  assert(pthread_join(t, NULL) == 0);
+  assert(pte_get_alloc_stats_np(PTE_ALLOC_THREADPARMS, &after) == 0);
+  assert(after.objects == before.objects);
+  assert(after.allocs == before.allocs + 1);
+
+  /*
+   * A custom allocator
+   */
+  assert(pte_set_allocator_np(&noFree) == EINVAL);
+
+  memset(blocks, 0, sizeof(blocks));
+  memset(allocs, 0, sizeof(allocs));
+  memset(frees, 0, sizeof(frees));
+  badFree = 0;
+  assert(pte_osMutexCreate(&blockLock) == PTE_OS_OK);
+
+  assert(pthread_attr_init(&heapAttr) == 0);
+  assert(pte_set_allocator_np(&allocator) == 0);
+  assert(pthread_attr_init(&testAttr) == 0);
+
+  assert(pthread_mutex_init(&mx, NULL) == 0);
+  assert(pthread_cond_init(&cv, NULL) == 0);
+  assert(sem_init(&sem, 0, 1) == 0);
+  assert(pthread_create(&t, NULL, func, (void *) &sem) == 0);
+  assert(pthread_join(t, &result) == 0);
+  assert(result == (void *) &sem);
+
+  /*
+   * Sync objects come from slab chunks, not one by one
+   */
+  assert(allocs[PTE_ALLOC_MUTEX] == 0);
+  assert(allocs[PTE_ALLOC_COND] == 0);
+  assert(allocs[PTE_ALLOC_SEM] == 0);
+  assert(allocs[PTE_ALLOC_THREAD] == 1);
+  assert(allocs[PTE_ALLOC_THREADPARMS] == 1);
+  assert(frees[PTE_ALLOC_THREAD] == 1);
+  assert(frees[PTE_ALLOC_THREADPARMS] == 1);
+
+  /*
+   * Uncleared memory works, since the library clears it
+   */
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  assert(sem_wait(&sem) == 0);
+  assert(sem_post(&sem) == 0);
+
+  assert(sem_destroy(&sem) == 0);
+  assert(pthread_cond_destroy(&cv) == 0);
+  assert(pthread_mutex_destroy(&mx) == 0);
+
+  /*
+   * Memory goes back to the allocator that supplied it, whichever
+   * is installed when it is freed
+   */
+  assert(pthread_attr_destroy(&heapAttr) == 0);
+  assert(frees[PTE_ALLOC_ATTR] == 0);
+
+  assert(pte_set_allocator_np(NULL) == 0);
+
+  assert(allocs[PTE_ALLOC_ATTR] == 1);
+  assert(pthread_attr_destroy(&testAttr) == 0);
+  assert(frees[PTE_ALLOC_ATTR] == 1);
+
+  for (i = 0; i < PTE_ALLOC_TYPES; i++)
+    {
+      if (i != PTE_ALLOC_KEYASSOC && i != PTE_ALLOC_TLS
+          && i != PTE_ALLOC_SLAB && i != PTE_ALLOC_MISC)
+        {
+          assert(frees[i] == allocs[i]);
+        }
+    }
+  assert(badFree == 0);
+
+  pte_osMutexDelete(blockLock);
+
+  return 0;
+}
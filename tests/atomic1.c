@@ -0,0 +1,223 @@
+/*
+ * File: atomic1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test the 64-bit and pointer-pair atomics: exchange-add carries
+ * - across 32 bits under contention, and a tagged lock-free stack
+ * - keeps every node when threads pop and push concurrently.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#include "../implement.h"
+
+#define NTHREADS 4
+#define NLOOPS 10000
+#define NNODES 8
+
+typedef struct node_t_ node_t;
+
+struct node_t_
+{
+  node_t * next;
+};
+
+static long long volatile counter;
+static pte_osAtomicPair volatile top;
+static node_t nodes[NNODES];
+
+static void push(node_t * n)
+{
+  pte_osAtomicPair old, new, seen;
+
+  old = top;
+  for (;;)
+    {
+      n->next = (node_t *) old.ptr;
+      new.ptr = n;
+      new.tag = old.tag + 1;
+      seen = PTE_ATOMIC_COMPARE_EXCHANGE_PAIR(&top, new, old);
+      if (seen.ptr == old.ptr && seen.tag == old.tag)
+        {
+          return;
+        }
+      old = seen;
+    }
+}
+
+static node_t * pop(void)
+{
+  pte_osAtomicPair old, new, seen;
+
+  old = top;
+  for (;;)
+    {
+      if (old.ptr == NULL)
+        {
+          return NULL;
+        }
+      /*
+       * The node may be popped and pushed back between reading
+       * its link and the CAS; the tag makes the CAS fail then.
+       */
+      new.ptr = ((node_t *) old.ptr)->next;
+      new.tag = old.tag + 1;
+      seen = PTE_ATOMIC_COMPARE_EXCHANGE_PAIR(&top, new, old);
+      if (seen.ptr == old.ptr && seen.tag == old.tag)
+        {
+          return (node_t *) old.ptr;
+        }
+      old = seen;
+    }
+}
+
+static void * addFunc(void * arg)
+{
+  int i;
+
+  for (i = 0; i < NLOOPS; i++)
+    {
+      (void) PTE_ATOMIC_EXCHANGE_ADD64(&counter, 0x100000001LL);
+    }
+
+  return NULL;
+}
+
+static void * stackFunc(void * arg)
+{
+  int i;
+  node_t * n;
+
+  for (i = 0; i < NLOOPS; i++)
+    {
+      if ((n = pop()) != NULL)
+        {
+          push(n);
+        }
+    }
+
+  return NULL;
+}
+
+int pthread_test_atomic1()
+{
+  pthread_t t[NTHREADS];
+  node_t * n;
+  int i;
+
+  counter = 0xfffffff0LL;
+  assert(PTE_ATOMIC_EXCHANGE_ADD64(&counter, 0x20) == 0xfffffff0LL);
+  assert(PTE_ATOMIC_LOAD64(&counter) == 0x100000010LL);
+
+  counter = 0;
+  for (i = 0; i < NTHREADS; i++)
+    {
+      assert(pthread_create(&t[i], NULL, addFunc, NULL) == 0);
+    }
+  for (i = 0; i < NTHREADS; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+  assert(PTE_ATOMIC_LOAD64(&counter) ==
+         (long long) NTHREADS * NLOOPS * 0x100000001LL);
+
+  top.ptr = NULL;
+  top.tag = 0;
+  for (i = 0; i < NNODES; i++)
+    {
+      push(&nodes[i]);
+    }
+
+  for (i = 0; i < NTHREADS; i++)
+    {
+      assert(pthread_create(&t[i], NULL, stackFunc, NULL) == 0);
+    }
+  for (i = 0; i < NTHREADS; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+
+  /*
+   * Every node is still on the stack exactly once.
+   */
+  for (i = 0; i < NNODES; i++)
+    {
+      assert((n = pop()) != NULL);
+      assert(n >= &nodes[0] && n < &nodes[NNODES]);
+    }
+  assert(pop() == NULL);
+
+  return 0;
+}
@@ -40,9 +40,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <pthread.h>
-#include <sys/sched.h>
-#include <semaphore.h>
+#include "test.h"
 #include "benchtest.h"
 #include "implement.h"
 
@@ -73,3 +71,187 @@ interlocked_dec_with_conditionals(int * a)
 
 
 /****************************************************************************************/
+
+/*
+ * The OS clock, in microseconds: no port has a finer one. The harness
+ * times batches of operations long enough for the per-operation time
+ * to resolve to nanoseconds.
+ */
+unsigned long long
+benchNowMicros(void)
+{
+  return pte_osClockGetMicros();
+}
+
+/*
+ * Thread counts run from 1 to one per processor, but at least 2 so
+ * that there is always a contended run.
+ */
+int
+benchMaxThreads(void)
+{
+  int n = pthread_num_processors_np();
+
+  if (n < 2)
+    {
+      n = 2;
+    }
+  if (n > BENCH_MAX_THREADS)
+    {
+      n = BENCH_MAX_THREADS;
+    }
+  return n;
+}
+
+typedef struct
+{
+  const benchScenario * scenario;
+  int thread;
+  int nthreads;
+  unsigned long long * ns;
+} benchWorkerArg;
+
+static const char * benchSuite;
+static int benchRows;
+static pthread_barrier_t benchBarrier;
+
+static void *
+benchWorker(void * arg)
+{
+  benchWorkerArg * a = (benchWorkerArg *) arg;
+  int batch = a->scenario->batch;
+  unsigned long long start;
+  int i;
+
+  for (i = 0; i < BENCH_WARMUP + BENCH_SAMPLES; i++)
+    {
+      pthread_barrier_wait(&benchBarrier);
+
+      start = benchNowMicros();
+      a->scenario->run(a->thread, a->nthreads, batch);
+
+      if (i >= BENCH_WARMUP)
+        {
+          a->ns[i - BENCH_WARMUP] = (benchNowMicros() - start) * 1000 / batch;
+        }
+    }
+
+  return NULL;
+}
+
+static int
+benchCompare(const void * a, const void * b)
+{
+  unsigned long long x = *(const unsigned long long *) a;
+  unsigned long long y = *(const unsigned long long *) b;
+
+  return (x > y) - (x < y);
+}
+
+void
+benchBegin(const char * suite)
+{
+  benchSuite = suite;
+  benchRows = 0;
+
+#ifdef BENCH_JSON
+  printf("{\"suite\":\"%s\",\"results\":[", suite);
+#else
+  printf("suite,scenario,threads,batch,samples,mean_ns,p50_ns,p99_ns,p999_ns,max_ns\n");
+#endif
+}
+
+void
+benchRun(const benchScenario * scenario, int nthreads)
+{
+  pthread_t t[BENCH_MAX_THREADS];
+  benchWorkerArg arg[BENCH_MAX_THREADS];
+  int n = nthreads * BENCH_SAMPLES;
+  unsigned long long * ns;
+  int i;
+
+  assert(nthreads > 0 && nthreads <= BENCH_MAX_THREADS);
+
+  ns = (unsigned long long *) malloc(n * sizeof(unsigned long long));
+  assert(ns != NULL);
+
+  if (scenario->setup != NULL)
+    {
+      scenario->setup(nthreads);
+    }
+
+  assert(pthread_barrier_init(&benchBarrier, NULL, nthreads) == 0);
+
+  for (i = 0; i < nthreads; i++)
+    {
+      arg[i].scenario = scenario;
+      arg[i].thread = i;
+      arg[i].nthreads = nthreads;
+      arg[i].ns = ns + i * BENCH_SAMPLES;
+      assert(pthread_create(&t[i], NULL, benchWorker, &arg[i]) == 0);
+    }
+
+  for (i = 0; i < nthreads; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+
+  assert(pthread_barrier_destroy(&benchBarrier) == 0);
+
+  if (scenario->teardown != NULL)
+    {
+      scenario->teardown();
+    }
+
+  benchReport(scenario->name, nthreads, scenario->batch, ns, n);
+
+  free(ns);
+}
+
+/*
+ * Prints one result row for 'n' samples of the time per operation,
+ * sorting the samples in place.
+ */
+void
+benchReport(const char * name, int nthreads, int batch,
+            unsigned long long * ns, int n)
+{
+  unsigned long long total = 0;
+  int i;
+
+  assert(n > 0);
+
+  qsort(ns, n, sizeof(unsigned long long), benchCompare);
+
+  for (i = 0; i < n; i++)
+    {
+      total += ns[i];
+    }
+
+#ifdef BENCH_JSON
+  printf("%s\n{\"scenario\":\"%s\",\"threads\":%d,\"batch\":%d,"
+         "\"samples\":%d,\"mean_ns\":%llu,\"p50_ns\":%llu,\"p99_ns\":%llu,"
+         "\"p999_ns\":%llu,\"max_ns\":%llu}",
+         benchRows > 0 ? "," : "",
+#else
+  printf("%s,%s,%d,%d,%d,%llu,%llu,%llu,%llu,%llu\n",
+         benchSuite,
+#endif
+         name, nthreads, batch, n,
+         total / n,
+         ns[(n - 1) * 500 / 1000],
+         ns[(n - 1) * 990 / 1000],
+         ns[(n - 1) * 999 / 1000],
+         ns[n - 1]);
+
+  benchRows++;
+}
+
+void
+benchEnd(void)
+{
+#ifdef BENCH_JSON
+  printf("\n]}\n");
+#endif
+  fflush(stdout);
+}
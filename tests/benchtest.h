@@ -49,4 +49,40 @@ void dummy_call(int * a);
 void interlocked_inc_with_conditionals(int *a);
 void interlocked_dec_with_conditionals(int *a);
 
+/*
+ * Benchmark harness (see benchlib.c)
+ *
+ * A scenario's run function performs 'batch' operations in one of
+ * 'nthreads' threads. Every thread times each batch, after a barrier
+ * so that all threads run the same sample concurrently; the first
+ * BENCH_WARMUP samples are discarded. Results are written as CSV, or
+ * as JSON when BENCH_JSON is defined.
+ */
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES           1000
+#endif
+#ifndef BENCH_WARMUP
+#define BENCH_WARMUP            10
+#endif
+#ifndef BENCH_MAX_THREADS
+#define BENCH_MAX_THREADS       8
+#endif
+
+typedef struct
+{
+  const char * name;
+  int batch;
+  void (*setup) (int nthreads);
+  void (*run) (int thread, int nthreads, int batch);
+  void (*teardown) (void);
+} benchScenario;
+
+unsigned long long benchNowMicros(void);
+int benchMaxThreads(void);
+void benchBegin(const char * suite);
+void benchRun(const benchScenario * scenario, int nthreads);
+void benchReport(const char * name, int nthreads, int batch,
+                 unsigned long long * ns, int n);
+void benchEnd(void);
+
 /****************************************************************************************/
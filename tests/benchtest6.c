@@ -0,0 +1,325 @@
+/*
+ * benchtest6.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Measure how fork/join workloads scale with the number of workers in
+ * the work-stealing task scheduler.
+ *
+ * - fib
+ *   Naive recursive Fibonacci, spawning one branch at every level.
+ *
+ * - Quicksort
+ *   Sort an array of pseudo-random integers, spawning the left
+ *   partition at every level.
+ *
+ * Each is run serially, then with 1 to N workers, N being the number of
+ * processors. Below a cutoff the recursion continues serially so that
+ * a task is worth stealing.
+ */
+
+#include "test.h"
+
+#ifdef __GNUC__
+#include <stdlib.h>
+#endif
+
+#include "benchtest.h"
+
+#define FIB_N           32
+#define FIB_CUTOFF      12
+#define SORT_SIZE       200000
+#define SORT_CUTOFF     2048
+
+static struct _timeb currSysTimeStart;
+static struct _timeb currSysTimeStop;
+static long durationMilliSecs;
+static long serialMilliSecs;
+
+static int * sortData;
+
+#define GetDurationMilliSecs(_TStart, _TStop) ((_TStop.time*1000+_TStop.millitm) \
+                                               - (_TStart.time*1000+_TStart.millitm))
+
+typedef struct
+{
+  int n;
+  int result;
+} fibArg;
+
+typedef struct
+{
+  int * a;
+  int n;
+} sortArg;
+
+static int
+fibSerial (int n)
+{
+  return n < 2 ? n : fibSerial(n - 1) + fibSerial(n - 2);
+}
+
+static void
+fibTask (void * arg)
+{
+  fibArg * f = (fibArg *) arg;
+  fibArg a, b;
+  pte_task_t t;
+
+  if (f->n < FIB_CUTOFF)
+    {
+      f->result = fibSerial(f->n);
+      return;
+    }
+
+  a.n = f->n - 1;
+  b.n = f->n - 2;
+
+  assert(pte_task_spawn_np(&t, fibTask, &a) == 0);
+  fibTask(&b);
+  assert(pte_task_sync_np(t) == 0);
+
+  f->result = a.result + b.result;
+}
+
+static int
+partition (int * a, int n)
+{
+  int pivot = a[(n - 1) / 2];
+  int i = -1;
+  int j = n;
+  int tmp;
+
+  for (;;)
+    {
+      do i++; while (a[i] < pivot);
+      do j--; while (a[j] > pivot);
+
+      if (i >= j)
+        {
+          return j + 1;
+        }
+
+      tmp = a[i];
+      a[i] = a[j];
+      a[j] = tmp;
+    }
+}
+
+static void
+sortSerial (int * a, int n)
+{
+  int p;
+
+  while (n > 1)
+    {
+      p = partition(a, n);
+      sortSerial(a, p);
+      a += p;
+      n -= p;
+    }
+}
+
+static void
+sortTask (void * arg)
+{
+  sortArg * s = (sortArg *) arg;
+  sortArg left, right;
+  pte_task_t t;
+  int p;
+
+  if (s->n < SORT_CUTOFF)
+    {
+      sortSerial(s->a, s->n);
+      return;
+    }
+
+  p = partition(s->a, s->n);
+
+  left.a = s->a;
+  left.n = p;
+  right.a = s->a + p;
+  right.n = s->n - p;
+
+  assert(pte_task_spawn_np(&t, sortTask, &left) == 0);
+  sortTask(&right);
+  assert(pte_task_sync_np(t) == 0);
+}
+
+static void
+fillSortData (void)
+{
+  unsigned int seed = 12345;
+  int i;
+
+  for (i = 0; i < SORT_SIZE; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      sortData[i] = (int) (seed >> 8);
+    }
+}
+
+static void
+checkSortData (void)
+{
+  int i;
+
+  for (i = 1; i < SORT_SIZE; i++)
+    {
+      assert(sortData[i - 1] <= sortData[i]);
+    }
+}
+
+static void
+report (char * testNameString, int workers)
+{
+  char name[64];
+
+  if (workers == 0)
+    {
+      serialMilliSecs = durationMilliSecs;
+      sprintf(name, "%s serial", testNameString);
+    }
+  else
+    {
+      sprintf(name, "%s, %d worker%s", testNameString, workers, workers > 1 ? "s" : "");
+    }
+
+  printf( "%-45s %15ld %15.2f\n",
+          name,
+          durationMilliSecs,
+          durationMilliSecs > 0 ? (float) serialMilliSecs / durationMilliSecs : 0.0f);
+}
+
+static void
+runFib (int workers)
+{
+  fibArg f;
+  pte_task_t t;
+
+  f.n = FIB_N;
+
+  _ftime(&currSysTimeStart);
+  if (workers == 0)
+    {
+      f.result = fibSerial(f.n);
+    }
+  else
+    {
+      assert(pte_task_spawn_np(&t, fibTask, &f) == 0);
+      assert(pte_task_sync_np(t) == 0);
+    }
+  _ftime(&currSysTimeStop);
+
+  assert(f.result == fibSerial(FIB_N));
+
+  durationMilliSecs = GetDurationMilliSecs(currSysTimeStart, currSysTimeStop);
+  report("fib", workers);
+}
+
+static void
+runSort (int workers)
+{
+  sortArg s;
+  pte_task_t t;
+
+  fillSortData();
+  s.a = sortData;
+  s.n = SORT_SIZE;
+
+  _ftime(&currSysTimeStart);
+  if (workers == 0)
+    {
+      sortSerial(s.a, s.n);
+    }
+  else
+    {
+      assert(pte_task_spawn_np(&t, sortTask, &s) == 0);
+      assert(pte_task_sync_np(t) == 0);
+    }
+  _ftime(&currSysTimeStop);
+
+  checkSortData();
+
+  durationMilliSecs = GetDurationMilliSecs(currSysTimeStart, currSysTimeStop);
+  report("Quicksort", workers);
+}
+
+
+int pthread_test_bench6()
+{
+  int ncpus = pthread_num_processors_np();
+  int workers;
+
+  sortData = (int *) malloc(SORT_SIZE * sizeof(int));
+  assert(sortData != NULL);
+
+  printf( "=============================================================================\n");
+  printf( "Fork/join scaling of the work-stealing task scheduler.\n");
+  printf( "fib(%d), quicksort of %d integers, 1 to %d workers.\n\n",
+          FIB_N, SORT_SIZE, ncpus);
+  printf( "%-45s %15s %15s\n",
+          "Test",
+          "Total(msec)",
+          "Speedup");
+
+  runFib(0);
+  for (workers = 1; workers <= ncpus; workers++)
+    {
+      assert(pte_task_init_np(workers) == 0);
+      runFib(workers);
+      assert(pte_task_shutdown_np() == 0);
+    }
+
+  printf( ".............................................................................\n");
+
+  runSort(0);
+  for (workers = 1; workers <= ncpus; workers++)
+    {
+      assert(pte_task_init_np(workers) == 0);
+      runSort(workers);
+      assert(pte_task_shutdown_np() == 0);
+    }
+
+  printf( "=============================================================================\n");
+
+  free(sortData);
+
+  return 0;
+}
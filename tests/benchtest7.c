@@ -0,0 +1,471 @@
+/*
+ * benchtest7.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Measure the cost of each synchronisation primitive under contention,
+ * from 1 to N threads, N being the number of processors (at least 2).
+ *
+ * - mutex, spin, spin ticket, inline lock
+ *   Lock, increment a shared counter, unlock.
+ *
+ * - rwlock
+ *   Read lock and unlock, taking a write lock for one in eight.
+ *
+ * - cond signal, cond broadcast
+ *   Threads take turns in a ring: each waits on a condition variable
+ *   for its turn, then passes it on by signalling the next thread's
+ *   condition variable, or by broadcasting one shared by all.
+ *
+ * - sem ping-pong
+ *   As above, each thread waiting on its own semaphore and posting
+ *   the next thread's.
+ *
+ * - barrier
+ *   Wait on a barrier for all the threads.
+ *
+ * - once done, once race
+ *   pthread_once() on a control that has already run, and with all
+ *   threads racing to run a fresh control.
+ *
+ * Each row gives the time per operation in nanoseconds, as the mean
+ * and percentiles of the samples taken by every thread (see
+ * benchlib.c). Define BENCH_JSON for JSON instead of CSV.
+ */
+
+#include "test.h"
+
+#ifdef __GNUC__
+#include <stdlib.h>
+#endif
+
+#include "benchtest.h"
+
+#define TOTAL_OPS(batch)        ((BENCH_WARMUP + BENCH_SAMPLES) * (batch))
+
+static pthread_mutex_t mx;
+static pthread_spinlock_t spin;
+static pte_lock_t inlineLock = PTE_LOCK_INITIALIZER;
+static pthread_rwlock_t rw;
+static pthread_cond_t cv;
+static pthread_cond_t cvs[BENCH_MAX_THREADS];
+static sem_t sems[BENCH_MAX_THREADS];
+static pthread_barrier_t barrier;
+static pthread_once_t doneOnce = PTHREAD_ONCE_INIT;
+static pthread_once_t * raceOnce;
+static int onceCalls;
+static int turn;
+static int opCount[BENCH_MAX_THREADS];
+static int shared;
+
+static void
+resetCounts (void)
+{
+  int i;
+
+  turn = 0;
+  shared = 0;
+  for (i = 0; i < BENCH_MAX_THREADS; i++)
+    {
+      opCount[i] = 0;
+    }
+}
+
+static void
+mutexSetup (int nthreads)
+{
+  resetCounts();
+  assert(pthread_mutex_init(&mx, NULL) == 0);
+}
+
+static void
+mutexRun (int thread, int nthreads, int batch)
+{
+  int i;
+
+  for (i = 0; i < batch; i++)
+    {
+      assert(pthread_mutex_lock(&mx) == 0);
+      shared++;
+      assert(pthread_mutex_unlock(&mx) == 0);
+    }
+}
+
+static void
+mutexTeardown (void)
+{
+  assert(pthread_mutex_destroy(&mx) == 0);
+}
+
+static void
+spinSetup (int nthreads)
+{
+  resetCounts();
+  assert(pthread_spin_init(&spin, PTHREAD_PROCESS_PRIVATE) == 0);
+}
+
+static void
+spinRun (int thread, int nthreads, int batch)
+{
+  int i;
+
+  for (i = 0; i < batch; i++)
+    {
+      assert(pthread_spin_lock(&spin) == 0);
+      shared++;
+      assert(pthread_spin_unlock(&spin) == 0);
+    }
+}
+
+static void
+spinTeardown (void)
+{
+  assert(pthread_spin_destroy(&spin) == 0);
+}
+
+static void
+spinTicketSetup (int nthreads)
+{
+  resetCounts();
+  assert(pthread_spin_init_np(&spin, PTHREAD_PROCESS_PRIVATE,
+                              PTHREAD_SPIN_TICKET_NP) == 0);
+}
+
+static void
+inlineSetup (int nthreads)
+{
+  resetCounts();
+  assert(pte_lock_init_np(&inlineLock) == 0);
+}
+
+static void
+inlineRun (int thread, int nthreads, int batch)
+{
+  int i;
+
+  for (i = 0; i < batch; i++)
+    {
+      assert(pte_lock_np(&inlineLock) == 0);
+      shared++;
+      assert(pte_unlock_np(&inlineLock) == 0);
+    }
+}
+
+static void
+rwlockSetup (int nthreads)
+{
+  resetCounts();
+  assert(pthread_rwlock_init(&rw, NULL) == 0);
+}
+
+static void
+rwlockRun (int thread, int nthreads, int batch)
+{
+  int i;
+
+  for (i = 0; i < batch; i++)
+    {
+      if ((i & 7) == 0)
+        {
+          assert(pthread_rwlock_wrlock(&rw) == 0);
+          shared++;
+        }
+      else
+        {
+          assert(pthread_rwlock_rdlock(&rw) == 0);
+        }
+      assert(pthread_rwlock_unlock(&rw) == 0);
+    }
+}
+
+static void
+rwlockTeardown (void)
+{
+  assert(pthread_rwlock_destroy(&rw) == 0);
+}
+
+static int condThreads;
+
+static void
+condSetup (int nthreads)
+{
+  int i;
+
+  resetCounts();
+  condThreads = nthreads;
+  assert(pthread_mutex_init(&mx, NULL) == 0);
+  assert(pthread_cond_init(&cv, NULL) == 0);
+  for (i = 0; i < nthreads; i++)
+    {
+      assert(pthread_cond_init(&cvs[i], NULL) == 0);
+    }
+}
+
+static void
+condRing (int thread, int nthreads, int batch, int broadcast)
+{
+  int i;
+
+  for (i = 0; i < batch; i++)
+    {
+      int myTurn = opCount[thread]++ * nthreads + thread;
+
+      assert(pthread_mutex_lock(&mx) == 0);
+      while (turn != myTurn)
+        {
+          assert(pthread_cond_wait(broadcast ? &cv : &cvs[thread], &mx) == 0);
+        }
+      turn++;
+      if (broadcast)
+        {
+          assert(pthread_cond_broadcast(&cv) == 0);
+        }
+      else
+        {
+          assert(pthread_cond_signal(&cvs[(thread + 1) % nthreads]) == 0);
+        }
+      assert(pthread_mutex_unlock(&mx) == 0);
+    }
+}
+
+static void
+condSignalRun (int thread, int nthreads, int batch)
+{
+  condRing(thread, nthreads, batch, 0);
+}
+
+static void
+condBroadcastRun (int thread, int nthreads, int batch)
+{
+  condRing(thread, nthreads, batch, 1);
+}
+
+static void
+condTeardown (void)
+{
+  int i;
+
+  for (i = 0; i < condThreads; i++)
+    {
+      assert(pthread_cond_destroy(&cvs[i]) == 0);
+    }
+  assert(pthread_cond_destroy(&cv) == 0);
+  assert(pthread_mutex_destroy(&mx) == 0);
+}
+
+static int semThreads;
+
+static void
+semSetup (int nthreads)
+{
+  int i;
+
+  resetCounts();
+  semThreads = nthreads;
+  for (i = 0; i < nthreads; i++)
+    {
+      assert(sem_init(&sems[i], 0, 0) == 0);
+    }
+}
+
+static void
+semRun (int thread, int nthreads, int batch)
+{
+  int total = TOTAL_OPS(batch);
+  int i;
+
+  /*
+   * Thread 0 starts the ring without waiting, and the last thread
+   * does not pass the token on after its final operation.
+   */
+  for (i = 0; i < batch; i++)
+    {
+      int k = opCount[thread]++;
+
+      if (thread != 0 || k != 0)
+        {
+          assert(sem_wait(&sems[thread]) == 0);
+        }
+      if (thread != nthreads - 1 || k != total - 1)
+        {
+          assert(sem_post(&sems[(thread + 1) % nthreads]) == 0);
+        }
+    }
+}
+
+static void
+semTeardown (void)
+{
+  int i;
+  int value;
+
+  for (i = 0; i < semThreads; i++)
+    {
+      assert(sem_getvalue(&sems[i], &value) == 0);
+      assert(value == 0);
+      assert(sem_destroy(&sems[i]) == 0);
+    }
+}
+
+static void
+barrierSetup (int nthreads)
+{
+  resetCounts();
+  assert(pthread_barrier_init(&barrier, NULL, nthreads) == 0);
+}
+
+static void
+barrierRun (int thread, int nthreads, int batch)
+{
+  int i;
+
+  for (i = 0; i < batch; i++)
+    {
+      int result = pthread_barrier_wait(&barrier);
+
+      assert(result == 0 || result == PTHREAD_BARRIER_SERIAL_THREAD);
+    }
+}
+
+static void
+barrierTeardown (void)
+{
+  assert(pthread_barrier_destroy(&barrier) == 0);
+}
+
+static void
+onceInit (void)
+{
+  onceCalls++;
+}
+
+static void
+onceDoneSetup (int nthreads)
+{
+  resetCounts();
+  assert(pthread_once(&doneOnce, onceInit) == 0);
+}
+
+static void
+onceDoneRun (int thread, int nthreads, int batch)
+{
+  int i;
+
+  for (i = 0; i < batch; i++)
+    {
+      assert(pthread_once(&doneOnce, onceInit) == 0);
+    }
+}
+
+static int raceBatch;
+
+static void
+onceRaceSetup (int nthreads)
+{
+  int i;
+
+  resetCounts();
+  onceCalls = 0;
+  raceOnce = (pthread_once_t *) malloc(TOTAL_OPS(raceBatch) * sizeof(pthread_once_t));
+  assert(raceOnce != NULL);
+  for (i = 0; i < TOTAL_OPS(raceBatch); i++)
+    {
+      pthread_once_t init = PTHREAD_ONCE_INIT;
+
+      raceOnce[i] = init;
+    }
+}
+
+static void
+onceRaceRun (int thread, int nthreads, int batch)
+{
+  int i;
+
+  for (i = 0; i < batch; i++)
+    {
+      assert(pthread_once(&raceOnce[opCount[thread]++], onceInit) == 0);
+    }
+}
+
+static void
+onceRaceTeardown (void)
+{
+  assert(onceCalls == TOTAL_OPS(raceBatch));
+  free(raceOnce);
+}
+
+static const benchScenario scenarios[] =
+  {
+    {"mutex", 200, mutexSetup, mutexRun, mutexTeardown},
+    {"spin", 200, spinSetup, spinRun, spinTeardown},
+    {"spin ticket", 200, spinTicketSetup, spinRun, spinTeardown},
+    {"inline lock", 200, inlineSetup, inlineRun, NULL},
+    {"rwlock", 200, rwlockSetup, rwlockRun, rwlockTeardown},
+    {"cond signal", 20, condSetup, condSignalRun, condTeardown},
+    {"cond broadcast", 20, condSetup, condBroadcastRun, condTeardown},
+    {"sem ping-pong", 20, semSetup, semRun, semTeardown},
+    {"barrier", 20, barrierSetup, barrierRun, barrierTeardown},
+    {"once done", 1000, onceDoneSetup, onceDoneRun, NULL},
+    {"once race", 10, onceRaceSetup, onceRaceRun, onceRaceTeardown}
+  };
+
+
+int pthread_test_bench7()
+{
+  int nscenarios = sizeof(scenarios) / sizeof(scenarios[0]);
+  int maxThreads = benchMaxThreads();
+  int nthreads;
+  int i;
+
+  benchBegin("bench7");
+
+  for (i = 0; i < nscenarios; i++)
+    {
+      raceBatch = scenarios[i].batch;
+
+      for (nthreads = 1; nthreads <= maxThreads; nthreads++)
+        {
+          benchRun(&scenarios[i], nthreads);
+        }
+    }
+
+  benchEnd();
+
+  return 0;
+}
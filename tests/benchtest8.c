@@ -0,0 +1,428 @@
+/*
+ * benchtest8.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Measure wake-up latency: the time from one thread waking another
+ * until the woken thread runs. Threads pass a token around a ring,
+ * each time stamping it just before waking the next thread, which
+ * takes the difference as soon as its wait returns.
+ *
+ * - sem
+ *   Each thread waits on its own semaphore and posts the next's.
+ *
+ * - cond
+ *   Each thread waits on its own condition variable for its turn
+ *   and signals the next's.
+ *
+ * - mutex handoff
+ *   Two threads take turns to unlock a mutex the other is blocked
+ *   locking.
+ *
+ * - barrier
+ *   The time from the last thread arriving at a barrier until each
+ *   of the others is released.
+ *
+ * - join
+ *   The time from a thread returning until pthread_join() returns.
+ *
+ * A single wake-up is timed by the OS clock, which counts whole
+ * microseconds, and typically lasts only a few. So each sample is the
+ * mean of BATCH consecutive wake-ups of one thread, in nanoseconds:
+ * the truncation error of the individual differences averages out.
+ * Rows are printed as in benchtest7, with BATCH as the batch.
+ */
+
+#include "test.h"
+
+#ifdef __GNUC__
+#include <stdlib.h>
+#endif
+
+#include "benchtest.h"
+#include "implement.h"
+
+#define ROUNDS          2000
+#define JOIN_ROUNDS     400
+#define BATCH           20
+
+static int ids[BENCH_MAX_THREADS];
+static unsigned long long samples[BENCH_MAX_THREADS * ROUNDS];
+static int nsamples[BENCH_MAX_THREADS];
+static unsigned long long batchSum[BENCH_MAX_THREADS];
+static int batchCount[BENCH_MAX_THREADS];
+static volatile unsigned long long stamp;
+static int nthreads;
+
+static pthread_mutex_t mx;
+static pthread_cond_t cvs[BENCH_MAX_THREADS];
+static sem_t sems[BENCH_MAX_THREADS];
+static pthread_barrier_t barrier;
+static int turn;
+
+static void
+record (int thread, int round, unsigned long long start)
+{
+  unsigned long long now = benchNowMicros();
+
+  if (round >= BENCH_WARMUP)
+    {
+      batchSum[thread] += now - start;
+      if (++batchCount[thread] == BATCH)
+        {
+          samples[thread * ROUNDS + nsamples[thread]++] =
+            batchSum[thread] * 1000 / BATCH;
+          batchSum[thread] = 0;
+          batchCount[thread] = 0;
+        }
+    }
+}
+
+/*
+ * Runs 'ring' in each of 'n' threads and reports the latencies they
+ * recorded.
+ */
+static void
+runRing (const char * name, int n, void * (*ring) (void *))
+{
+  pthread_t t[BENCH_MAX_THREADS];
+  int count = 0;
+  int i, j;
+
+  nthreads = n;
+  for (i = 0; i < n; i++)
+    {
+      ids[i] = i;
+      nsamples[i] = 0;
+      batchSum[i] = 0;
+      batchCount[i] = 0;
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      assert(pthread_create(&t[i], NULL, ring, &ids[i]) == 0);
+    }
+  for (i = 0; i < n; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      for (j = 0; j < nsamples[i]; j++)
+        {
+          samples[count++] = samples[i * ROUNDS + j];
+        }
+    }
+
+  benchReport(name, n, BATCH, samples, count);
+}
+
+static void *
+semRing (void * arg)
+{
+  int thread = *(int *) arg;
+  int r;
+
+  /*
+   * Thread 0 starts the ring without waiting, and the last thread
+   * does not pass the token on after its final round.
+   */
+  for (r = 0; r < ROUNDS; r++)
+    {
+      if (thread != 0 || r != 0)
+        {
+          assert(sem_wait(&sems[thread]) == 0);
+          record(thread, r, stamp);
+        }
+      if (thread != nthreads - 1 || r != ROUNDS - 1)
+        {
+          stamp = benchNowMicros();
+          assert(sem_post(&sems[(thread + 1) % nthreads]) == 0);
+        }
+    }
+
+  return NULL;
+}
+
+static void *
+condRing (void * arg)
+{
+  int thread = *(int *) arg;
+  int r;
+
+  for (r = 0; r < ROUNDS; r++)
+    {
+      int myTurn = r * nthreads + thread;
+      int waited = 0;
+
+      assert(pthread_mutex_lock(&mx) == 0);
+      while (turn != myTurn)
+        {
+          assert(pthread_cond_wait(&cvs[thread], &mx) == 0);
+          waited = 1;
+        }
+      if (waited)
+        {
+          record(thread, r, stamp);
+        }
+      turn++;
+      stamp = benchNowMicros();
+      assert(pthread_cond_signal(&cvs[(thread + 1) % nthreads]) == 0);
+      assert(pthread_mutex_unlock(&mx) == 0);
+    }
+
+  return NULL;
+}
+
+static int mutexLocked;
+static int mutexWaiting;
+static int handoffs;
+
+static void
+onBlock (const void * object, void * arg)
+{
+  if (object == mx)
+    {
+      (void) PTE_ATOMIC_EXCHANGE(&mutexWaiting, 1);
+    }
+}
+
+static pte_trace_hooks_t hooks = {onBlock, NULL, NULL, NULL, NULL, NULL, NULL};
+
+static void *
+mutexHandoff (void * arg)
+{
+  int thread = *(int *) arg;
+  int r;
+
+  /*
+   * Thread 0 holds the mutex for the first round. In each round the
+   * holder waits for the other thread to block on the mutex (seen
+   * through a trace hook), then unlocks it and waits for the other
+   * thread to take it before blocking on it in turn.
+   */
+  if (thread == 0)
+    {
+      assert(pthread_mutex_lock(&mx) == 0);
+      (void) PTE_ATOMIC_EXCHANGE(&mutexLocked, 1);
+    }
+  else
+    {
+      while (PTE_ATOMIC_COMPARE_EXCHANGE(&mutexLocked, 0, 0) == 0)
+        {
+          sched_yield();
+        }
+    }
+
+  for (r = 0; r < ROUNDS; r++)
+    {
+      if ((r & 1) == thread)
+        {
+          while (PTE_ATOMIC_EXCHANGE(&mutexWaiting, 0) == 0)
+            {
+              sched_yield();
+            }
+          stamp = benchNowMicros();
+          assert(pthread_mutex_unlock(&mx) == 0);
+          while (PTE_ATOMIC_COMPARE_EXCHANGE(&handoffs, 0, 0) == r)
+            {
+              sched_yield();
+            }
+        }
+      else
+        {
+          assert(pthread_mutex_lock(&mx) == 0);
+          record(thread, r, stamp);
+          (void) PTE_ATOMIC_EXCHANGE(&handoffs, r + 1);
+        }
+    }
+
+  if (((ROUNDS - 1) & 1) != thread)
+    {
+      assert(pthread_mutex_unlock(&mx) == 0);
+    }
+
+  return NULL;
+}
+
+static int arrival[2];
+static unsigned long long barrierBase;
+
+static int
+nowMicros (void)
+{
+  return (int) (benchNowMicros() - barrierBase);
+}
+
+static void *
+barrierRing (void * arg)
+{
+  int thread = *(int *) arg;
+  int r;
+
+  /*
+   * Arrival times are kept as microseconds from the start, so that
+   * the latest can be found with an int compare-and-exchange. The
+   * two slots alternate; the serial thread of one round clears the
+   * slot for the next but one, which every thread has finished with.
+   */
+  for (r = 0; r < ROUNDS; r++)
+    {
+      int * slot = &arrival[r & 1];
+      int mine = nowMicros();
+      int last;
+      int result;
+
+      do
+        {
+          last = PTE_ATOMIC_COMPARE_EXCHANGE(slot, 0, 0);
+        }
+      while (mine > last && PTE_ATOMIC_COMPARE_EXCHANGE(slot, mine, last) != last);
+
+      result = pthread_barrier_wait(&barrier);
+      assert(result == 0 || result == PTHREAD_BARRIER_SERIAL_THREAD);
+
+      last = PTE_ATOMIC_COMPARE_EXCHANGE(slot, 0, 0);
+      if (mine < last)
+        {
+          record(thread, r, barrierBase + last);
+        }
+
+      if (result == PTHREAD_BARRIER_SERIAL_THREAD)
+        {
+          (void) PTE_ATOMIC_EXCHANGE(&arrival[(r + 1) & 1], 0);
+        }
+    }
+
+  return NULL;
+}
+
+static void *
+joinee (void * arg)
+{
+  /*
+   * Give the joiner time to block in pthread_join()
+   */
+  pte_osThreadSleep(1);
+  stamp = benchNowMicros();
+  return NULL;
+}
+
+static void
+runJoin (void)
+{
+  pthread_t t;
+  int r;
+
+  nsamples[0] = 0;
+  batchSum[0] = 0;
+  batchCount[0] = 0;
+
+  for (r = 0; r < JOIN_ROUNDS; r++)
+    {
+      assert(pthread_create(&t, NULL, joinee, NULL) == 0);
+      assert(pthread_join(t, NULL) == 0);
+      record(0, r, stamp);
+    }
+
+  benchReport("join", 2, BATCH, samples, nsamples[0]);
+}
+
+
+int pthread_test_bench8()
+{
+  int maxThreads = benchMaxThreads();
+  int n, i;
+
+  benchBegin("bench8");
+
+  for (n = 2; n <= maxThreads; n++)
+    {
+      for (i = 0; i < n; i++)
+        {
+          assert(sem_init(&sems[i], 0, 0) == 0);
+        }
+      runRing("sem", n, semRing);
+      for (i = 0; i < n; i++)
+        {
+          assert(sem_destroy(&sems[i]) == 0);
+        }
+    }
+
+  for (n = 2; n <= maxThreads; n++)
+    {
+      turn = 0;
+      assert(pthread_mutex_init(&mx, NULL) == 0);
+      for (i = 0; i < n; i++)
+        {
+          assert(pthread_cond_init(&cvs[i], NULL) == 0);
+        }
+      runRing("cond", n, condRing);
+      for (i = 0; i < n; i++)
+        {
+          assert(pthread_cond_destroy(&cvs[i]) == 0);
+        }
+      assert(pthread_mutex_destroy(&mx) == 0);
+    }
+
+  mutexLocked = 0;
+  mutexWaiting = 0;
+  handoffs = 0;
+  assert(pthread_mutex_init(&mx, NULL) == 0);
+  assert(pte_set_trace_hooks_np(&hooks) == 0);
+  runRing("mutex handoff", 2, mutexHandoff);
+  assert(pte_set_trace_hooks_np(NULL) == 0);
+  assert(pthread_mutex_destroy(&mx) == 0);
+
+  for (n = 2; n <= maxThreads; n++)
+    {
+      arrival[0] = arrival[1] = 0;
+      barrierBase = benchNowMicros();
+      assert(pthread_barrier_init(&barrier, NULL, n) == 0);
+      runRing("barrier", n, barrierRing);
+      assert(pthread_barrier_destroy(&barrier) == 0);
+    }
+
+  runJoin();
+
+  benchEnd();
+
+  return 0;
+}
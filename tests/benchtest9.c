@@ -0,0 +1,433 @@
+/*
+ * benchtest9.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Measure how throughput scales with the number of threads hammering
+ * one shared object, at 1, 2, 4, ... up to BENCH_MAX_THREADS threads.
+ *
+ * - mutex, spin, spin ticket
+ *   Lock, increment a shared counter, unlock.
+ *
+ * - spin cas
+ *   The same with a bare compare-and-exchange loop, as spinlocks
+ *   were before they backed off, for comparison.
+ *
+ * - rwlock N% reads
+ *   Read lock and unlock N% of the time, otherwise write lock and
+ *   unlock.
+ *
+ * - sem queue
+ *   A bounded queue guarded by two counting semaphores; half the
+ *   threads put items in, the other half take them out.
+ *
+ * - tsd
+ *   pthread_setspecific() then pthread_getspecific().
+ *
+ * Each row gives the operations per second of all threads together
+ * over DURATION_MSECS. A row is marked as a collapse when throughput
+ * falls below COLLAPSE_PERCENT of the best seen with fewer threads,
+ * pointing at the primitive that stops scaling instead of levelling
+ * off. Define BENCH_JSON for JSON instead of CSV.
+ */
+
+#include "test.h"
+
+#ifdef __GNUC__
+#include <stdlib.h>
+#endif
+
+#include "benchtest.h"
+
+#define DURATION_MSECS          200
+#define COLLAPSE_PERCENT        50
+#define QUEUE_SIZE              64
+
+typedef struct
+{
+  const char * name;
+  int param;
+  void (*setup) (int nthreads);
+  int (*op) (int thread, int nthreads, int param);
+  void (*release) (int nthreads);       /* Wakes threads blocked at the end */
+  void (*teardown) (int nthreads);
+} scaleScenario;
+
+typedef struct
+{
+  const scaleScenario * scenario;
+  int thread;
+  int nthreads;
+  unsigned long ops;
+} scaleWorkerArg;
+
+static pthread_barrier_t startBarrier;
+static volatile int stop;
+
+static pthread_mutex_t mx;
+static pthread_spinlock_t spin;
+static int casWord;
+static pthread_rwlock_t rw;
+static sem_t slots;
+static sem_t items;
+static pthread_key_t key;
+static int shared;
+static int queued;
+static int rwCount[BENCH_MAX_THREADS];
+
+static void
+mutexSetup (int nthreads)
+{
+  assert(pthread_mutex_init(&mx, NULL) == 0);
+}
+
+static int
+mutexOp (int thread, int nthreads, int param)
+{
+  assert(pthread_mutex_lock(&mx) == 0);
+  shared++;
+  assert(pthread_mutex_unlock(&mx) == 0);
+  return 1;
+}
+
+static void
+mutexTeardown (int nthreads)
+{
+  assert(pthread_mutex_destroy(&mx) == 0);
+}
+
+static void
+spinSetup (int nthreads)
+{
+  assert(pthread_spin_init(&spin, PTHREAD_PROCESS_PRIVATE) == 0);
+}
+
+static int
+spinOp (int thread, int nthreads, int param)
+{
+  assert(pthread_spin_lock(&spin) == 0);
+  shared++;
+  assert(pthread_spin_unlock(&spin) == 0);
+  return 1;
+}
+
+static void
+spinTeardown (int nthreads)
+{
+  assert(pthread_spin_destroy(&spin) == 0);
+}
+
+static void
+spinTicketSetup (int nthreads)
+{
+  assert(pthread_spin_init_np(&spin, PTHREAD_PROCESS_PRIVATE,
+                              PTHREAD_SPIN_TICKET_NP) == 0);
+}
+
+static void
+casSetup (int nthreads)
+{
+  casWord = 0;
+}
+
+static int
+casOp (int thread, int nthreads, int param)
+{
+  while (pte_osAtomicCompareExchange(&casWord, 1, 0) != 0)
+    {
+    }
+  shared++;
+  (void) pte_osAtomicExchange(&casWord, 0);
+  return 1;
+}
+
+static void
+rwlockSetup (int nthreads)
+{
+  int i;
+
+  for (i = 0; i < BENCH_MAX_THREADS; i++)
+    {
+      rwCount[i] = 0;
+    }
+  assert(pthread_rwlock_init(&rw, NULL) == 0);
+}
+
+static int
+rwlockOp (int thread, int nthreads, int param)
+{
+  if (rwCount[thread]++ % 100 < param)
+    {
+      assert(pthread_rwlock_rdlock(&rw) == 0);
+    }
+  else
+    {
+      assert(pthread_rwlock_wrlock(&rw) == 0);
+      shared++;
+    }
+  assert(pthread_rwlock_unlock(&rw) == 0);
+  return 1;
+}
+
+static void
+rwlockTeardown (int nthreads)
+{
+  assert(pthread_rwlock_destroy(&rw) == 0);
+}
+
+static void
+semSetup (int nthreads)
+{
+  queued = 0;
+  assert(pthread_mutex_init(&mx, NULL) == 0);
+  assert(sem_init(&slots, 0, QUEUE_SIZE) == 0);
+  assert(sem_init(&items, 0, 0) == 0);
+}
+
+static void
+semPut (void)
+{
+  assert(sem_wait(&slots) == 0);
+  assert(pthread_mutex_lock(&mx) == 0);
+  queued++;
+  assert(pthread_mutex_unlock(&mx) == 0);
+  assert(sem_post(&items) == 0);
+}
+
+static void
+semTake (void)
+{
+  assert(sem_wait(&items) == 0);
+  assert(pthread_mutex_lock(&mx) == 0);
+  queued--;
+  assert(pthread_mutex_unlock(&mx) == 0);
+  assert(sem_post(&slots) == 0);
+}
+
+static int
+semOp (int thread, int nthreads, int param)
+{
+  if (nthreads == 1)
+    {
+      semPut();
+      semTake();
+      return 2;
+    }
+
+  if (thread & 1)
+    {
+      semTake();
+    }
+  else
+    {
+      semPut();
+    }
+  return 1;
+}
+
+static void
+semRelease (int nthreads)
+{
+  int i;
+
+  for (i = 0; i < nthreads; i++)
+    {
+      assert(sem_post(&slots) == 0);
+      assert(sem_post(&items) == 0);
+    }
+}
+
+static void
+semTeardown (int nthreads)
+{
+  assert(sem_destroy(&items) == 0);
+  assert(sem_destroy(&slots) == 0);
+  assert(pthread_mutex_destroy(&mx) == 0);
+}
+
+static void
+tsdSetup (int nthreads)
+{
+  assert(pthread_key_create(&key, NULL) == 0);
+}
+
+static int
+tsdOp (int thread, int nthreads, int param)
+{
+  assert(pthread_setspecific(key, &rwCount[thread]) == 0);
+  assert(pthread_getspecific(key) == &rwCount[thread]);
+  return 1;
+}
+
+static void
+tsdTeardown (int nthreads)
+{
+  assert(pthread_key_delete(key) == 0);
+}
+
+static const scaleScenario scenarios[] =
+  {
+    {"mutex", 0, mutexSetup, mutexOp, NULL, mutexTeardown},
+    {"spin", 0, spinSetup, spinOp, NULL, spinTeardown},
+    {"spin ticket", 0, spinTicketSetup, spinOp, NULL, spinTeardown},
+    {"spin cas", 0, casSetup, casOp, NULL, NULL},
+    {"rwlock 50% reads", 50, rwlockSetup, rwlockOp, NULL, rwlockTeardown},
+    {"rwlock 90% reads", 90, rwlockSetup, rwlockOp, NULL, rwlockTeardown},
+    {"rwlock 99% reads", 99, rwlockSetup, rwlockOp, NULL, rwlockTeardown},
+    {"sem queue", 0, semSetup, semOp, semRelease, semTeardown},
+    {"tsd", 0, tsdSetup, tsdOp, NULL, tsdTeardown}
+  };
+
+static void *
+scaleWorker (void * arg)
+{
+  scaleWorkerArg * a = (scaleWorkerArg *) arg;
+
+  pthread_barrier_wait(&startBarrier);
+
+  while (!stop)
+    {
+      a->ops += a->scenario->op(a->thread, a->nthreads, a->scenario->param);
+    }
+
+  return NULL;
+}
+
+/*
+ * Returns the operations per second of 'nthreads' threads running
+ * the scenario for DURATION_MSECS.
+ */
+static unsigned long long
+measure (const scaleScenario * scenario, int nthreads)
+{
+  pthread_t t[BENCH_MAX_THREADS];
+  scaleWorkerArg arg[BENCH_MAX_THREADS];
+  unsigned long long start, elapsed;
+  unsigned long long ops = 0;
+  int i;
+
+  stop = 0;
+  scenario->setup(nthreads);
+  assert(pthread_barrier_init(&startBarrier, NULL, nthreads + 1) == 0);
+
+  for (i = 0; i < nthreads; i++)
+    {
+      arg[i].scenario = scenario;
+      arg[i].thread = i;
+      arg[i].nthreads = nthreads;
+      arg[i].ops = 0;
+      assert(pthread_create(&t[i], NULL, scaleWorker, &arg[i]) == 0);
+    }
+
+  pthread_barrier_wait(&startBarrier);
+  start = benchNowMicros();
+  pte_osThreadSleep(DURATION_MSECS);
+  stop = 1;
+  elapsed = benchNowMicros() - start;
+
+  if (scenario->release != NULL)
+    {
+      scenario->release(nthreads);
+    }
+
+  for (i = 0; i < nthreads; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+      ops += arg[i].ops;
+    }
+
+  assert(pthread_barrier_destroy(&startBarrier) == 0);
+
+  if (scenario->teardown != NULL)
+    {
+      scenario->teardown(nthreads);
+    }
+
+  return ops * 1000000ULL / elapsed;
+}
+
+
+int pthread_test_bench9()
+{
+  int nscenarios = sizeof(scenarios) / sizeof(scenarios[0]);
+  int rows = 0;
+  int i;
+
+#ifdef BENCH_JSON
+  printf("{\"suite\":\"bench9\",\"results\":[");
+#else
+  printf("suite,scenario,threads,ops_per_sec,collapse\n");
+#endif
+
+  for (i = 0; i < nscenarios; i++)
+    {
+      unsigned long long best = 0;
+      int nthreads;
+
+      for (nthreads = 1; nthreads <= BENCH_MAX_THREADS; nthreads *= 2)
+        {
+          unsigned long long rate = measure(&scenarios[i], nthreads);
+          int collapse = (rate * 100 < best * COLLAPSE_PERCENT);
+
+#ifdef BENCH_JSON
+          printf("%s\n{\"scenario\":\"%s\",\"threads\":%d,"
+                 "\"ops_per_sec\":%llu,\"collapse\":%s}",
+                 rows > 0 ? "," : "",
+                 scenarios[i].name, nthreads, rate,
+                 collapse ? "true" : "false");
+#else
+          printf("bench9,%s,%d,%llu,%d\n",
+                 scenarios[i].name, nthreads, rate, collapse);
+#endif
+          rows++;
+
+          if (rate > best)
+            {
+              best = rate;
+            }
+        }
+    }
+
+#ifdef BENCH_JSON
+  printf("\n]}\n");
+#endif
+  fflush(stdout);
+
+  return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * File: cancel10.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test the published cancel-pending word: a request made while
+ * - cancelation is disabled is held until it is enabled, pthread_delay_np()
+ * - acts on a request that arrives while it sleeps, and a condition
+ * - wait entered with a request pending is canceled without blocking.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#include "../implement.h"
+
+static pthread_mutex_t mx;
+static pthread_cond_t cv;
+static sem_t ready;
+static sem_t go;
+static volatile int reached;
+
+static int pending(void)
+{
+  return ((pte_thread_t *) pthread_self())->cancelPending;
+}
+
+static void * heldFunc(void * arg)
+{
+  assert(pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL) == 0);
+  assert(sem_post(&ready) == 0);
+  assert(sem_wait(&go) == 0);
+
+  /* Requested but disabled: nothing to act on. */
+  assert(pending() == 0);
+  pthread_testcancel();
+
+  assert(pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL) == 0);
+  assert(pending() != 0);
+  pthread_testcancel();
+
+  reached = 1;
+  return NULL;
+}
+
+static void * delayFunc(void * arg)
+{
+  struct timespec interval = { 0, 300000000L };
+
+  assert(sem_post(&ready) == 0);
+  assert(pthread_delay_np(&interval) == 0);
+
+  reached = 1;
+  return NULL;
+}
+
+static void * condFunc(void * arg)
+{
+  assert(pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL) == 0);
+  assert(sem_post(&ready) == 0);
+  assert(sem_wait(&go) == 0);
+
+  assert(pthread_mutex_lock(&mx) == 0);
+  pthread_cleanup_push((void (*)(void *)) pthread_mutex_unlock, &mx);
+  assert(pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL) == 0);
+  (void) pthread_cond_wait(&cv, &mx);
+  reached = 1;
+  pthread_cleanup_pop(1);
+
+  return NULL;
+}
+
+static void runCanceled(void * (*func)(void *), int release)
+{
+  pthread_t t;
+  void * result = NULL;
+
+  reached = 0;
+  assert(pthread_create(&t, NULL, func, NULL) == 0);
+  assert(sem_wait(&ready) == 0);
+
+  if (!release)
+    {
+      /* Let it get into its sleep first. */
+      pte_osThreadSleep(50);
+    }
+
+  assert(pthread_cancel(t) == 0);
+
+  if (release)
+    {
+      assert(sem_post(&go) == 0);
+    }
+
+  assert(pthread_join(t, &result) == 0);
+  assert(result == PTHREAD_CANCELED);
+  assert(reached == 0);
+}
+
+int pthread_test_cancel10()
+{
+  assert(sem_init(&ready, 0, 0) == 0);
+  assert(sem_init(&go, 0, 0) == 0);
+  assert(pthread_mutex_init(&mx, NULL) == 0);
+  assert(pthread_cond_init(&cv, NULL) == 0);
+
+  assert(pending() == 0);
+
+  runCanceled(heldFunc, 1);
+  runCanceled(delayFunc, 0);
+  runCanceled(condFunc, 1);
+
+  assert(pthread_cond_destroy(&cv) == 0);
+  assert(pthread_mutex_destroy(&mx) == 0);
+  assert(sem_destroy(&go) == 0);
+  assert(sem_destroy(&ready) == 0);
+
+  return 0;
+}
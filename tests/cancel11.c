@@ -0,0 +1,169 @@
+/*
+ * File: cancel11.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test that pthread_cond_signal(), pthread_cond_broadcast() and
+ * - pthread_barrier_wait(), which are not cancellation points, complete
+ * - normally in a thread with a cancel pending, including when they
+ * - have to wait on the condition variable's internal gate.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+static pthread_mutex_t mx;
+static pthread_cond_t cv;
+static pthread_barrier_t barrier;
+static sem_t ready;
+static sem_t go;
+static int flag;
+static volatile int reached;
+
+static void * waiterFunc(void * arg)
+{
+  assert(pthread_mutex_lock(&mx) == 0);
+  while (!flag)
+    {
+      assert(pthread_cond_wait(&cv, &mx) == 0);
+    }
+  assert(pthread_mutex_unlock(&mx) == 0);
+
+  return NULL;
+}
+
+static void * signalFunc(void * arg)
+{
+  int result;
+
+  assert(pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL) == 0);
+  assert(sem_post(&ready) == 0);
+  assert(sem_wait(&go) == 0);
+  assert(pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL) == 0);
+
+  assert(pthread_cond_signal(&cv) == 0);
+  assert(pthread_cond_broadcast(&cv) == 0);
+  result = pthread_barrier_wait(&barrier);
+  assert(result == 0 || result == PTHREAD_BARRIER_SERIAL_THREAD);
+
+  reached = 1;
+  pthread_testcancel();
+
+  return NULL;
+}
+
+int pthread_test_cancel11()
+{
+  pthread_t w;
+  pthread_t t;
+  void * result = NULL;
+  int rc;
+
+  flag = 0;
+  reached = 0;
+  assert(pthread_mutex_init(&mx, NULL) == 0);
+  assert(pthread_cond_init(&cv, NULL) == 0);
+  assert(pthread_barrier_init(&barrier, NULL, 2) == 0);
+  assert(sem_init(&ready, 0, 0) == 0);
+  assert(sem_init(&go, 0, 0) == 0);
+
+  assert(pthread_create(&w, NULL, waiterFunc, NULL) == 0);
+  /* Let the waiter block on the condition variable. */
+  pte_osThreadSleep(50);
+
+  assert(pthread_create(&t, NULL, signalFunc, NULL) == 0);
+  assert(sem_wait(&ready) == 0);
+  assert(pthread_cancel(t) == 0);
+  assert(sem_post(&go) == 0);
+
+  rc = pthread_barrier_wait(&barrier);
+  assert(rc == 0 || rc == PTHREAD_BARRIER_SERIAL_THREAD);
+
+  assert(pthread_join(t, &result) == 0);
+  assert(result == PTHREAD_CANCELED);
+  assert(reached == 1);
+
+  assert(pthread_mutex_lock(&mx) == 0);
+  flag = 1;
+  assert(pthread_cond_broadcast(&cv) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  assert(pthread_join(w, NULL) == 0);
+
+  assert(sem_destroy(&go) == 0);
+  assert(sem_destroy(&ready) == 0);
+  assert(pthread_barrier_destroy(&barrier) == 0);
+  assert(pthread_cond_destroy(&cv) == 0);
+  assert(pthread_mutex_destroy(&mx) == 0);
+
+  return 0;
+}
@@ -0,0 +1,192 @@
+/*
+ * File: inlinelock1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test inline locks: static initialisation, trylock, error returns,
+ * - blocking and wakeup, and mutual exclusion with locks embedded in an
+ * - array of structures.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#define NTHREADS 4
+#define NLOOPS 5000
+#define NBUCKETS 8
+
+typedef struct
+{
+  pte_lock_t lock;
+  int count;
+} bucket;
+
+static pte_lock_t lock = PTE_LOCK_INITIALIZER;
+static bucket buckets[NBUCKETS];
+static int total;
+static int acquired;
+
+static void * blockFunc(void * arg)
+{
+  assert(pte_lock_np(&lock) == 0);
+  acquired = 1;
+  assert(pte_unlock_np(&lock) == 0);
+
+  return NULL;
+}
+
+static void * countFunc(void * arg)
+{
+  int id = (int) (size_t) arg;
+  int i;
+
+  for (i = 0; i < NLOOPS; i++)
+    {
+      bucket * b = &buckets[(i + id) % NBUCKETS];
+
+      assert(pte_lock_np(&b->lock) == 0);
+      b->count++;
+      assert(pte_unlock_np(&b->lock) == 0);
+
+      assert(pte_lock_np(&lock) == 0);
+      total++;
+      if ((i & 63) == 0)
+        {
+          sched_yield();
+        }
+      assert(pte_unlock_np(&lock) == 0);
+    }
+
+  return NULL;
+}
+
+int pthread_test_inlinelock1()
+{
+  pthread_t t[NTHREADS];
+  int i, sum;
+
+  assert(pte_lock_init_np(NULL) == EINVAL);
+  assert(pte_lock_np(NULL) == EINVAL);
+  assert(pte_trylock_np(NULL) == EINVAL);
+  assert(pte_unlock_np(NULL) == EINVAL);
+
+  assert(pte_trylock_np(&lock) == 0);
+  assert(pte_trylock_np(&lock) == EBUSY);
+  assert(pte_unlock_np(&lock) == 0);
+  assert(pte_unlock_np(&lock) == EPERM);
+
+  /*
+   * A waiter blocks until the lock is released
+   */
+  acquired = 0;
+  assert(pte_lock_np(&lock) == 0);
+  assert(pthread_create(&t[0], NULL, blockFunc, NULL) == 0);
+  pte_osThreadSleep(100);
+  assert(acquired == 0);
+  assert(pte_unlock_np(&lock) == 0);
+  assert(pthread_join(t[0], NULL) == 0);
+  assert(acquired == 1);
+
+  /*
+   * Mutual exclusion
+   */
+  total = 0;
+  for (i = 0; i < NBUCKETS; i++)
+    {
+      assert(pte_lock_init_np(&buckets[i].lock) == 0);
+      buckets[i].count = 0;
+    }
+
+  for (i = 0; i < NTHREADS; i++)
+    {
+      assert(pthread_create(&t[i], NULL, countFunc, (void *) (size_t) i) == 0);
+    }
+
+  for (i = 0; i < NTHREADS; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+
+  assert(total == NTHREADS * NLOOPS);
+
+  for (i = 0, sum = 0; i < NBUCKETS; i++)
+    {
+      sum += buckets[i].count;
+    }
+  assert(sum == NTHREADS * NLOOPS);
+
+  assert(pte_trylock_np(&lock) == 0);
+  assert(pte_unlock_np(&lock) == 0);
+
+  return 0;
+}
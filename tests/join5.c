@@ -0,0 +1,182 @@
+/*
+ * File: join5.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test pthread_tryjoin_np() and pthread_timedjoin_np() on running,
+ * - finished and detached threads.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+static volatile int release = 0;
+
+static void *
+func(void * arg)
+{
+  while (!release)
+    {
+      pte_osThreadSleep(10);
+    }
+
+  return arg;
+}
+
+static void *
+quick(void * arg)
+{
+  return arg;
+}
+
+static void
+deadline(struct timespec * abstime, int msecs)
+{
+  struct timeb currSysTime;
+  const long NANOSEC_PER_MILLISEC = 1000000;
+
+  _ftime(&currSysTime);
+
+  currSysTime.time += msecs / 1000;
+  currSysTime.millitm += msecs % 1000;
+  if (currSysTime.millitm >= 1000)
+    {
+      currSysTime.time++;
+      currSysTime.millitm -= 1000;
+    }
+
+  abstime->tv_sec = currSysTime.time;
+  abstime->tv_nsec = NANOSEC_PER_MILLISEC * currSysTime.millitm;
+}
+
+int pthread_test_join5()
+{
+  pthread_t t;
+  pthread_attr_t attr;
+  struct timespec abstime;
+  void * result = NULL;
+
+  release = 0;
+
+  /* Running thread: neither join completes, and it stays joinable */
+  assert(pthread_create(&t, NULL, func, (void *) 1) == 0);
+
+  assert(pthread_tryjoin_np(t, &result) == EBUSY);
+
+  deadline(&abstime, 100);
+  assert(pthread_timedjoin_np(t, &result, &abstime) == ETIMEDOUT);
+  assert(result == NULL);
+
+  assert(pthread_timedjoin_np(t, &result, NULL) == EINVAL);
+
+  release = 1;
+
+  deadline(&abstime, 5000);
+  assert(pthread_timedjoin_np(t, &result, &abstime) == 0);
+  assert(result == (void *) 1);
+
+  /* Finished thread: a try-join reaps it */
+  assert(pthread_create(&t, NULL, quick, (void *) 2) == 0);
+
+  result = NULL;
+  while (pthread_tryjoin_np(t, &result) == EBUSY)
+    {
+      pte_osThreadSleep(10);
+    }
+  assert(result == (void *) 2);
+
+  /* A deadline in the past still reaps a finished thread */
+  assert(pthread_create(&t, NULL, quick, (void *) 3) == 0);
+  pte_osThreadSleep(100);
+
+  deadline(&abstime, -1000);
+  assert(pthread_timedjoin_np(t, &result, &abstime) == 0);
+  assert(result == (void *) 3);
+
+  /* Detached threads can't be joined */
+  release = 0;
+  assert(pthread_attr_init(&attr) == 0);
+  assert(pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED) == 0);
+  assert(pthread_create(&t, &attr, func, NULL) == 0);
+  assert(pthread_attr_destroy(&attr) == 0);
+
+  assert(pthread_tryjoin_np(t, NULL) == EINVAL);
+  deadline(&abstime, 100);
+  assert(pthread_timedjoin_np(t, NULL, &abstime) == EINVAL);
+
+  release = 1;
+  pte_osThreadSleep(100);
+
+  /* Success. */
+  return 0;
+}
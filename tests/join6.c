@@ -0,0 +1,159 @@
+/*
+ * File: join6.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test pthread_join_any_np() reaping a set of threads in the order
+ * - they finish.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#define NUMTHREADS 8
+
+static void *
+func(void * arg)
+{
+  int id = (int) (size_t) arg;
+
+  /* Thread 0 finishes last, thread NUMTHREADS - 1 first */
+  pte_osThreadSleep(50 + 100 * (NUMTHREADS - id));
+
+  return arg;
+}
+
+int pthread_test_join6()
+{
+  pthread_t t[NUMTHREADS];
+  pthread_t d;
+  pthread_attr_t attr;
+  void * result;
+  int reaped[NUMTHREADS];
+  int n;
+  int i;
+  int which;
+
+  assert(pthread_join_any_np(t, 0, &which, NULL) == EINVAL);
+  assert(pthread_join_any_np(NULL, 1, &which, NULL) == EINVAL);
+
+  for (i = 0; i < NUMTHREADS; i++)
+    {
+      reaped[i] = 0;
+      assert(pthread_create(&t[i], NULL, func, (void *) (size_t) i) == 0);
+    }
+
+  for (n = NUMTHREADS; n > 0; n--)
+    {
+      which = -1;
+      result = NULL;
+      assert(pthread_join_any_np(t, n, &which, &result) == 0);
+      assert(which >= 0 && which < n);
+
+      i = (int) (size_t) result;
+      assert(i >= 0 && i < NUMTHREADS);
+      assert(reaped[i] == 0);
+      reaped[i] = 1;
+
+      /* The threads finish one by one from the last */
+      assert(i == n - 1);
+
+      t[which] = t[n - 1];
+    }
+
+  /* A thread that has already finished is reaped at once */
+  assert(pthread_create(&t[0], NULL, func, (void *) (size_t) NUMTHREADS) == 0);
+  pte_osThreadSleep(200);
+  assert(pthread_create(&t[1], NULL, func, (void *) 0) == 0);
+
+  assert(pthread_join_any_np(t, 2, &which, &result) == 0);
+  assert(which == 0);
+  assert(result == (void *) (size_t) NUMTHREADS);
+  assert(pthread_join(t[1], NULL) == 0);
+
+  /* Detached threads can't be joined */
+  assert(pthread_attr_init(&attr) == 0);
+  assert(pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED) == 0);
+  assert(pthread_create(&d, &attr, func, (void *) (size_t) NUMTHREADS) == 0);
+  assert(pthread_attr_destroy(&attr) == 0);
+
+  assert(pthread_create(&t[0], NULL, func, (void *) (size_t) NUMTHREADS) == 0);
+  t[1] = d;
+  assert(pthread_join_any_np(t, 2, &which, NULL) == EINVAL);
+  assert(pthread_join(t[0], NULL) == 0);
+
+  pte_osThreadSleep(200);
+
+  /* Success. */
+  return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * File: join7.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test pthread_join_batch_np() collecting the exit values of a set
+ * - of threads, including threads that exit with pthread_exit().
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#define NUMTHREADS 16
+
+static void *
+func(void * arg)
+{
+  int id = (int) (size_t) arg;
+
+  pte_osThreadSleep(10 * (id % 4));
+
+  if (id & 1)
+    {
+      pthread_exit((void *) (size_t) (id + 100));
+    }
+
+  return (void *) (size_t) (id + 100);
+}
+
+static pthread_t batch[2];
+
+static void *
+slow(void * arg)
+{
+  pte_osThreadSleep(1000);
+
+  return arg;
+}
+
+static void *
+joiner(void * arg)
+{
+  (void) pthread_join_batch_np(batch, 2, NULL);
+
+  return NULL;
+}
+
+int pthread_test_join7()
+{
+  pthread_t t[NUMTHREADS];
+  void * result[NUMTHREADS];
+  pthread_attr_t attr;
+  int i;
+
+  assert(pthread_join_batch_np(t, 0, result) == EINVAL);
+  assert(pthread_join_batch_np(NULL, 1, result) == EINVAL);
+
+  for (i = 0; i < NUMTHREADS; i++)
+    {
+      result[i] = NULL;
+      assert(pthread_create(&t[i], NULL, func, (void *) (size_t) i) == 0);
+    }
+
+  assert(pthread_join_batch_np(t, NUMTHREADS, result) == 0);
+
+  for (i = 0; i < NUMTHREADS; i++)
+    {
+      assert(result[i] == (void *) (size_t) (i + 100));
+    }
+
+  /* Exit values may be discarded */
+  for (i = 0; i < NUMTHREADS; i++)
+    {
+      assert(pthread_create(&t[i], NULL, func, (void *) (size_t) i) == 0);
+    }
+
+  assert(pthread_join_batch_np(t, NUMTHREADS, NULL) == 0);
+
+  /* A detached thread fails the whole batch, leaving the rest joinable */
+  assert(pthread_create(&t[0], NULL, func, (void *) 0) == 0);
+
+  assert(pthread_attr_init(&attr) == 0);
+  assert(pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED) == 0);
+  assert(pthread_create(&t[1], &attr, func, (void *) 1) == 0);
+  assert(pthread_attr_destroy(&attr) == 0);
+
+  assert(pthread_join_batch_np(t, 2, result) == EINVAL);
+
+  assert(pthread_join(t[0], &result[0]) == 0);
+  assert(result[0] == (void *) 100);
+
+  /* A canceled batch join leaves every thread joinable */
+  assert(pthread_create(&batch[0], NULL, func, (void *) 0) == 0);
+  assert(pthread_create(&batch[1], NULL, slow, (void *) 1) == 0);
+  assert(pthread_create(&t[0], NULL, joiner, NULL) == 0);
+
+  pte_osThreadSleep(200);
+  assert(pthread_cancel(t[0]) == 0);
+  assert(pthread_join(t[0], &result[0]) == 0);
+  assert(result[0] == PTHREAD_CANCELED);
+
+  assert(pthread_join(batch[0], &result[0]) == 0);
+  assert(result[0] == (void *) 100);
+  assert(pthread_join(batch[1], &result[1]) == 0);
+  assert(result[1] == (void *) 1);
+
+  /* Success. */
+  return 0;
+}
@@ -0,0 +1,213 @@
+/*
+ * File: lazyinit1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test first use of statically initialised mutexes, condition
+ * - variables, rwlocks and spinlocks by many threads at once: each
+ * - object is initialised exactly once and the losing copies are freed.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#define NTHREADS 4
+#define NOBJECTS 32
+
+static pthread_mutex_t mx[NOBJECTS];
+static pthread_mutex_t rmx[NOBJECTS];
+static pthread_cond_t cv[NOBJECTS];
+static pthread_rwlock_t rw[NOBJECTS];
+static pthread_spinlock_t sp[NOBJECTS];
+static pthread_barrier_t start;
+static int phase;
+
+static void * func(void * arg)
+{
+  struct timespec past = {0, 0};
+  int i;
+
+  for (i = 0; i < NOBJECTS; i++)
+    {
+      int result = pthread_barrier_wait(&start);
+
+      assert(result == 0 || result == PTHREAD_BARRIER_SERIAL_THREAD);
+
+      switch (phase)
+        {
+        case 0:
+          assert(pthread_mutex_lock(&mx[i]) == 0);
+          assert(pthread_mutex_unlock(&mx[i]) == 0);
+          assert(pthread_mutex_lock(&rmx[i]) == 0);
+          assert(pthread_mutex_lock(&rmx[i]) == 0);
+          assert(pthread_mutex_unlock(&rmx[i]) == 0);
+          assert(pthread_mutex_unlock(&rmx[i]) == 0);
+          break;
+        case 1:
+          assert(pthread_mutex_lock(&mx[i]) == 0);
+          assert(pthread_cond_timedwait(&cv[i], &mx[i], &past) == ETIMEDOUT);
+          assert(pthread_mutex_unlock(&mx[i]) == 0);
+          break;
+        case 2:
+          assert(pthread_rwlock_rdlock(&rw[i]) == 0);
+          assert(pthread_rwlock_unlock(&rw[i]) == 0);
+          break;
+        case 3:
+          assert(pthread_spin_lock(&sp[i]) == 0);
+          assert(pthread_spin_unlock(&sp[i]) == 0);
+          break;
+        }
+    }
+
+  return NULL;
+}
+
+static void runPhase(int p)
+{
+  pthread_t t[NTHREADS];
+  int i;
+
+  phase = p;
+
+  for (i = 0; i < NTHREADS; i++)
+    {
+      assert(pthread_create(&t[i], NULL, func, NULL) == 0);
+    }
+
+  for (i = 0; i < NTHREADS; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+}
+
+static void checkLive(int type, pte_alloc_stats_t * before, int expected)
+{
+  pte_alloc_stats_t after;
+
+  assert(pte_get_alloc_stats_np(type, &after) == 0);
+  assert((int) (after.objects - before->objects) == expected);
+}
+
+int pthread_test_lazyinit1()
+{
+  pte_alloc_stats_t before;
+  pthread_mutex_t unused = PTHREAD_MUTEX_INITIALIZER;
+  int i;
+
+  for (i = 0; i < NOBJECTS; i++)
+    {
+      mx[i] = PTHREAD_MUTEX_INITIALIZER;
+      rmx[i] = PTHREAD_RECURSIVE_MUTEX_INITIALIZER;
+      cv[i] = PTHREAD_COND_INITIALIZER;
+      rw[i] = PTHREAD_RWLOCK_INITIALIZER;
+      sp[i] = PTHREAD_SPINLOCK_INITIALIZER;
+    }
+
+  assert(pthread_barrier_init(&start, NULL, NTHREADS) == 0);
+
+  assert(pte_get_alloc_stats_np(PTE_ALLOC_MUTEX, &before) == 0);
+  runPhase(0);
+  checkLive(PTE_ALLOC_MUTEX, &before, 2 * NOBJECTS);
+
+  assert(pte_get_alloc_stats_np(PTE_ALLOC_COND, &before) == 0);
+  runPhase(1);
+  checkLive(PTE_ALLOC_COND, &before, NOBJECTS);
+
+  assert(pte_get_alloc_stats_np(PTE_ALLOC_RWLOCK, &before) == 0);
+  runPhase(2);
+  checkLive(PTE_ALLOC_RWLOCK, &before, NOBJECTS);
+
+  assert(pte_get_alloc_stats_np(PTE_ALLOC_SPIN, &before) == 0);
+  runPhase(3);
+  checkLive(PTE_ALLOC_SPIN, &before, NOBJECTS);
+
+  for (i = 0; i < NOBJECTS; i++)
+    {
+      assert(pthread_mutex_destroy(&mx[i]) == 0);
+      assert(pthread_mutex_destroy(&rmx[i]) == 0);
+      assert(pthread_cond_destroy(&cv[i]) == 0);
+      assert(pthread_rwlock_destroy(&rw[i]) == 0);
+      assert(pthread_spin_destroy(&sp[i]) == 0);
+    }
+
+  assert(pthread_barrier_destroy(&start) == 0);
+
+  /*
+   * A static object destroyed before first use
+   */
+  assert(pthread_mutex_destroy(&unused) == 0);
+  assert(unused == NULL);
+  assert(pthread_mutex_lock(&unused) == EINVAL);
+
+  return 0;
+}
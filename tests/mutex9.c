@@ -0,0 +1,360 @@
+/*
+ * File: mutex9.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test PTHREAD_PRIO_INHERIT and PTHREAD_PRIO_PROTECT mutexes.
+ * - Test that a boosted owner runs ahead of a thread whose priority
+ * - lies between its own and the waiter's.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * - The OS always runs the most urgent ready thread on a processor.
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+static pthread_mutex_t mutex;
+static sem_t locked;
+static sem_t go;
+static int lowPrio;
+static int midPrio;
+static int highPrio;
+static int boostedPrio;
+static int restoredPrio;
+static int heldPrio;
+static int afterPrio;
+static volatile int released;
+static char order[4];
+static int orderLen;
+
+static void * lowFunc(void * arg)
+{
+  assert(pthread_mutex_lock(&mutex) == 0);
+  assert(sem_post(&locked) == 0);
+  assert(sem_wait(&go) == 0);
+
+  boostedPrio = pte_osThreadGetPriority(pte_osThreadGetHandle());
+
+  assert(pthread_mutex_unlock(&mutex) == 0);
+
+  restoredPrio = pte_osThreadGetPriority(pte_osThreadGetHandle());
+
+  return (void *) 0;
+}
+
+static void * highFunc(void * arg)
+{
+  assert(pthread_mutex_lock(&mutex) == 0);
+  heldPrio = pte_osThreadGetPriority(pte_osThreadGetHandle());
+  assert(pthread_mutex_unlock(&mutex) == 0);
+  afterPrio = pte_osThreadGetPriority(pte_osThreadGetHandle());
+
+  return (void *) 0;
+}
+
+static void * spinOwnerFunc(void * arg)
+{
+  assert(pthread_mutex_lock(&mutex) == 0);
+  assert(sem_post(&locked) == 0);
+
+  /* Stay runnable, so that only priority decides who runs */
+  while (!released)
+    {
+    }
+
+  order[orderLen++] = 'L';
+  assert(pthread_mutex_unlock(&mutex) == 0);
+
+  return (void *) 0;
+}
+
+static void * blockedWaiterFunc(void * arg)
+{
+  assert(pthread_mutex_lock(&mutex) == 0);
+  order[orderLen++] = 'H';
+  assert(pthread_mutex_unlock(&mutex) == 0);
+
+  return (void *) 0;
+}
+
+static void * middleFunc(void * arg)
+{
+  order[orderLen++] = 'M';
+
+  return (void *) 0;
+}
+
+static void * timedFunc(void * arg)
+{
+  struct timespec abstime;
+  struct _timeb currSysTime;
+  const long long NANOSEC_PER_MILLISEC = 1000000;
+
+  _ftime(&currSysTime);
+
+  abstime.tv_sec = currSysTime.time;
+  abstime.tv_nsec = NANOSEC_PER_MILLISEC * currSysTime.millitm;
+  abstime.tv_nsec += 100 * NANOSEC_PER_MILLISEC;
+  if (abstime.tv_nsec >= 1000 * NANOSEC_PER_MILLISEC)
+    {
+      abstime.tv_sec++;
+      abstime.tv_nsec -= 1000 * NANOSEC_PER_MILLISEC;
+    }
+
+  assert(pthread_mutex_timedlock(&mutex, &abstime) == ETIMEDOUT);
+
+  return (void *) 0;
+}
+
+static void * aboveCeilingFunc(void * arg)
+{
+  assert(pthread_mutex_lock(&mutex) == EINVAL);
+  assert(pthread_mutex_trylock(&mutex) == EINVAL);
+
+  return (void *) 0;
+}
+
+static int createAt(pthread_t * t, int prio, void *(*func)(void *))
+{
+  pthread_attr_t attr;
+  struct sched_param param;
+  int result;
+
+  assert(pthread_attr_init(&attr) == 0);
+  assert(pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED) == 0);
+  param.sched_priority = prio;
+  assert(pthread_attr_setschedparam(&attr, &param) == 0);
+  assert(pthread_attr_setaffinity_np(&attr, 1) == 0);
+  result = pthread_create(t, &attr, func, NULL);
+  assert(pthread_attr_destroy(&attr) == 0);
+
+  return result;
+}
+
+int pthread_test_mutex9()
+{
+  pthread_t low, mid, high;
+  pthread_mutexattr_t ma;
+  struct sched_param mainParam;
+  struct sched_param param;
+  int mainPolicy;
+  unsigned int mainMask;
+  int cpus;
+  int minPrio = sched_get_priority_min(SCHED_OTHER);
+  int maxPrio = sched_get_priority_max(SCHED_OTHER);
+  int up;
+  int protocol;
+  int ceiling;
+
+  /*
+   * Which end of the range is more urgent depends on the OS:
+   * up is the step from a priority to the next more urgent one.
+   */
+  up = (pte_osThreadComparePriority(maxPrio, minPrio) > 0) ? 1 : -1;
+  lowPrio = (up > 0 ? minPrio : maxPrio) + up;
+  highPrio = (up > 0 ? maxPrio : minPrio) - up;
+  midPrio = (lowPrio + highPrio) / 2;
+  assert(pte_osThreadComparePriority(highPrio, midPrio) > 0);
+  assert(pte_osThreadComparePriority(midPrio, lowPrio) > 0);
+
+  /*
+   * Run every thread on one processor, with this one the most
+   * urgent, so that the order threads run in shows their priority.
+   */
+  assert((cpus = pthread_num_processors_np()) > 0);
+  assert(pthread_getschedparam(pthread_self(), &mainPolicy, &mainParam) == 0);
+  assert(pthread_getaffinity_np(pthread_self(), &mainMask) == 0);
+  param.sched_priority = highPrio + up;
+  assert(pthread_setschedparam(pthread_self(), SCHED_OTHER, &param) == 0);
+  assert(pthread_setaffinity_np(pthread_self(), 1) == 0);
+
+  assert(pthread_mutexattr_init(&ma) == 0);
+  assert(pthread_mutexattr_getprotocol(&ma, &protocol) == 0);
+  assert(protocol == PTHREAD_PRIO_NONE);
+  assert(pthread_mutexattr_setprotocol(&ma, 99) == EINVAL);
+  assert(pthread_mutexattr_setprioceiling(&ma, sched_get_priority_max(SCHED_OTHER) + 1) == EINVAL);
+
+  assert(sem_init(&locked, 0, 0) == 0);
+  assert(sem_init(&go, 0, 0) == 0);
+
+  /*
+   * Priority inheritance: the low priority owner runs at the
+   * priority of the high priority waiter until it unlocks.
+   */
+  assert(pthread_mutexattr_setprotocol(&ma, PTHREAD_PRIO_INHERIT) == 0);
+  assert(pthread_mutexattr_getprotocol(&ma, &protocol) == 0);
+  assert(protocol == PTHREAD_PRIO_INHERIT);
+  assert(pthread_mutex_init(&mutex, &ma) == 0);
+
+  assert(createAt(&low, lowPrio, lowFunc) == 0);
+  assert(sem_wait(&locked) == 0);
+  assert(createAt(&high, highPrio, highFunc) == 0);
+
+  /* Let the high priority thread block on the mutex */
+  pte_osThreadSleep(100);
+
+  assert(sem_post(&go) == 0);
+  assert(pthread_join(low, NULL) == 0);
+  assert(pthread_join(high, NULL) == 0);
+
+  assert(boostedPrio == highPrio);
+  assert(restoredPrio == lowPrio);
+
+  /* The thread handed the mutex is owed nothing by anyone */
+  assert(heldPrio == highPrio);
+  assert(afterPrio == highPrio);
+
+  /* Nor is a later owner that takes it uncontended */
+  assert(createAt(&low, lowPrio, lowFunc) == 0);
+  assert(sem_wait(&locked) == 0);
+  assert(sem_post(&go) == 0);
+  assert(pthread_join(low, NULL) == 0);
+
+  assert(boostedPrio == lowPrio);
+  assert(restoredPrio == lowPrio);
+
+  /* A waiter that times out takes back the boost it lent */
+  assert(createAt(&low, lowPrio, lowFunc) == 0);
+  assert(sem_wait(&locked) == 0);
+  assert(createAt(&high, highPrio, timedFunc) == 0);
+  assert(pthread_join(high, NULL) == 0);
+  assert(sem_post(&go) == 0);
+  assert(pthread_join(low, NULL) == 0);
+
+  assert(boostedPrio == lowPrio);
+  assert(restoredPrio == lowPrio);
+
+  /*
+   * The boost lets the owner run ahead of a thread between its own
+   * priority and the waiter's. The waiter then runs as soon as the
+   * owner unlocks, and the middle thread only after both. Without
+   * the boost the middle thread would run first.
+   */
+  released = 0;
+  orderLen = 0;
+  assert(createAt(&low, lowPrio, spinOwnerFunc) == 0);
+  assert(sem_wait(&locked) == 0);
+  assert(createAt(&high, highPrio, blockedWaiterFunc) == 0);
+
+  /* Let the high priority thread block on the mutex */
+  pte_osThreadSleep(100);
+  assert(orderLen == 0);
+
+  assert(createAt(&mid, midPrio, middleFunc) == 0);
+  released = 1;
+  assert(pthread_join(low, NULL) == 0);
+  assert(pthread_join(high, NULL) == 0);
+  assert(pthread_join(mid, NULL) == 0);
+
+  assert(orderLen == 3);
+  assert(order[0] == 'L');
+  assert(order[1] == 'H');
+  assert(order[2] == 'M');
+
+  assert(pthread_mutex_destroy(&mutex) == 0);
+
+  /* This thread would be above the ceiling used below */
+  if (mainMask == 0)
+    {
+      mainMask = (cpus < 32) ? (1u << cpus) - 1 : ~0u;
+    }
+  assert(pthread_setaffinity_np(pthread_self(), mainMask) == 0);
+  assert(pthread_setschedparam(pthread_self(), mainPolicy, &mainParam) == 0);
+
+  /*
+   * Priority ceiling: the owner runs at the ceiling, and threads
+   * above the ceiling may not lock.
+   */
+  ceiling = highPrio - up;
+  assert(pthread_mutexattr_setprotocol(&ma, PTHREAD_PRIO_PROTECT) == 0);
+  assert(pthread_mutexattr_setprioceiling(&ma, ceiling) == 0);
+  assert(pthread_mutexattr_getprioceiling(&ma, &ceiling) == 0);
+  assert(ceiling == highPrio - up);
+  assert(pthread_mutex_init(&mutex, &ma) == 0);
+
+  assert(createAt(&low, lowPrio, lowFunc) == 0);
+  assert(sem_wait(&locked) == 0);
+  assert(sem_post(&go) == 0);
+  assert(pthread_join(low, NULL) == 0);
+
+  assert(boostedPrio == ceiling);
+  assert(restoredPrio == lowPrio);
+
+  assert(createAt(&high, highPrio, aboveCeilingFunc) == 0);
+  assert(pthread_join(high, NULL) == 0);
+
+  assert(pthread_mutex_destroy(&mutex) == 0);
+  assert(pthread_mutexattr_destroy(&ma) == 0);
+  assert(sem_destroy(&locked) == 0);
+  assert(sem_destroy(&go) == 0);
+
+  return 0;
+}
@@ -0,0 +1,203 @@
+/*
+ * File: mutexstats1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test mutex contention statistics: acquisition, contention,
+ * - -   failure and hold accounting, the top-N report and reset.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#define HOLD_MSECS 50
+
+static pthread_mutex_t mx;
+static pthread_mutex_t smx = PTHREAD_MUTEX_INITIALIZER;
+static int locking;
+static int reported;
+static int seen;
+
+static void * trylocker(void * arg)
+{
+  assert(pthread_mutex_trylock(&mx) == EBUSY);
+  return NULL;
+}
+
+static void * locker(void * arg)
+{
+  (void) pte_osAtomicExchange(&locking, 1);
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  return NULL;
+}
+
+static void report(pthread_mutex_t m, const pte_mutex_stats_t * stats, void * arg)
+{
+  reported++;
+  if (m == mx)
+    {
+      seen = 1;
+      assert(stats->contended == 1);
+    }
+}
+
+int pthread_test_mutexstats1()
+{
+  pthread_t t;
+  pte_mutex_stats_t stats;
+  int i;
+
+  if (pte_mutex_stats_enable_np(1) == ENOTSUP)
+    {
+      /* Library built without PTE_MUTEX_STATS */
+      assert(pthread_mutex_getstats_np(&smx, &stats) == ENOTSUP);
+      assert(pthread_mutex_resetstats_np(&smx) == ENOTSUP);
+      assert(pte_mutex_stats_top_np(1, report, NULL) == ENOTSUP);
+      return 0;
+    }
+
+  assert(pthread_mutex_getstats_np(&smx, &stats) == 0);
+  assert(stats.acquisitions == 0);
+  assert(pte_mutex_stats_top_np(0, report, NULL) == EINVAL);
+
+  assert(pthread_mutex_init(&mx, NULL) == 0);
+
+  for (i = 0; i < 10; i++)
+    {
+      assert(pthread_mutex_lock(&mx) == 0);
+      assert(pthread_mutex_unlock(&mx) == 0);
+    }
+
+  assert(pthread_mutex_getstats_np(&mx, &stats) == 0);
+  assert(stats.acquisitions == 10);
+  assert(stats.contended == 0);
+  assert(stats.failures == 0);
+  assert(stats.waitTotal == 0);
+
+  /*
+   * A failed trylock
+   */
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_create(&t, NULL, trylocker, NULL) == 0);
+  assert(pthread_join(t, NULL) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+
+  assert(pthread_mutex_getstats_np(&mx, &stats) == 0);
+  assert(stats.acquisitions == 11);
+  assert(stats.failures == 1);
+
+  /*
+   * A contended lock, held for HOLD_MSECS
+   */
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_create(&t, NULL, locker, NULL) == 0);
+  while (pte_osAtomicCompareExchange(&locking, 0, 0) == 0)
+    {
+      sched_yield();
+    }
+  pte_osThreadSleep(HOLD_MSECS);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  assert(pthread_join(t, NULL) == 0);
+
+  assert(pthread_mutex_getstats_np(&mx, &stats) == 0);
+  assert(stats.acquisitions == 13);
+  assert(stats.contended == 1);
+  assert(stats.waitMax > 0);
+  assert(stats.waitTotal == stats.waitMax);
+  assert(stats.holdMax >= (HOLD_MSECS / 2) * 1000);
+  assert(stats.holdTotal >= stats.holdMax);
+
+  assert(pte_mutex_stats_top_np(1000, report, NULL) == 0);
+  assert(seen);
+  assert(reported >= 1);
+
+  assert(pthread_mutex_resetstats_np(&mx) == 0);
+  assert(pthread_mutex_getstats_np(&mx, &stats) == 0);
+  assert(stats.acquisitions == 0);
+  assert(stats.failures == 0);
+  assert(stats.holdTotal == 0);
+
+  /*
+   * Nothing is counted while disabled
+   */
+  assert(pte_mutex_stats_enable_np(0) == 0);
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  assert(pthread_mutex_getstats_np(&mx, &stats) == 0);
+  assert(stats.acquisitions == 0);
+
+  assert(pthread_mutex_destroy(&mx) == 0);
+
+  return 0;
+}
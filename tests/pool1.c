@@ -0,0 +1,243 @@
+/*
+ * File: pool1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test the thread pool: run many tasks, per task cancelability
+ * -   and tasks that exit or are cancelled.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#define NUMWORKERS 4
+#define NUMTASKS 1000
+
+static int count;
+static int cleanups;
+static int stateWasReset;
+static sem_t block;
+static int started;
+
+static void incr(void * arg)
+{
+  (void) pte_osAtomicIncrement(&count);
+}
+
+static void cleanup(void * arg)
+{
+  (void) pte_osAtomicIncrement(&cleanups);
+}
+
+static void exitTask(void * arg)
+{
+  pthread_cleanup_push(cleanup, NULL);
+  pthread_exit(NULL);
+  pthread_cleanup_pop(0);
+}
+
+static void cancelTask(void * arg)
+{
+  pthread_cleanup_push(cleanup, NULL);
+  assert(pthread_cancel(pthread_self()) == 0);
+  pthread_testcancel();
+  pthread_cleanup_pop(0);
+}
+
+static void disableTask(void * arg)
+{
+  int old;
+
+  assert(pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &old) == 0);
+  assert(old == PTHREAD_CANCEL_ENABLE);
+}
+
+static void checkTask(void * arg)
+{
+  int old;
+
+  assert(pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &old) == 0);
+  if (old == PTHREAD_CANCEL_ENABLE)
+    {
+      (void) pte_osAtomicIncrement(&stateWasReset);
+    }
+}
+
+static void blockTask(void * arg)
+{
+  (void) pte_osAtomicIncrement(&started);
+  assert(sem_wait(&block) == 0);
+}
+
+static void submit(pte_pool_t pool, void (*routine)(void *))
+{
+  int r;
+
+  while ((r = pte_pool_submit_np(pool, routine, NULL)) == EAGAIN)
+    {
+      sched_yield();
+    }
+
+  assert(r == 0);
+}
+
+int pthread_test_pool1()
+{
+  pte_pool_t pool;
+  pthread_attr_t attr;
+  int i;
+
+  count = 0;
+  cleanups = 0;
+  stateWasReset = 0;
+
+  assert(pte_pool_create_np(NULL, 1, 0, NULL) == EINVAL);
+
+  assert(pthread_attr_init(&attr) == 0);
+  assert(pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED) == 0);
+  assert(pte_pool_create_np(&pool, 1, 0, &attr) == EINVAL);
+  assert(pthread_attr_destroy(&attr) == 0);
+
+  assert(pte_pool_create_np(&pool, NUMWORKERS, 16, NULL) == 0);
+  assert(pte_pool_submit_np(pool, NULL, NULL) == EINVAL);
+
+  /* Nothing submitted yet */
+  assert(pte_pool_wait_np(pool) == 0);
+
+  for (i = 0; i < NUMTASKS; i++)
+    {
+      submit(pool, incr);
+    }
+
+  assert(pte_pool_wait_np(pool) == 0);
+  assert(count == NUMTASKS);
+
+  /* A full queue is reported, not waited on */
+  assert(sem_init(&block, 0, 0) == 0);
+  started = 0;
+
+  for (i = 0; i < NUMWORKERS; i++)
+    {
+      submit(pool, blockTask);
+    }
+
+  while (pte_osAtomicExchangeAdd(&started, 0) < NUMWORKERS)
+    {
+      sched_yield();
+    }
+
+  for (i = 0; i < 16; i++)
+    {
+      assert(pte_pool_submit_np(pool, incr, NULL) == 0);
+    }
+
+  assert(pte_pool_submit_np(pool, incr, NULL) == EAGAIN);
+
+  assert(sem_post_multiple(&block, NUMWORKERS) == 0);
+  assert(pte_pool_wait_np(pool) == 0);
+  assert(count == NUMTASKS + 16);
+  assert(sem_destroy(&block) == 0);
+
+  /*
+   * Tasks that exit or are cancelled end alone; their workers
+   * keep serving the queue.
+   */
+  for (i = 0; i < NUMWORKERS; i++)
+    {
+      submit(pool, exitTask);
+      submit(pool, cancelTask);
+    }
+
+  assert(pte_pool_wait_np(pool) == 0);
+  assert(cleanups == 2 * NUMWORKERS);
+
+  count = 0;
+
+  for (i = 0; i < NUMTASKS; i++)
+    {
+      submit(pool, incr);
+    }
+
+  /* Each task starts with cancelability enabled */
+  for (i = 0; i < NUMWORKERS * 4; i++)
+    {
+      submit(pool, disableTask);
+      submit(pool, checkTask);
+    }
+
+  assert(pte_pool_destroy_np(pool) == 0);
+  assert(count == NUMTASKS);
+  assert(stateWasReset == NUMWORKERS * 4);
+
+  return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * File: priority3.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test SCHED_FIFO and SCHED_RR scheduling policies.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+static void * func(void * arg)
+{
+  int policy;
+  struct sched_param param;
+
+  assert(pthread_getschedparam(pthread_self(), &policy, &param) == 0);
+
+  return (void *) policy;
+}
+
+int pthread_test_priority3()
+{
+  pthread_t t;
+  pthread_attr_t attr;
+  struct sched_param param;
+  void * result = NULL;
+  int policies[] = { SCHED_FIFO, SCHED_RR };
+  int policy;
+  int i;
+  int r;
+
+  assert(pthread_attr_init(&attr) == 0);
+  assert(pthread_attr_getschedpolicy(&attr, &policy) == 0);
+  assert(policy == SCHED_OTHER);
+  assert(pthread_attr_setschedpolicy(&attr, SCHED_MAX + 1) == EINVAL);
+
+  for (i = 0; i < (int) (sizeof(policies) / sizeof(policies[0])); i++)
+    {
+      assert(pthread_attr_setschedpolicy(&attr, policies[i]) == 0);
+      assert(pthread_attr_getschedpolicy(&attr, &policy) == 0);
+      assert(policy == policies[i]);
+
+      /* The OS may have no equivalent of the policy */
+      r = pthread_create(&t, &attr, func, NULL);
+      assert(r == 0 || r == ENOTSUP);
+
+      if (r == 0)
+        {
+          assert(pthread_join(t, &result) == 0);
+          assert((int) result == policies[i]);
+        }
+    }
+
+  assert(pthread_attr_destroy(&attr) == 0);
+
+  /* Changing the policy of a running thread */
+  assert(pthread_create(&t, NULL, func, NULL) == 0);
+  param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+  r = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+  assert(r == 0 || r == ENOTSUP);
+  if (r == 0)
+    {
+      assert(pthread_getschedparam(pthread_self(), &policy, &param) == 0);
+      assert(policy == SCHED_FIFO);
+      param.sched_priority = sched_get_priority_min(SCHED_OTHER);
+      assert(pthread_setschedparam(pthread_self(), SCHED_OTHER, &param) == 0);
+    }
+  assert(pthread_join(t, &result) == 0);
+
+  return 0;
+}
@@ -0,0 +1,243 @@
+/*
+ * File: semaphore7.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test sem_wait_any_np() taking exactly one unit, timing out, yielding
+ * - to sem_wait() callers and being cancelled.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#define NUMSEMS 3
+
+static sem_t s[NUMSEMS];
+static sem_t * sems[NUMSEMS] = { &s[0], &s[1], &s[2] };
+static volatile int gotWhich;
+static volatile int waitDone;
+
+static void
+deadline(struct timespec * abstime, int msecs)
+{
+  struct _timeb currSysTime;
+  const long long NANOSEC_PER_MILLISEC = 1000000;
+
+  _ftime(&currSysTime);
+
+  currSysTime.time += msecs / 1000;
+  currSysTime.millitm += msecs % 1000;
+  if (currSysTime.millitm >= 1000)
+    {
+      currSysTime.time++;
+      currSysTime.millitm -= 1000;
+    }
+
+  abstime->tv_sec = currSysTime.time;
+  abstime->tv_nsec = NANOSEC_PER_MILLISEC * currSysTime.millitm;
+}
+
+static void *
+anyWaiter(void * arg)
+{
+  int which = -1;
+
+  assert(sem_wait_any_np(sems, NUMSEMS, &which, NULL) == 0);
+  gotWhich = which;
+  waitDone = 1;
+
+  return NULL;
+}
+
+static void *
+plainWaiter(void * arg)
+{
+  assert(sem_wait(&s[0]) == 0);
+
+  return NULL;
+}
+
+static void
+checkValues(int v0, int v1, int v2)
+{
+  int value;
+
+  assert(sem_getvalue(&s[0], &value) == 0);
+  assert(value == v0);
+  assert(sem_getvalue(&s[1], &value) == 0);
+  assert(value == v1);
+  assert(sem_getvalue(&s[2], &value) == 0);
+  assert(value == v2);
+}
+
+int pthread_test_semaphore7(void)
+{
+  struct timespec abstime;
+  pthread_t t;
+  pthread_t p;
+  void * result;
+  int which;
+  int i;
+
+  for (i = 0; i < NUMSEMS; i++)
+    {
+      assert(sem_init(&s[i], PTHREAD_PROCESS_PRIVATE, 0) == 0);
+    }
+
+  assert(sem_wait_any_np(sems, 0, &which, NULL) == -1);
+  assert(errno == EINVAL);
+
+  /* Available units: only the first is taken */
+  assert(sem_post(&s[1]) == 0);
+  assert(sem_post(&s[2]) == 0);
+  assert(sem_wait_any_np(sems, NUMSEMS, &which, NULL) == 0);
+  assert(which == 1);
+  checkValues(0, 0, 1);
+  assert(sem_wait_any_np(sems, NUMSEMS, &which, NULL) == 0);
+  assert(which == 2);
+  checkValues(0, 0, 0);
+
+  /* Nothing posted */
+  deadline(&abstime, 100);
+  assert(sem_wait_any_np(sems, NUMSEMS, &which, &abstime) == -1);
+  assert(errno == ETIMEDOUT);
+  checkValues(0, 0, 0);
+
+  /* Woken by a post */
+  waitDone = 0;
+  assert(pthread_create(&t, NULL, anyWaiter, NULL) == 0);
+  pte_osThreadSleep(100);
+  assert(waitDone == 0);
+  assert(sem_post(&s[2]) == 0);
+  assert(pthread_join(t, NULL) == 0);
+  assert(gotWhich == 2);
+  checkValues(0, 0, 0);
+
+  /* A sem_wait() caller gets a unit first */
+  waitDone = 0;
+  assert(pthread_create(&p, NULL, plainWaiter, NULL) == 0);
+  pte_osThreadSleep(100);
+  assert(pthread_create(&t, NULL, anyWaiter, NULL) == 0);
+  pte_osThreadSleep(100);
+  assert(sem_post(&s[0]) == 0);
+  assert(pthread_join(p, NULL) == 0);
+  pte_osThreadSleep(100);
+  assert(waitDone == 0);
+  assert(sem_post(&s[1]) == 0);
+  assert(pthread_join(t, NULL) == 0);
+  assert(gotWhich == 1);
+  checkValues(0, 0, 0);
+
+  /* A canceled waiter leaves the semaphores as they were */
+  waitDone = 0;
+  assert(pthread_create(&t, NULL, anyWaiter, NULL) == 0);
+  pte_osThreadSleep(100);
+  assert(pthread_cancel(t) == 0);
+  assert(pthread_join(t, &result) == 0);
+  assert(result == PTHREAD_CANCELED);
+  assert(waitDone == 0);
+
+  for (i = 0; i < NUMSEMS; i++)
+    {
+      assert(sem_post(&s[i]) == 0);
+    }
+  checkValues(1, 1, 1);
+
+  /* A semaphore can't be destroyed while a waiter is on it */
+  for (i = 0; i < NUMSEMS; i++)
+    {
+      assert(sem_wait(&s[i]) == 0);
+    }
+  waitDone = 0;
+  assert(pthread_create(&t, NULL, anyWaiter, NULL) == 0);
+  pte_osThreadSleep(100);
+  assert(sem_destroy(&s[1]) == -1);
+  assert(errno == EBUSY);
+  assert(sem_post(&s[1]) == 0);
+  assert(pthread_join(t, NULL) == 0);
+  assert(gotWhich == 1);
+  checkValues(0, 0, 0);
+
+  for (i = 0; i < NUMSEMS; i++)
+    {
+      assert(sem_post(&s[i]) == 0);
+    }
+
+  for (i = 0; i < NUMSEMS; i++)
+    {
+      assert(sem_destroy(&s[i]) == 0);
+    }
+
+  /* Success. */
+  return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * File: semaphore8.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test that a sem_post() with no waiter leaves no stale wakeup behind
+ * - for a later sem_timedwait().
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+int pthread_test_semaphore8(void)
+{
+  sem_t s;
+  struct timespec abstime =
+    {
+      0, 0
+    };
+  struct _timeb currSysTime;
+  const long long NANOSEC_PER_MILLISEC = 1000000;
+  int value;
+
+  assert(sem_init(&s, PTHREAD_PROCESS_PRIVATE, 0) == 0);
+
+  /* Nobody is waiting, so the post only raises the value */
+  assert(sem_post(&s) == 0);
+  assert(sem_getvalue(&s, &value) == 0);
+  assert(value == 1);
+
+  assert(sem_trywait(&s) == 0);
+  assert(sem_getvalue(&s, &value) == 0);
+  assert(value == 0);
+
+  /* The unit has been taken: the next wait must block */
+  _ftime(&currSysTime);
+
+  abstime.tv_sec = currSysTime.time;
+  abstime.tv_nsec = NANOSEC_PER_MILLISEC * currSysTime.millitm;
+  abstime.tv_nsec += 100 * NANOSEC_PER_MILLISEC;
+  if (abstime.tv_nsec >= 1000 * NANOSEC_PER_MILLISEC)
+    {
+      abstime.tv_sec++;
+      abstime.tv_nsec -= 1000 * NANOSEC_PER_MILLISEC;
+    }
+
+  assert(sem_timedwait(&s, &abstime) == -1);
+  assert(errno == ETIMEDOUT);
+
+  assert(sem_getvalue(&s, &value) == 0);
+  assert(value == 0);
+
+  assert(sem_destroy(&s) == 0);
+
+  return 0;
+}
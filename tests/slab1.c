@@ -0,0 +1,253 @@
+/*
+ * File: slab1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test the sync object slab caches: alignment, slot reuse, objects
+ * - freed by a thread other than the one that created them,
+ * - concurrent init/destroy, and slots freed by an implicit thread
+ * - that exits without the library knowing.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#include "../implement.h"
+
+#define NOBJECTS 200
+#define NTHREADS 4
+#define NLOOPS 2000
+
+static pthread_mutex_t mx[NOBJECTS];
+static sem_t sems[NOBJECTS];
+
+static void * reuseFunc(void * arg)
+{
+  pthread_mutex_t m;
+  void * first;
+
+  assert(pthread_mutex_init(&m, NULL) == 0);
+  first = (void *) m;
+  assert(pthread_mutex_destroy(&m) == 0);
+  assert(pthread_mutex_init(&m, NULL) == 0);
+  assert((void *) m == first);
+  assert(pthread_mutex_destroy(&m) == 0);
+
+  return NULL;
+}
+
+static void * semInitFunc(void * arg)
+{
+  int i;
+
+  for (i = 0; i < NOBJECTS; i++)
+    {
+      assert(sem_init(&sems[i], 0, 1) == 0);
+    }
+
+  return NULL;
+}
+
+static void * semDestroyFunc(void * arg)
+{
+  int i;
+
+  for (i = 0; i < NOBJECTS; i++)
+    {
+      assert(sem_wait(&sems[i]) == 0);
+      assert(sem_destroy(&sems[i]) == 0);
+    }
+
+  return NULL;
+}
+
+static int implicitFunc(void * arg)
+{
+  pthread_mutex_t m;
+
+  /*
+   * pthread_self() gives this OS thread an implicit handle, and it
+   * exits without detaching
+   */
+  assert(pthread_self() != NULL);
+  assert(pthread_mutex_init(&m, NULL) == 0);
+  *(void **) arg = (void *) m;
+  assert(pthread_mutex_destroy(&m) == 0);
+
+  return 0;
+}
+
+static void * churnFunc(void * arg)
+{
+  pthread_mutex_t m;
+  pthread_cond_t cv;
+  int i;
+
+  for (i = 0; i < NLOOPS; i++)
+    {
+      assert(pthread_mutex_init(&m, NULL) == 0);
+      assert(pthread_cond_init(&cv, NULL) == 0);
+      assert(pthread_mutex_lock(&m) == 0);
+      assert(pthread_cond_signal(&cv) == 0);
+      assert(pthread_mutex_unlock(&m) == 0);
+      assert(pthread_cond_destroy(&cv) == 0);
+      assert(pthread_mutex_destroy(&m) == 0);
+    }
+
+  return NULL;
+}
+
+int pthread_test_slab1()
+{
+  pte_alloc_stats_t before, after;
+  pthread_t t[NTHREADS];
+  pte_osThreadHandle osThread;
+  void * slot = NULL;
+  int i, j;
+
+  assert(pte_get_alloc_stats_np(PTE_ALLOC_MUTEX, &before) == 0);
+
+  /*
+   * More mutexes than fit in one chunk, all distinct and aligned
+   */
+  for (i = 0; i < NOBJECTS; i++)
+    {
+      assert(pthread_mutex_init(&mx[i], NULL) == 0);
+      assert(((size_t) mx[i] & (PTE_SLAB_ALIGN - 1)) == 0);
+
+      for (j = 0; j < i; j++)
+        {
+          assert(mx[i] != mx[j]);
+        }
+    }
+
+  for (i = 0; i < NOBJECTS; i++)
+    {
+      assert(pthread_mutex_lock(&mx[i]) == 0);
+      assert(pthread_mutex_unlock(&mx[i]) == 0);
+      assert(pthread_mutex_destroy(&mx[i]) == 0);
+    }
+
+  assert(pte_get_alloc_stats_np(PTE_ALLOC_MUTEX, &after) == 0);
+  assert(after.objects == before.objects);
+  assert(after.allocs == before.allocs + NOBJECTS);
+
+  assert(pte_get_alloc_stats_np(PTE_ALLOC_SLAB, &after) == 0);
+  assert(after.objects > 0);
+
+  /*
+   * A freed slot is reused by the thread that freed it
+   */
+  assert(pthread_create(&t[0], NULL, reuseFunc, NULL) == 0);
+  assert(pthread_join(t[0], NULL) == 0);
+
+  /*
+   * Objects created by one thread and destroyed by another
+   */
+  assert(pthread_create(&t[0], NULL, semInitFunc, NULL) == 0);
+  assert(pthread_join(t[0], NULL) == 0);
+  assert(pthread_create(&t[0], NULL, semDestroyFunc, NULL) == 0);
+  assert(pthread_join(t[0], NULL) == 0);
+
+  /*
+   * Concurrent init and destroy
+   */
+  for (i = 0; i < NTHREADS; i++)
+    {
+      assert(pthread_create(&t[i], NULL, churnFunc, NULL) == 0);
+    }
+
+  for (i = 0; i < NTHREADS; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+
+  assert(pte_get_alloc_stats_np(PTE_ALLOC_MUTEX, &after) == 0);
+  assert(after.objects == before.objects);
+
+  /*
+   * An implicit thread keeps no magazine, so the slot it freed is
+   * back on the shared free list rather than lost with the thread
+   */
+  assert(pte_osThreadCreate(implicitFunc, PTHREAD_STACK_MIN, pte_osThreadGetDefaultPriority(),
+                            (void *) &slot, &osThread) == PTE_OS_OK);
+  assert(pte_osThreadStart(osThread) == PTE_OS_OK);
+  assert(pte_osThreadWaitForEnd(osThread) == PTE_OS_OK);
+  pte_osThreadDelete(osThread);
+
+  assert(pthread_mutex_init(&mx[0], NULL) == 0);
+  assert((void *) mx[0] == slot);
+  assert(pthread_mutex_destroy(&mx[0]) == 0);
+
+  return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * File: spin5.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test ticket spinlocks: error returns, mutual exclusion, and that
+ * - waiters get the lock in the order they arrived.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#include "../implement.h"
+
+#define NTHREADS 4
+#define NLOOPS 10000
+
+static pthread_spinlock_t lock;
+static int shared;
+static int order[2];
+static int served;
+
+static void * countFunc(void * arg)
+{
+  int i;
+
+  for (i = 0; i < NLOOPS; i++)
+    {
+      assert(pthread_spin_lock(&lock) == 0);
+      shared++;
+      assert(pthread_spin_unlock(&lock) == 0);
+    }
+
+  return NULL;
+}
+
+static void * orderFunc(void * arg)
+{
+  assert(pthread_spin_lock(&lock) == 0);
+  order[served++] = (int) (size_t) arg;
+  assert(pthread_spin_unlock(&lock) == 0);
+
+  return NULL;
+}
+
+static void waitForTicket(int next)
+{
+  while (*(volatile int *) &lock->ticketNext != next)
+    {
+      pte_osThreadSleep(1);
+    }
+}
+
+int pthread_test_spin5()
+{
+  pthread_t t[NTHREADS];
+  int i;
+
+  assert(pthread_spin_init_np(&lock, PTHREAD_PROCESS_PRIVATE, -1) == EINVAL);
+  assert(pthread_spin_init_np(NULL, PTHREAD_PROCESS_PRIVATE,
+                              PTHREAD_SPIN_TICKET_NP) == EINVAL);
+  assert(pthread_spin_init_np(&lock, PTHREAD_PROCESS_PRIVATE,
+                              PTHREAD_SPIN_TICKET_NP) == 0);
+
+  assert(pthread_spin_unlock(&lock) == EPERM);
+  assert(pthread_spin_trylock(&lock) == 0);
+  assert(pthread_spin_trylock(&lock) == EBUSY);
+  assert(pthread_spin_destroy(&lock) == EINVAL);
+  assert(pthread_spin_unlock(&lock) == 0);
+
+  /*
+   * Mutual exclusion
+   */
+  shared = 0;
+  for (i = 0; i < NTHREADS; i++)
+    {
+      assert(pthread_create(&t[i], NULL, countFunc, NULL) == 0);
+    }
+  for (i = 0; i < NTHREADS; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+  assert(shared == NTHREADS * NLOOPS);
+
+  /*
+   * FIFO order. Only meaningful where the lock is a real ticket
+   * lock rather than a mutex (a single cpu).
+   */
+  if (lock->interlock == PTE_SPIN_USE_TICKET)
+    {
+      served = 0;
+      assert(pthread_spin_lock(&lock) == 0);
+      assert(pthread_create(&t[0], NULL, orderFunc, (void *) 1) == 0);
+      waitForTicket(lock->ticketServing + 2);
+      assert(pthread_create(&t[1], NULL, orderFunc, (void *) 2) == 0);
+      waitForTicket(lock->ticketServing + 3);
+      assert(pthread_spin_unlock(&lock) == 0);
+      assert(pthread_join(t[0], NULL) == 0);
+      assert(pthread_join(t[1], NULL) == 0);
+      assert(order[0] == 1 && order[1] == 2);
+    }
+
+  assert(pthread_spin_destroy(&lock) == 0);
+
+  return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * File: stack1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test caller supplied stacks and the thread stack pool.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#define STACK_SIZE 0x10000
+
+static char stack[STACK_SIZE] __attribute__((aligned(16)));
+static sem_t done;
+static char * volatile localAddr;
+
+static void * func(void * arg)
+{
+  char local;
+
+  localAddr = &local;
+
+  return (void *) 0;
+}
+
+static void * detachedFunc(void * arg)
+{
+  assert(sem_post(&done) == 0);
+
+  return (void *) 0;
+}
+
+int pthread_test_stack1()
+{
+  pthread_t t;
+  pthread_attr_t attr;
+  void * addr;
+  size_t size;
+  void * result = NULL;
+  int r;
+  int i;
+
+  assert(pthread_attr_init(&attr) == 0);
+  assert(pthread_attr_getstack(&attr, &addr, &size) == 0);
+  assert(addr == NULL);
+
+  assert(pthread_attr_setstack(&attr, NULL, STACK_SIZE) == EINVAL);
+#if PTHREAD_STACK_MIN > 0
+  assert(pthread_attr_setstack(&attr, stack, PTHREAD_STACK_MIN - 1) == EINVAL);
+#endif
+
+  assert(pthread_attr_setstack(&attr, stack, STACK_SIZE) == 0);
+  assert(pthread_attr_getstack(&attr, &addr, &size) == 0);
+  assert(addr == (void *) stack);
+  assert(size == STACK_SIZE);
+
+  /* The OS may not be able to run threads on our stack */
+  r = pthread_create(&t, &attr, func, NULL);
+  assert(r == 0 || r == ENOTSUP);
+
+  if (r == 0)
+    {
+      assert(pthread_join(t, &result) == 0);
+      assert(localAddr >= stack && localAddr < stack + STACK_SIZE);
+    }
+
+  assert(pthread_attr_destroy(&attr) == 0);
+
+  /* Stack pool */
+  assert(pthread_setstackpool_np(-1, 0) == EINVAL);
+  assert(pthread_setstackpool_np(4, 4096) == 0);
+  assert(sem_init(&done, 0, 0) == 0);
+
+  for (i = 0; i < 10; i++)
+    {
+      assert(pthread_create(&t, NULL, func, NULL) == 0);
+      assert(pthread_join(t, &result) == 0);
+
+      assert(pthread_create(&t, NULL, detachedFunc, NULL) == 0);
+      assert(pthread_detach(t) == 0);
+      assert(sem_wait(&done) == 0);
+    }
+
+  assert(pthread_setstackpool_np(0, 0) == 0);
+  assert(sem_destroy(&done) == 0);
+
+  return 0;
+}
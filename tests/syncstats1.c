@@ -0,0 +1,253 @@
+/*
+ * File: syncstats1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test the sync object registry: registration, tags, internal
+ * - -   objects, wait recording, the report and the reporter thread.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#include <string.h>
+
+#include "../implement.h"
+
+#ifdef PTE_SYNC_REGISTRY
+
+#define HOLD_MSECS 20
+
+static pthread_mutex_t mx;
+static pthread_mutex_t smx = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cv;
+static int waiting;
+static int signalled;
+
+static void * locker(void * arg)
+{
+  (void) pte_osAtomicExchange(&waiting, 1);
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  return NULL;
+}
+
+static void * condwaiter(void * arg)
+{
+  assert(pthread_mutex_lock(&mx) == 0);
+  (void) pte_osAtomicExchange(&waiting, 1);
+  while (!signalled)
+    {
+      assert(pthread_cond_wait(&cv, &mx) == 0);
+    }
+  assert(pthread_mutex_unlock(&mx) == 0);
+  return NULL;
+}
+
+static int histTotal(pte_sync_entry_t * e)
+{
+  int b, total = 0;
+
+  for (b = 0; b < PTE_SYNC_HIST_BUCKETS; b++)
+    {
+      total += e->hist[b];
+    }
+  return total;
+}
+
+static int reportHas(FILE * f, const char * text)
+{
+  char line[256];
+  int found = 0;
+
+  rewind(f);
+  while (fgets(line, sizeof(line), f) != NULL)
+    {
+      if (strstr(line, text) != NULL)
+        {
+          found = 1;
+        }
+    }
+  return found;
+}
+
+#endif
+
+int pthread_test_syncstats1()
+{
+#ifdef PTE_SYNC_REGISTRY
+  pthread_t t;
+  pte_sync_entry_t * e;
+  pte_sync_entry_t * ce;
+  FILE * f;
+  int i;
+
+  assert(pthread_mutex_init(&mx, NULL) == 0);
+  e = mx->syncEntry;
+  assert(e != NULL);
+  assert(e->state == PTE_SYNC_LIVE);
+  assert(e->type == PTE_SYNC_MUTEX);
+  assert(e->tag == NULL);
+
+  assert(pte_sync_settag_np(mx, "syncstats1 mx") == 0);
+  assert(strcmp(e->tag, "syncstats1 mx") == 0);
+  assert(pte_sync_settag_np(NULL, "x") == EINVAL);
+  assert(pte_sync_settag_np(&i, "x") == ESRCH);
+
+  /*
+   * A contended lock
+   */
+  waiting = 0;
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_create(&t, NULL, locker, NULL) == 0);
+  while (pte_osAtomicCompareExchange(&waiting, 0, 0) == 0)
+    {
+      sched_yield();
+    }
+  pte_osThreadSleep(HOLD_MSECS);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  assert(pthread_join(t, NULL) == 0);
+
+  assert(e->waits == 1);
+  assert(histTotal(e) == 1);
+  assert(e->waitMax >= (HOLD_MSECS / 2) * 1000);
+
+  /*
+   * A condition variable's semaphores and mutex are internal and
+   * count their waits against it.
+   */
+  assert(pthread_cond_init(&cv, NULL) == 0);
+  ce = cv->syncEntry;
+  assert(ce != NULL && ce->type == PTE_SYNC_COND);
+  assert(cv->semBlockQueue->syncEntry->state == PTE_SYNC_INTERNAL);
+  assert(cv->semBlockQueue->syncEntry->owner == ce);
+  assert(cv->mtxUnblockLock->syncEntry->owner == ce);
+
+  waiting = 0;
+  signalled = 0;
+  assert(pthread_create(&t, NULL, condwaiter, NULL) == 0);
+  while (pte_osAtomicCompareExchange(&waiting, 0, 0) == 0)
+    {
+      sched_yield();
+    }
+  assert(pthread_mutex_lock(&mx) == 0);
+  signalled = 1;
+  assert(pthread_cond_signal(&cv) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  assert(pthread_join(t, NULL) == 0);
+
+  assert(ce->waits >= 1);
+  assert(cv->semBlockQueue->syncEntry->waits == 0);
+
+  /*
+   * Statically initialised objects are tagged with their initializer
+   */
+  assert(pthread_mutex_lock(&smx) == 0);
+  assert(pthread_mutex_unlock(&smx) == 0);
+  assert(strcmp(smx->syncEntry->tag, "PTHREAD_MUTEX_INITIALIZER") == 0);
+
+  /*
+   * The report, and the reporter thread
+   */
+  assert(pte_dump_sync_stats_np(NULL) == EINVAL);
+  assert(pte_sync_reporter_np(NULL, 10) == EINVAL);
+
+  if ((f = tmpfile()) != NULL)
+    {
+      assert(pte_dump_sync_stats_np(f) == 0);
+      assert(reportHas(f, "syncstats1 mx"));
+      fclose(f);
+    }
+
+  if ((f = tmpfile()) != NULL)
+    {
+      assert(pte_sync_reporter_np(f, 10) == 0);
+      pte_osThreadSleep(100);
+      assert(pte_sync_reporter_np(NULL, 0) == 0);
+      assert(reportHas(f, "objects registered"));
+      fclose(f);
+    }
+
+  assert(pthread_cond_destroy(&cv) == 0);
+  assert(ce->state == PTE_SYNC_FREE);
+  assert(pthread_mutex_destroy(&mx) == 0);
+  assert(e->state == PTE_SYNC_FREE);
+#else
+  /* Library built without PTE_SYNC_REGISTRY */
+  assert(pte_sync_settag_np(stdout, "x") == ENOTSUP);
+  assert(pte_dump_sync_stats_np(stdout) == ENOTSUP);
+  assert(pte_sync_reporter_np(stdout, 10) == ENOTSUP);
+#endif
+
+  return 0;
+}
@@ -0,0 +1,257 @@
+/*
+ * File: task1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test the work-stealing task scheduler: fork/join results, task
+ * -   exit and cleanup handlers, and cancelling a syncing thread.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#define FIB_N 18
+#define FIB_RESULT 2584
+
+typedef struct
+{
+  int n;
+  int result;
+} fibArg;
+
+static int outerCleanups;
+static int innerCleanups;
+static int finished;
+static volatile int release;
+static int syncCancelled;
+static struct timespec oneMs = { 0, 1000000 };
+static struct timespec fiftyMs = { 0, 50000000 };
+
+static void fib(void * arg)
+{
+  fibArg * f = (fibArg *) arg;
+  fibArg a, b;
+  pte_task_t t;
+
+  if (f->n < 2)
+    {
+      f->result = f->n;
+      return;
+    }
+
+  a.n = f->n - 1;
+  b.n = f->n - 2;
+
+  assert(pte_task_spawn_np(&t, fib, &a) == 0);
+  fib(&b);
+  assert(pte_task_sync_np(t) == 0);
+
+  f->result = a.result + b.result;
+}
+
+static void outerCleanup(void * arg)
+{
+  (void) pte_osAtomicIncrement(&outerCleanups);
+}
+
+static void innerCleanup(void * arg)
+{
+  (void) pte_osAtomicIncrement(&innerCleanups);
+}
+
+static void exitTask(void * arg)
+{
+  pthread_cleanup_push(innerCleanup, NULL);
+  pthread_exit(NULL);
+  pthread_cleanup_pop(0);
+}
+
+static void parentTask(void * arg)
+{
+  pte_task_t t;
+  int state;
+
+  /* Cancelability is off inside tasks */
+  assert(pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state) == 0);
+  assert(state == PTHREAD_CANCEL_DISABLE);
+
+  pthread_cleanup_push(outerCleanup, NULL);
+
+  /* The child may well run right here, inside the sync */
+  assert(pte_task_spawn_np(&t, exitTask, NULL) == 0);
+  assert(pte_task_sync_np(t) == 0);
+
+  pthread_cleanup_pop(0);
+
+  (void) pte_osAtomicIncrement(&finished);
+}
+
+static void slowTask(void * arg)
+{
+  while (!release)
+    {
+      pthread_delay_np(&oneMs);
+    }
+
+  (void) pte_osAtomicIncrement(&finished);
+}
+
+static void syncCleanup(void * arg)
+{
+  syncCancelled = 1;
+}
+
+static void * syncer(void * arg)
+{
+  pte_task_t t;
+
+  assert(pte_task_spawn_np(&t, slowTask, NULL) == 0);
+
+  pthread_cleanup_push(syncCleanup, NULL);
+  (void) pte_task_sync_np(t);
+  pthread_cleanup_pop(0);
+
+  return (void *) 0;
+}
+
+int pthread_test_task1()
+{
+  pte_task_t tasks[8];
+  fibArg f;
+  pthread_t t;
+  void * result = NULL;
+  int workers;
+  int i;
+
+  outerCleanups = 0;
+  innerCleanups = 0;
+  finished = 0;
+  release = 0;
+  syncCancelled = 0;
+
+  assert(pte_task_spawn_np(NULL, fib, &f) == EINVAL);
+  assert(pte_task_sync_np(NULL) == EINVAL);
+
+  for (workers = 1; workers <= 3; workers++)
+    {
+      assert(pte_task_init_np(workers) == 0);
+      assert(pte_task_init_np(workers) == EBUSY);
+
+      f.n = FIB_N;
+      f.result = 0;
+      assert(pte_task_spawn_np(&tasks[0], fib, &f) == 0);
+      assert(pte_task_sync_np(tasks[0]) == 0);
+      assert(f.result == FIB_RESULT);
+
+      assert(pte_task_shutdown_np() == 0);
+      assert(pte_task_shutdown_np() == EINVAL);
+    }
+
+  /* Started on demand from here on */
+  for (i = 0; i < 8; i++)
+    {
+      assert(pte_task_spawn_np(&tasks[i], parentTask, NULL) == 0);
+    }
+
+  for (i = 0; i < 8; i++)
+    {
+      assert(pte_task_sync_np(tasks[i]) == 0);
+    }
+
+  assert(finished == 8);
+  assert(innerCleanups == 8);
+  assert(outerCleanups == 0);
+
+  /*
+   * Cancelling a thread blocked in pte_task_sync_np() runs its
+   * cleanup handlers; the task itself still runs to completion.
+   */
+  finished = 0;
+  assert(pthread_create(&t, NULL, syncer, NULL) == 0);
+  pthread_delay_np(&fiftyMs);
+  assert(pthread_cancel(t) == 0);
+  assert(pthread_join(t, &result) == 0);
+  assert(result == PTHREAD_CANCELED);
+  assert(syncCancelled == 1);
+
+  release = 1;
+
+  while (pte_osAtomicExchangeAdd(&finished, 0) == 0)
+    {
+      pthread_delay_np(&oneMs);
+    }
+
+  assert(pte_task_shutdown_np() == 0);
+
+  return 0;
+}
@@ -52,6 +52,7 @@
 #include <pthread.h>
 #include <sys/sched.h>
 #include <semaphore.h>
+#include "pthread_np.h"
 
 //#include <windows.h>
 
@@ -145,6 +146,7 @@ int pthread_test_mutex8();
 int pthread_test_mutex8e();
 int pthread_test_mutex8n();
 int pthread_test_mutex8r();
+int pthread_test_mutex9();
 
 int pthread_test_valid1();
 int pthread_test_valid2();
@@ -165,6 +167,8 @@ int pthread_test_semaphore4();
 int pthread_test_semaphore4t();
 int pthread_test_semaphore5();
 int pthread_test_semaphore6();
+int pthread_test_semaphore7();
+int pthread_test_semaphore8();
 
 int pthread_test_barrier1();
 int pthread_test_barrier2();
@@ -188,6 +192,9 @@ int pthread_test_join1();
 int pthread_test_join2();
 int pthread_test_join3();
 int pthread_test_join4();
+int pthread_test_join5();
+int pthread_test_join6();
+int pthread_test_join7();
 
 int pthread_test_kill1();
 
@@ -250,6 +257,21 @@ int pthread_test_rwlock8();
 
 int pthread_test_priority1();
 int pthread_test_priority2();
+int pthread_test_priority3();
+
+int pthread_test_affinity1();
+int pthread_test_stack1();
+int pthread_test_pool1();
+int pthread_test_task1();
+int pthread_test_mutexstats1();
+int pthread_test_syncstats1();
+int pthread_test_trace1();
+int pthread_test_alloc1();
+int pthread_test_slab1();
+int pthread_test_inlinelock1();
+int pthread_test_lazyinit1();
+int pthread_test_spin5();
+int pthread_test_atomic1();
 
 int pthread_test_inherit1();
 
@@ -260,6 +282,8 @@ int pthread_test_cancel4();
 int pthread_test_cancel5();
 int pthread_test_cancel6a();
 int pthread_test_cancel6d();
+int pthread_test_cancel10();
+int pthread_test_cancel11();
 int pthread_test_cancel7();
 int pthread_test_cancel8();
 int pthread_test_cancel9();
@@ -273,6 +297,10 @@ int pthread_test_bench1();
 int pthread_test_bench2();
 int pthread_test_bench3();
 int pthread_test_bench4();
+int pthread_test_bench6();
+int pthread_test_bench7();
+int pthread_test_bench8();
+int pthread_test_bench9();
 
 int pthread_test_exception1();
 int pthread_test_exception2();
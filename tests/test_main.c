@@ -51,6 +51,12 @@ static void runSemTests(void)
   printf("Semaphore test #6\n");
   pthread_test_semaphore6();
 
+  printf("Semaphore test #7\n");
+  pthread_test_semaphore7();
+
+  printf("Semaphore test #8\n");
+  pthread_test_semaphore8();
+
 }
 
 static void runThreadTests(void)
@@ -80,6 +86,15 @@ static void runThreadTests(void)
   printf("Join test #4\n");
   pthread_test_join4();
 
+  printf("Join test #5\n");
+  pthread_test_join5();
+
+  printf("Join test #6\n");
+  pthread_test_join6();
+
+  printf("Join test #7\n");
+  pthread_test_join7();
+
   printf("Kill test #1\n");
   pthread_test_kill1();
 
@@ -115,6 +130,48 @@ static void runThreadTests(void)
   printf("Priority test #2\n");
   pthread_test_priority2();
 
+  printf("Priority test #3\n");
+  pthread_test_priority3();
+
+  printf("Affinity test #1\n");
+  pthread_test_affinity1();
+
+  printf("Stack test #1\n");
+  pthread_test_stack1();
+
+  printf("Pool test #1\n");
+  pthread_test_pool1();
+
+  printf("Task test #1\n");
+  pthread_test_task1();
+
+  printf("Mutex stats test #1\n");
+  pthread_test_mutexstats1();
+
+  printf("Sync stats test #1\n");
+  pthread_test_syncstats1();
+
+  printf("Trace test #1\n");
+  pthread_test_trace1();
+
+  printf("Alloc test #1\n");
+  pthread_test_alloc1();
+
+  printf("Slab test #1\n");
+  pthread_test_slab1();
+
+  printf("Inline lock test #1\n");
+  pthread_test_inlinelock1();
+
+  printf("Lazy init test #1\n");
+  pthread_test_lazyinit1();
+
+  printf("Spin test #5\n");
+  pthread_test_spin5();
+
+  printf("Atomic test #1\n");
+  pthread_test_atomic1();
+
 //  printf("Inherit test #1\n");
 //  pthread_test_inherit1();  ///@todo
 
@@ -259,6 +316,9 @@ static void runMutexTests(void)
   printf("Mutex test #8r\n");
   pthread_test_mutex8r();
 
+  printf("Mutex test #9\n");
+  pthread_test_mutex9();
+
 }
 
 static void runSpinTests()
@@ -403,6 +463,12 @@ static void runCancelTests()
   printf("Cancel test #6d\n");
   pthread_test_cancel6d();
 
+  printf("Cancel test #10\n");
+  pthread_test_cancel10();
+
+  printf("Cancel test #11\n");
+  pthread_test_cancel11();
+
   /* Cleanup only occurs for async cancellation.
    * If we don't support this, can't test it...
    */
@@ -433,6 +499,18 @@ static void runBenchTests()
 
   printf("Benchmark test #4\n");
   pthread_test_bench4();
+
+  printf("Benchmark test #6\n");
+  pthread_test_bench6();
+
+  printf("Benchmark test #7\n");
+  pthread_test_bench7();
+
+  printf("Benchmark test #8\n");
+  pthread_test_bench8();
+
+  printf("Benchmark test #9\n");
+  pthread_test_bench9();
 }
 
 static void runExceptionTests()
@@ -0,0 +1,308 @@
+/*
+ * File: trace1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
+ *      Copyright(C) 1998 John E. Bossom
+ *      Copyright(C) 1999,2005 Pthreads-win32 contributors
+ *
+ *      Contact Email: rpj@callisto.canberra.edu.au
+ *
+ *      The original list of contributors to the Pthreads-win32 project
+ *      is contained in the file CONTRIBUTORS.ptw32 included with the
+ *      source code distribution. The list can also be seen at the
+ *      following World Wide Web location:
+ *      http://sources.redhat.com/pthreads-win32/contributors.html
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test the scheduling tracepoints: custom hooks see block, wake,
+ * - -   handoff, create, exit and cancel events, and the recorder
+ * - -   writes them as Chrome trace JSON.
+ *
+ * Test Method (Validation or Falsification):
+ * -
+ *
+ * Requirements Tested:
+ * -
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * -
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+#include <string.h>
+
+#include "../implement.h"
+
+#define HOLD_MSECS 10
+
+static pthread_mutex_t mx;
+static int waiting;
+static int counts[PTE_TRACE_CANCEL + 1];
+static int blocksOnMx;
+static int wakesOnMx;
+static int badArg;
+
+static void countEvent(int event, const void * object, void * arg)
+{
+  if (arg != (void *) counts)
+    {
+      badArg = 1;
+    }
+  (void) pte_osAtomicIncrement(&counts[event]);
+}
+
+static void onBlock(const void * object, void * arg)
+{
+  countEvent(PTE_TRACE_BLOCK, object, arg);
+  if (object == mx)
+    {
+      (void) pte_osAtomicIncrement(&blocksOnMx);
+    }
+}
+
+static void onWake(const void * object, void * arg)
+{
+  countEvent(PTE_TRACE_WAKE, object, arg);
+  if (object == mx)
+    {
+      (void) pte_osAtomicIncrement(&wakesOnMx);
+    }
+}
+
+static void onHandoff(const void * object, void * arg)
+{
+  countEvent(PTE_TRACE_HANDOFF, object, arg);
+}
+
+static void onCreate(const void * object, void * arg)
+{
+  countEvent(PTE_TRACE_CREATE, object, arg);
+}
+
+static void onExit(const void * object, void * arg)
+{
+  countEvent(PTE_TRACE_EXIT, object, arg);
+}
+
+static void onCancel(const void * object, void * arg)
+{
+  countEvent(PTE_TRACE_CANCEL, object, arg);
+}
+
+static pte_trace_hooks_t hooks =
+  {
+    onBlock, onWake, onHandoff, onCreate, onExit, onCancel, counts
+  };
+
+static void * locker(void * arg)
+{
+  (void) pte_osAtomicExchange(&waiting, 1);
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  return NULL;
+}
+
+static void * spinner(void * arg)
+{
+  (void) pte_osAtomicExchange(&waiting, 1);
+  for (;;)
+    {
+      pthread_testcancel();
+      sched_yield();
+    }
+  return NULL;
+}
+
+static void * noop(void * arg)
+{
+  return NULL;
+}
+
+static void * creator(void * arg)
+{
+  pthread_t t;
+  int i;
+
+  for (i = 0; i < 10; i++)
+    {
+      assert(pthread_create(&t, NULL, noop, NULL) == 0);
+      assert(pthread_join(t, NULL) == 0);
+    }
+  return NULL;
+}
+
+static void contend(void)
+{
+  pthread_t t;
+
+  waiting = 0;
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_create(&t, NULL, locker, NULL) == 0);
+  while (pte_osAtomicCompareExchange(&waiting, 0, 0) == 0)
+    {
+      sched_yield();
+    }
+  pte_osThreadSleep(HOLD_MSECS);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  assert(pthread_join(t, NULL) == 0);
+}
+
+static int dumpCount(FILE * f, const char * text)
+{
+  char line[256];
+  int found = 0;
+
+  rewind(f);
+  while (fgets(line, sizeof(line), f) != NULL)
+    {
+      if (strstr(line, text) != NULL)
+        {
+          found++;
+        }
+    }
+  return found;
+}
+
+int pthread_test_trace1()
+{
+  pthread_t t;
+  void * result;
+  FILE * f;
+
+  assert(pthread_mutex_init(&mx, NULL) == 0);
+
+  /*
+   * Custom hooks
+   */
+  memset(counts, 0, sizeof(counts));
+  blocksOnMx = wakesOnMx = badArg = 0;
+  assert(pte_set_trace_hooks_np(&hooks) == 0);
+
+  contend();
+
+  assert(blocksOnMx >= 1);
+  assert(wakesOnMx == blocksOnMx);
+  assert(counts[PTE_TRACE_HANDOFF] >= 1);
+  assert(counts[PTE_TRACE_CREATE] == 1);
+  assert(counts[PTE_TRACE_EXIT] == 1);
+  assert(counts[PTE_TRACE_CANCEL] == 0);
+
+  waiting = 0;
+  assert(pthread_create(&t, NULL, spinner, NULL) == 0);
+  while (pte_osAtomicCompareExchange(&waiting, 0, 0) == 0)
+    {
+      sched_yield();
+    }
+  assert(pthread_cancel(t) == 0);
+  assert(pthread_join(t, &result) == 0);
+  assert(result == PTHREAD_CANCELED);
+
+  assert(counts[PTE_TRACE_CREATE] == 2);
+  assert(counts[PTE_TRACE_EXIT] == 2);
+  assert(counts[PTE_TRACE_CANCEL] == 1);
+  assert(badArg == 0);
+
+  /*
+   * No hooks, no events
+   */
+  assert(pte_set_trace_hooks_np(NULL) == 0);
+  assert(pthread_create(&t, NULL, noop, NULL) == 0);
+  assert(pthread_join(t, NULL) == 0);
+  assert(counts[PTE_TRACE_CREATE] == 2);
+
+  /*
+   * The recorder
+   */
+  assert(pte_trace_start_np(0) == EINVAL);
+  assert(pte_trace_start_np(64) == 0);
+  assert(pte_trace_hooks == &pte_trace_recorder);
+
+  contend();
+
+  assert(pte_trace_stop_np() == 0);
+  assert(pte_trace_hooks == NULL);
+  assert(pte_trace_dump_np(NULL) == EINVAL);
+
+  f = tmpfile();
+  assert(f != NULL);
+  assert(pte_trace_dump_np(f) == 0);
+  assert(dumpCount(f, "{\"traceEvents\":[") == 1);
+  assert(dumpCount(f, "\"thread_name\"") >= 2);
+  assert(dumpCount(f, "\"ph\":\"B\"") >= 1);
+  assert(dumpCount(f, "\"ph\":\"E\"") == dumpCount(f, "\"ph\":\"B\""));
+  assert(dumpCount(f, "\"name\":\"handoff\"") >= 1);
+  assert(dumpCount(f, "\"name\":\"create\"") == 1);
+  assert(dumpCount(f, "\"name\":\"exit\"") == 1);
+  fclose(f);
+
+  /*
+   * A full ring keeps the most recent events
+   */
+  assert(pte_trace_start_np(4) == 0);
+  assert(pthread_create(&t, NULL, creator, NULL) == 0);
+  assert(pthread_join(t, NULL) == 0);
+  assert(pte_trace_stop_np() == 0);
+
+  f = tmpfile();
+  assert(f != NULL);
+  assert(pte_trace_dump_np(f) == 0);
+  assert(dumpCount(f, "\"name\":\"create\"") <= 4);
+  assert(dumpCount(f, "\"name\":\"exit\"") >= 10);
+  fclose(f);
+
+  assert(pthread_mutex_destroy(&mx) == 0);
+
+  return 0;
+}